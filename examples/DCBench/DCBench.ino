@@ -0,0 +1,739 @@
+/***************************************************************************//**
+ * @file    DCBench.ino
+ * @brief   RTT-GUI library "DCBench" example
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#include <math.h>
+#include <rtt.h>
+#include <rttgui.h>
+
+/* Time each DC primitive through the hardware DC (unclipped) and through the
+   client DC with the window clip split into 1, 8, 64 and 256 rects. Enable
+   "RTGUI_USING_DC_STAT" in "guiconfig.h" to also get the clip rects visited.
+   With "CONFIG_USING_MEM_FB" the benchmark runs without a real panel. The
+   driver ops are also timed directly, full screen and without any DC. With
+   "RTGUI_USING_DC_AA" the "_aa" primitives repeat the aliased ones with
+   "RTGUI_DRAWSTYLE_AA" set in the gc. The "_blend" primitives draw half
+   transparent colors with "RTGUI_DRAWSTYLE_BLEND". The "grad_" primitives
+   fill gradients, "grad_dither" with "RTGUI_DRAWSTYLE_DITHER". The
+   "overdraw" column is the pixels written minus the pixels covered, it needs
+   a bitmap of the screen. With "RTGUI_USING_GLYPH_CACHE" the glyph cache
+   counters are shown at the end.
+   Before the benchmark, "rtgui_sin_q15()" and "rtgui_cos_q15()" are checked
+   against libm and, with "RTGUI_USING_DC_BUFFER", the edges of pies and
+   annuli against the exact shape. */
+
+#define BENCH_LOOP      (10)
+#define TRIG_ERR_MAX    (1)     /* LSB of Q15, the table is rounded */
+#define EDGE_ERR_MAX    (1.0)   /* pixel from the exact edge */
+#define EDGE_SIZE       (64)
+#define DEG2RAD(d)      ((d) * 3.14159265358979 / 180)
+
+typedef struct bench_prim {
+  const char *name;
+  void (*run)(rtgui_dc_t *dc, rtgui_rect_t *rect);
+} bench_prim_t;
+
+static const struct rtgui_graphic_driver_ops *drvOps;
+static const struct rtgui_graphic_driver_ops *drvNativeOps;
+static rt_uint32_t opCalls;
+static rt_uint32_t opPixels;
+static rt_uint32_t opCovered;
+static rt_uint8_t *covMap;      /* 1 bit per screen pixel */
+static rt_uint16_t covPitch;
+static rt_uint16_t covHeight;
+static rt_bool_t benchDone = RT_FALSE;
+
+/* driver ops wrapper, count calls, pixels written and pixels covered */
+static void count_area(int x1, int x2, int y1, int y2) {
+  rt_uint8_t *ptr;
+  int x, y;
+
+  if ((x2 <= x1) || (y2 <= y1)) return;
+  opPixels += (x2 - x1) * (y2 - y1);
+  if (!covMap) return;
+
+  x1 = _MAX(x1, 0);
+  y1 = _MAX(y1, 0);
+  x2 = _MIN(x2, covPitch << 3);
+  y2 = _MIN(y2, covHeight);
+  for (y = y1; y < y2; y++)
+    for (x = x1; x < x2; x++) {
+      ptr = covMap + y * covPitch + (x >> 3);
+      if (!(*ptr & (1 << (x & 0x07)))) {
+        *ptr |= 1 << (x & 0x07);
+        opCovered++;
+      }
+    }
+}
+
+static void count_op(int x1, int x2, int y1, int y2) {
+  opCalls++;
+  count_area(x1, x2, y1, y2);
+}
+
+static void count_spans(const rtgui_span_t *spans, rt_uint32_t num) {
+  rt_uint32_t i;
+
+  opCalls++;
+  for (i = 0; i < num; i++)
+    count_area(spans[i].x1, spans[i].x2, spans[i].y, spans[i].y + 1);
+}
+
+static void bench_set_pixel(rtgui_color_t *c, int x, int y) {
+  count_op(x, x + 1, y, y + 1);
+  drvOps->set_pixel(c, x, y);
+}
+
+static void bench_get_pixel(rtgui_color_t *c, int x, int y) {
+  count_op(0, 0, 0, 0);
+  drvOps->get_pixel(c, x, y);
+}
+
+static void bench_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+  count_op(x1, x2, y, y + 1);
+  drvOps->draw_hline(c, x1, x2, y);
+}
+
+static void bench_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+  count_op(x, x + 1, y1, y2);
+  drvOps->draw_vline(c, x, y1, y2);
+}
+
+static void bench_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+  count_op(x1, x2, y, y + 1);
+  drvOps->draw_raw_hline(pixels, x1, x2, y);
+}
+
+static void bench_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+  rt_uint32_t num) {
+  count_spans(spans, num);
+  drvOps->draw_hspans(c, spans, num);
+}
+
+static void bench_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+  count_op(x1, x2, y1, y2);
+  drvOps->fill_rect(c, x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops benchOps = {
+  bench_set_pixel,
+  bench_get_pixel,
+  bench_draw_hline,
+  bench_draw_vline,
+  bench_draw_raw_hline,
+  bench_draw_hspans,
+  bench_fill_rect,
+};
+
+/* native ops wrapper */
+static void bench_native_set_pixel(rtgui_color_t *c, int x, int y) {
+  count_op(x, x + 1, y, y + 1);
+  drvNativeOps->set_pixel(c, x, y);
+}
+
+static void bench_native_get_pixel(rtgui_color_t *c, int x, int y) {
+  count_op(0, 0, 0, 0);
+  drvNativeOps->get_pixel(c, x, y);
+}
+
+static void bench_native_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+  count_op(x1, x2, y, y + 1);
+  drvNativeOps->draw_hline(c, x1, x2, y);
+}
+
+static void bench_native_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+  count_op(x, x + 1, y1, y2);
+  drvNativeOps->draw_vline(c, x, y1, y2);
+}
+
+static void bench_native_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2,
+  int y) {
+  count_op(x1, x2, y, y + 1);
+  drvNativeOps->draw_raw_hline(pixels, x1, x2, y);
+}
+
+static void bench_native_draw_hspans(rtgui_color_t *c,
+  const rtgui_span_t *spans, rt_uint32_t num) {
+  count_spans(spans, num);
+  drvNativeOps->draw_hspans(c, spans, num);
+}
+
+static void bench_native_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+  int y2) {
+  count_op(x1, x2, y1, y2);
+  drvNativeOps->fill_rect(c, x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops benchNativeOps = {
+  bench_native_set_pixel,
+  bench_native_get_pixel,
+  bench_native_draw_hline,
+  bench_native_draw_vline,
+  bench_native_draw_raw_hline,
+  bench_native_draw_hspans,
+  bench_native_fill_rect,
+};
+
+/* primitives */
+static void run_hline(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int y;
+
+  for (y = rect->y1; y < rect->y2; y += 2)
+    rtgui_dc_draw_hline(dc, rect->x1, rect->x2, y);
+}
+
+static void run_vline(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int x;
+
+  for (x = rect->x1; x < rect->x2; x += 2)
+    rtgui_dc_draw_vline(dc, x, rect->y1, rect->y2);
+}
+
+static void run_line(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int w = RECT_W(*rect), h = RECT_H(*rect), i;
+
+  for (i = 0; i < 16; i++) {
+    rtgui_dc_draw_line(dc, 0, i * h / 16, w - 1, h - 1 - i * h / 16);
+    rtgui_dc_draw_line(dc, i * w / 16, 0, w - 1 - i * w / 16, h - 1);
+  }
+}
+
+static void run_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_rect(dc, rect);
+}
+
+static void run_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_round_rect(dc, rect, 16);
+}
+
+static void run_circle(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_circle(dc, RECT_W(*rect) / 2, RECT_H(*rect) / 2,
+    _MIN(RECT_W(*rect), RECT_H(*rect)) / 2 - 1);
+}
+
+static void run_ellipse(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_ellipse(dc, RECT_W(*rect) / 2, RECT_H(*rect) / 2,
+    RECT_W(*rect) / 2 - 1, RECT_H(*rect) / 2 - 1);
+}
+
+static void run_polygon(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int w = RECT_W(*rect), h = RECT_H(*rect);
+  int vx[5] = { w / 2, w - 1, w * 4 / 5, w / 5, 0 };
+  int vy[5] = { 0, h * 2 / 5, h - 1, h - 1, h * 2 / 5 };
+
+  rtgui_dc_fill_polygon(dc, vx, vy, 5);
+}
+
+static void run_arc(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int r = _MIN(RECT_W(*rect), RECT_H(*rect)) / 2 - 1;
+
+  rtgui_dc_draw_arc(dc, RECT_W(*rect) / 2, RECT_H(*rect) / 2, r, 30, 300);
+}
+
+static void run_pie(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int r = _MIN(RECT_W(*rect), RECT_H(*rect)) / 2 - 1;
+
+  rtgui_dc_fill_pie(dc, RECT_W(*rect) / 2, RECT_H(*rect) / 2, r, 30, 300);
+}
+
+static void run_annulus(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  int r = _MIN(RECT_W(*rect), RECT_H(*rect)) / 2 - 1;
+
+  rtgui_dc_fill_annulus(dc, RECT_W(*rect) / 2, RECT_H(*rect) / 2, r * 3 / 4, r,
+    135, 405);
+}
+
+#ifdef RTGUI_USING_DC_AA
+static void run_aa(rtgui_dc_t *dc, rtgui_rect_t *rect,
+  void (*run)(rtgui_dc_t *dc, rtgui_rect_t *rect)) {
+  rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+
+  gc->drawstyle |= RTGUI_DRAWSTYLE_AA;
+  run(dc, rect);
+  gc->drawstyle &= ~RTGUI_DRAWSTYLE_AA;
+}
+
+static void run_line_aa(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_aa(dc, rect, run_line);
+}
+
+static void run_circle_aa(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_aa(dc, rect, run_circle);
+}
+
+static void run_polygon_aa(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_aa(dc, rect, run_polygon);
+}
+
+static void run_arc_aa(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_aa(dc, rect, run_arc);
+}
+#endif
+
+static void run_text(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_rect_t line = *rect;
+  int i;
+
+  for (i = 0; i < 8; i++) {
+    rtgui_dc_draw_text(dc, "RTT-GUI 0123456789 abcdefg", &line);
+    line.y1 += 16;
+  }
+}
+
+static void run_grad_v(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_gradient_rectv(dc, rect, RTGUI_RGB(0x20, 0x40, 0x80),
+    RTGUI_RGB(0xc0, 0xd0, 0xf0));
+}
+
+static void run_grad_h(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_gradient_recth(dc, rect, RTGUI_RGB(0x20, 0x40, 0x80),
+    RTGUI_RGB(0xc0, 0xd0, 0xf0));
+}
+
+static void run_grad_radial(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_dc_fill_gradient_radial(dc, rect, (rect->x1 + rect->x2) / 2,
+    (rect->y1 + rect->y2) / 2, (rect->y2 - rect->y1) / 2,
+    RTGUI_RGB(0xff, 0xff, 0xff), RTGUI_RGB(0x20, 0x40, 0x80));
+}
+
+static void run_grad_dither(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+
+  gc->drawstyle |= RTGUI_DRAWSTYLE_DITHER;
+  run_grad_v(dc, rect);
+  gc->drawstyle &= ~RTGUI_DRAWSTYLE_DITHER;
+}
+
+static void run_blend(rtgui_dc_t *dc, rtgui_rect_t *rect,
+  void (*run)(rtgui_dc_t *dc, rtgui_rect_t *rect)) {
+  rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+  rtgui_color_t fc = gc->foreground, bc = gc->background;
+
+  gc->drawstyle |= RTGUI_DRAWSTYLE_BLEND;
+  gc->foreground = (fc & 0x00ffffff) | 0x80000000;
+  gc->background = (bc & 0x00ffffff) | 0x80000000;
+  run(dc, rect);
+  gc->foreground = fc;
+  gc->background = bc;
+  gc->drawstyle &= ~RTGUI_DRAWSTYLE_BLEND;
+}
+
+static void run_fill_rect_blend(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_blend(dc, rect, run_fill_rect);
+}
+
+static void run_circle_blend(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_blend(dc, rect, run_circle);
+}
+
+static void run_text_blend(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  run_blend(dc, rect, run_text);
+}
+
+#ifdef RTGUI_USING_DC_BUFFER
+/* same content as "text", composed once and blitted */
+static void run_blit(rtgui_dc_t *dc, rtgui_rect_t *rect) {
+  static rtgui_dc_t *buf = RT_NULL;
+  rtgui_rect_t bufRect;
+
+  if (!buf) {
+    buf = rtgui_dc_buffer_create(rect->x2 - rect->x1, rect->y2 - rect->y1);
+    if (!buf) return;
+    rtgui_dc_get_rect(buf, &bufRect);
+    rtgui_dc_fill_rect(buf, &bufRect);
+    run_text(buf, &bufRect);
+  }
+  rtgui_dc_blit(buf, RT_NULL, dc, rect);
+}
+#endif
+
+static const bench_prim_t benchPrims[] = {
+  { "hline",      run_hline },
+  { "vline",      run_vline },
+  { "line",       run_line },
+  { "fill_rect",  run_fill_rect },
+  { "round_rect", run_round_rect },
+  { "circle",     run_circle },
+  { "ellipse",    run_ellipse },
+  { "polygon",    run_polygon },
+  { "arc",        run_arc },
+  { "pie",        run_pie },
+  { "annulus",    run_annulus },
+  { "text",       run_text },
+  { "grad_v",     run_grad_v },
+  { "grad_h",     run_grad_h },
+  { "grad_radial", run_grad_radial },
+  { "grad_dither", run_grad_dither },
+  { "fill_blend", run_fill_rect_blend },
+  { "circle_blend", run_circle_blend },
+  { "text_blend", run_text_blend },
+  #ifdef RTGUI_USING_DC_AA
+    { "line_aa",    run_line_aa },
+    { "circle_aa",  run_circle_aa },
+    { "polygon_aa", run_polygon_aa },
+    { "arc_aa",     run_arc_aa },
+  #endif
+  #ifdef RTGUI_USING_DC_BUFFER
+    { "blit",       run_blit },
+  #endif
+};
+
+/* compare with libm for every degree of two turns each way */
+static rt_bool_t check_trig(void) {
+  int a, err, errMax = 0, errAngle = 0;
+
+  for (a = -720; a <= 720; a++) {
+    err = rtgui_sin_q15(a) - (int)lround(sin(DEG2RAD(a)) * 32768);
+    if (abs(err) > errMax) {
+      errMax = abs(err);
+      errAngle = a;
+    }
+    err = rtgui_cos_q15(a) - (int)lround(cos(DEG2RAD(a)) * 32768);
+    if (abs(err) > errMax) {
+      errMax = abs(err);
+      errAngle = a;
+    }
+  }
+  rt_kprintf("%-24s max error %d LSB at %d (bound %d) %s\n", "sin/cos", errMax,
+    errAngle, TRIG_ERR_MAX, (errMax <= TRIG_ERR_MAX) ? "PASS" : "FAIL");
+  return errMax <= TRIG_ERR_MAX;
+}
+
+#ifdef RTGUI_USING_DC_BUFFER
+/* distance from (dx, dy) to the ray from the center in direction "a" */
+static double ray_dist(double dx, double dy, int a) {
+  double along = dx * cos(DEG2RAD(a)) + dy * sin(DEG2RAD(a));
+
+  if (along <= 0) return sqrt(dx * dx + dy * dy);
+  return fabs(dy * cos(DEG2RAD(a)) - dx * sin(DEG2RAD(a)));
+}
+
+/* fill the shape in a buffer dc, pixels further than EDGE_ERR_MAX from the
+   exact edge must be drawn if inside and not drawn if outside. The exact
+   shape is (r1 - 0.5) < distance < (r2 + 0.5), "start" to "end" clockwise */
+static rt_bool_t check_edge(int r1, int r2, int start, int end) {
+  rtgui_dc_t *dc;
+  struct rtgui_dc_buffer *buf;
+  rt_uint8_t *pixel;
+  rt_uint32_t wrong = 0;
+  int c = EDGE_SIZE / 2, x, y, i, bytes;
+  double dx, dy, d, margin, rel;
+  rt_bool_t in, drawn;
+  char name[32];
+
+  dc = rtgui_dc_buffer_create(EDGE_SIZE, EDGE_SIZE);
+  if (!dc) {
+    rt_kprintf("no memory\n");
+    return RT_FALSE;
+  }
+  buf = (struct rtgui_dc_buffer *)dc;
+  bytes = _BIT2BYTE(buf->bits_per_pixel);
+  RTGUI_DC_FC(dc) = white;
+  if (r1)
+    rtgui_dc_fill_annulus(dc, c, c, r1, r2, start, end);
+  else
+    rtgui_dc_fill_pie(dc, c, c, r2, start, end);
+
+  for (y = 0; y < EDGE_SIZE; y++) {
+    for (x = 0; x < EDGE_SIZE; x++) {
+      dx = x - c;
+      dy = y - c;
+      d = sqrt(dx * dx + dy * dy);
+      rel = fmod(atan2(dy, dx) * 180 / 3.14159265358979 - start + 720, 360);
+      in = (rel < end - start) && (d > r1 - 0.5) && (d < r2 + 0.5);
+
+      margin = fabs(d - (r2 + 0.5));
+      if (r1) margin = fmin(margin, fabs(d - (r1 - 0.5)));
+      margin = fmin(margin, ray_dist(dx, dy, start));
+      margin = fmin(margin, ray_dist(dx, dy, end));
+      if (margin <= EDGE_ERR_MAX) continue;
+
+      pixel = buf->pixel + y * buf->pitch + x * bytes;
+      drawn = RT_FALSE;
+      for (i = 0; i < bytes; i++)
+        if (pixel[i]) drawn = RT_TRUE;
+      if (drawn != in) wrong++;
+    }
+  }
+  rtgui_dc_destory(dc);
+
+  rt_snprintf(name, sizeof(name), "%s %d-%d %d..%d", r1 ? "annulus" : "pie",
+    r1, r2, start, end);
+  rt_kprintf("%-24s %d wrong pixels (bound %d px) %s\n", name, wrong,
+    (int)EDGE_ERR_MAX, wrong ? "FAIL" : "PASS");
+  return !wrong;
+}
+#endif
+
+static void check_all(void) {
+  #ifdef RTGUI_USING_DC_BUFFER
+    /* r1, r2, start, end; start < end < start + 360 */
+    static const rt_int16_t shapes[][4] = {
+      {  0, 30,   30, 300 },
+      {  0, 30,    0,  90 },
+      {  0, 30,  -45,  45 },
+      {  0, 30,  100, 101 },
+      {  0, 30,  170, 350 },
+      { 20, 30,   30, 300 },
+      { 10, 30,  200, 559 },
+      { 10, 30, -100,  80 },
+    };
+    rt_uint32_t i;
+  #endif
+
+  rt_kprintf("\n[check]\n");
+  (void)check_trig();
+  #ifdef RTGUI_USING_DC_BUFFER
+    for (i = 0; i < sizeof(shapes) / sizeof(shapes[0]); i++)
+      (void)check_edge(shapes[i][0], shapes[i][1], shapes[i][2], shapes[i][3]);
+  #endif
+}
+
+/* time the driver ops directly */
+static void bench_driver(void) {
+  rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+  const struct rtgui_graphic_driver_ops *ops = drv->ops;
+  rtgui_color_t color = blue;
+  rt_uint8_t *pixels;
+  rt_uint32_t n, us, pixelNum;
+  int x, y, w = drv->width, h = drv->height;
+
+  rt_kprintf("\n[driver ops, format %d, %d bpp, %dx%d]\n", drv->pixel_format,
+    drv->bits_per_pixel, w, h);
+  rt_kprintf("%-12s %10s %10s\n", "op", "us", "ns/pixel");
+  pixelNum = w * h;
+
+  us = micros();
+  for (n = 0; n < BENCH_LOOP; n++)
+    for (y = 0; y < h; y++)
+      ops->draw_hline(&color, 0, w, y);
+  us = (micros() - us) / BENCH_LOOP;
+  rt_kprintf("%-12s %10d %10d\n", "hline", us, us * 1000 / pixelNum);
+
+  us = micros();
+  for (n = 0; n < BENCH_LOOP; n++)
+    for (x = 0; x < w; x++)
+      ops->draw_vline(&color, x, 0, h);
+  us = (micros() - us) / BENCH_LOOP;
+  rt_kprintf("%-12s %10d %10d\n", "vline", us, us * 1000 / pixelNum);
+
+  us = micros();
+  for (n = 0; n < BENCH_LOOP; n++)
+    ops->fill_rect(&color, 0, 0, w, h);
+  us = (micros() - us) / BENCH_LOOP;
+  rt_kprintf("%-12s %10d %10d\n", "fill_rect", us, us * 1000 / pixelNum);
+
+  pixels = (rt_uint8_t *)rtgui_malloc(_BIT2BYTE(drv->bits_per_pixel) * w);
+  if (!pixels) {
+    rt_kprintf("no memory\n");
+    return;
+  }
+  rt_memset(pixels, 0x5a, _BIT2BYTE(drv->bits_per_pixel) * w);
+  us = micros();
+  for (n = 0; n < BENCH_LOOP; n++)
+    for (y = 0; y < h; y++)
+      ops->draw_raw_hline(pixels, 0, w, y);
+  us = (micros() - us) / BENCH_LOOP;
+  rt_kprintf("%-12s %10d %10d\n", "raw_hline", us, us * 1000 / pixelNum);
+  rtgui_free(pixels);
+}
+
+/* split the window extent into a grid of "num" separated rects */
+static void set_clip(rtgui_widget_t *wgt, rt_uint32_t num) {
+  rtgui_region_t clip;
+  rtgui_rect_t cell;
+  int cols, rows, w, h, i, j;
+
+  if (!num) {
+    rtgui_region_reset(&wgt->clip, &wgt->extent);
+    return;
+  }
+
+  for (cols = 1; (rt_uint32_t)(cols * cols) < num; cols <<= 1);
+  rows = num / cols;
+  w = RECT_W(wgt->extent) / cols;
+  h = RECT_H(wgt->extent) / rows;
+
+  rtgui_region_init_empty(&clip);
+  for (j = 0; j < rows; j++) {
+    for (i = 0; i < cols; i++) {
+      /* leave 1 pixel gap to keep the rects separated */
+      rtgui_rect_init(&cell, wgt->extent.x1 + i * w, wgt->extent.y1 + j * h,
+        w - 1, h - 1);
+      rtgui_region_union_rect(&clip, &clip, &cell);
+    }
+  }
+  rtgui_region_copy(&wgt->clip, &clip);
+  rtgui_region_uninit(&clip);
+}
+
+static void bench_run(rtgui_widget_t *wgt, rt_uint32_t num) {
+  rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+  rtgui_rect_t rect;
+  rtgui_dc_t *dc;
+  rt_uint32_t i, n, us;
+  #ifdef RTGUI_USING_DC_STAT
+    rtgui_dc_stat_t stat;
+  #endif
+
+  set_clip(wgt, num);
+  dc = rtgui_dc_begin_drawing(wgt);
+  if (!dc) {
+    rt_kprintf("no dc\n");
+    return;
+  }
+  rtgui_dc_get_rect(dc, &rect);
+
+  rt_kprintf("\n[%s dc, %d clip rects]\n",
+    (dc->type == RTGUI_DC_HW) ? "hw" : "client",
+    rtgui_region_num_rects(&wgt->clip));
+  rt_kprintf("%-12s %10s %10s %10s %10s %10s\n", "primitive", "us",
+    "ns/pixel", "drv calls", "clip rects", "overdraw");
+
+  for (i = 0; i < sizeof(benchPrims) / sizeof(benchPrims[0]); i++) {
+    /* count pass */
+    opCalls = opPixels = opCovered = 0;
+    if (covMap) rt_memset(covMap, 0x00, covPitch * covHeight);
+    #ifdef RTGUI_USING_DC_STAT
+      rtgui_dc_client_get_stat(RT_NULL, RT_TRUE);
+    #endif
+    drvOps = drv->ops;
+    drvNativeOps = drv->native_ops;
+    drv->ops = &benchOps;
+    drv->native_ops = &benchNativeOps;
+    benchPrims[i].run(dc, &rect);
+    drv->ops = drvOps;
+    drv->native_ops = drvNativeOps;
+    #ifdef RTGUI_USING_DC_STAT
+      rtgui_dc_client_get_stat(&stat, RT_FALSE);
+    #endif
+
+    /* timed pass */
+    us = micros();
+    for (n = 0; n < BENCH_LOOP; n++)
+      benchPrims[i].run(dc, &rect);
+    us = (micros() - us) / BENCH_LOOP;
+
+    rt_kprintf("%-12s %10d %10d %10d %10d %10d\n", benchPrims[i].name, us,
+      opPixels ? (us * 1000 / opPixels) : 0, opCalls,
+      #ifdef RTGUI_USING_DC_STAT
+        stat.clip_rects,
+      #else
+        0,
+      #endif
+      covMap ? (opPixels - opCovered) : 0);
+  }
+
+  rtgui_dc_end_drawing(dc, RT_FALSE);
+}
+
+static void bench_all(rtgui_win_t *win) {
+  static const rt_uint32_t clips[] = { 0, 1, 8, 64, 256 };
+  rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
+  rtgui_widget_t *wgt = TO_WIDGET(win);
+  rtgui_region_t saved;
+  rt_uint32_t i;
+
+  check_all();
+  bench_driver();
+
+  covPitch = (drv->width + 7) >> 3;
+  covHeight = drv->height;
+  covMap = (rt_uint8_t *)rtgui_malloc(covPitch * covHeight);
+  if (!covMap) rt_kprintf("no memory for overdraw\n");
+
+  rtgui_region_init_empty(&saved);
+  rtgui_region_copy(&saved, &wgt->clip);
+
+  for (i = 0; i < sizeof(clips) / sizeof(clips[0]); i++)
+    bench_run(wgt, clips[i]);
+
+  rtgui_region_copy(&wgt->clip, &saved);
+  rtgui_region_uninit(&saved);
+  if (covMap) {
+    rtgui_free(covMap);
+    covMap = RT_NULL;
+  }
+
+  #ifdef RTGUI_USING_GLYPH_CACHE
+  {
+    rtgui_glyph_cache_stat_t cache;
+
+    rtgui_font_cache_get_stat(&cache, RT_FALSE);
+    rt_kprintf("\n[glyph cache]\nhit %d, miss %d, evict %d, %d glyphs in %d "
+      "bytes\n", cache.hit_count, cache.miss_count, cache.evict_count,
+      cache.glyphs, cache.bytes);
+  }
+  #endif
+  rt_kprintf("\nDone\n");
+}
+
+rt_bool_t win_event_handler(void *obj, rtgui_evt_generic_t *evt) {
+  rt_bool_t done = RT_FALSE;
+
+  if (DEFAULT_HANDLER(obj)) {
+    done = DEFAULT_HANDLER(obj)(obj, evt);
+  }
+
+  if (IS_EVENT_TYPE(evt, PAINT) && !benchDone) {
+    benchDone = RT_TRUE;
+    bench_all(TO_WIN(obj));
+    done = RT_TRUE;
+  }
+
+  return done;
+}
+
+static void rt_gui_bench_entry(void *param) {
+  rtgui_app_t *app;
+  rtgui_win_t *main_win;
+  (void)param;
+
+  /* create gui app */
+  CREATE_APP_INSTANCE(app, RT_NULL, "DCBench App");
+  if (!app) {
+    rt_kprintf("create app failed\n");
+    return;
+  }
+
+  main_win = CREATE_MAIN_WIN(win_event_handler, "DCBench",
+    RTGUI_WIN_STYLE_DEFAULT);
+  if (!main_win) {
+    rtgui_app_uninit(app);
+    rt_kprintf("create mainwin failed\n");
+    return;
+  }
+
+  rtgui_win_show(main_win, RT_FALSE);
+  rtgui_app_run(app);
+
+  DELETE_WIN_INSTANCE(main_win);
+  rtgui_app_uninit(app);
+}
+
+
+// RT-Thread function called by "RT_T.begin()"
+void rt_setup(void) {
+  rt_thread_t tid;
+
+  tid = rt_thread_create(
+    "bench_dc", rt_gui_bench_entry, RT_NULL,
+    CONFIG_APP_STACK_SIZE, CONFIG_APP_PRIORITY, CONFIG_APP_TIMESLICE);
+
+  if (tid) {
+    rt_thread_startup(tid);
+  } else {
+    rt_kprintf("create thread failed\n");
+  }
+}
+
+void setup() {
+  RT_T.begin();
+  // no code here as RT_T.begin() never return
+}
+
+// this function will be called by "Arduino" thread
+void loop() {
+  // may put some code here that will be run repeatedly
+}
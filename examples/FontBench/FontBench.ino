@@ -0,0 +1,290 @@
+/***************************************************************************//**
+ * @file    FontBench.ino
+ * @brief   RTT-GUI library "FontBench" example
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#include <rtt.h>
+#include <rttgui.h>
+
+/* Draw GB2312 text row by row with the "hz" fonts and measure glyphs/sec.
+   The first pass includes opening the font files, the "file" passes flush
+   the glyph cache first so every glyph is fetched from the font storage.
+   With "CONFIG_USING_FONT_FILE" the storage is picked at the first open:
+   used in place if its address is set by "CONFIG_FONT_*_MAP", loaded into
+   RAM if not bigger than "CONFIG_FONT_LOAD_MAX", else paged by
+   "CONFIG_FONT_PAGE_SIZE" and "CONFIG_FONT_PAGE_NUM" (set
+   "CONFIG_FONT_PAGE_NUM" to 1 and "CONFIG_FONT_READ_AHEAD" to 1 to compare
+   with reading each glyph).
+   The "text" passes draw mixed Chinese and ASCII strings: "convert" is the
+   unicode to GB2312 lookup only, "draw" is "rtgui_font_draw()" and "layout"
+   draws the same strings through prebuilt text layouts. */
+
+#define BENCH_LOOP      (3)
+#define GB_ROW_START    (0xB0)
+#define GB_ROW_END      (0xF7)
+#define GB_COL_START    (0xA1)
+#define GB_COL_END      (0xFE)
+#define GB_COL_NUM      (GB_COL_END - GB_COL_START + 1)
+#define TEXT_LOOP       (20)
+
+static const char *benchText[] = {
+  "文件管理 File Manager",
+  "设置 Settings: 亮度 80%",
+  "温度 25.6°C 湿度 60%",
+  "下载完成，共 12 个文件",
+  "RT-Thread 图形界面 GUI",
+  "电池电量低，请充电！",
+  "Volume 音量 ±5",
+  "确定 OK / 取消 Cancel",
+};
+
+#define TEXT_NUM        (sizeof(benchText) / sizeof(benchText[0]))
+
+static rt_bool_t benchDone = RT_FALSE;
+
+/* draw all the level 1 and 2 hanzi, return the number of glyphs */
+static rt_uint32_t bench_draw(rtgui_dc_t *dc, rtgui_font_t *font,
+  rtgui_rect_t *rect) {
+  rtgui_rect_t cell;
+  rt_uint32_t row, col;
+
+  if (font->engine->font_open && (RT_EOK != font->engine->font_open(font)))
+    return 0;
+
+  cell = *rect;
+  for (row = GB_ROW_START; row <= GB_ROW_END; row++) {
+    for (col = GB_COL_START; col <= GB_COL_END; col++) {
+      /* wrap at the right and the bottom */
+      if (cell.x1 + font->width > rect->x2) {
+        cell.x1 = rect->x1;
+        cell.y1 += font->height;
+        if (cell.y1 + font->height > rect->y2) cell.y1 = rect->y1;
+      }
+      cell.x1 += rtgui_font_draw_char(font, dc, (row << 8) | col, &cell);
+    }
+  }
+
+  if (font->engine->font_close) font->engine->font_close(font);
+  return (GB_ROW_END - GB_ROW_START + 1) * GB_COL_NUM;
+}
+
+static void bench_pass(rtgui_dc_t *dc, rtgui_font_t *font, rtgui_rect_t *rect,
+  const char *name, rt_bool_t flush) {
+  rt_uint32_t n, glyphs, us;
+  #if (CONFIG_USING_FONT_FILE)
+    rtgui_font_file_stat_t stat;
+  #endif
+
+  #if (CONFIG_USING_FONT_FILE)
+    rtgui_font_file_get_stat(RT_NULL, RT_TRUE);
+  #endif
+  glyphs = 0;
+  us = micros();
+  for (n = 0; n < BENCH_LOOP; n++) {
+    #ifdef RTGUI_USING_GLYPH_CACHE
+      if (flush) rtgui_font_cache_flush(RT_NULL);
+    #else
+      (void)flush;
+    #endif
+    glyphs += bench_draw(dc, font, rect);
+    /* the first pass is run once only */
+    if (!name) break;
+  }
+  us = micros() - us;
+  if (!glyphs) {
+    rt_kprintf("open font failed\n");
+    return;
+  }
+
+  #if (CONFIG_USING_FONT_FILE)
+    rtgui_font_file_get_stat(&stat, RT_FALSE);
+  #endif
+  rt_kprintf("%-8s %10d %10d %10d %10d %10d\n", name ? name : "first",
+    us / glyphs,
+    us ? (rt_uint32_t)((rt_uint64_t)glyphs * 1000000 / us) : 0,
+    #if (CONFIG_USING_FONT_FILE)
+      stat.read_count, stat.read_bytes,
+      (stat.page_hit + stat.page_miss) ? \
+        (stat.page_hit * 100 / (stat.page_hit + stat.page_miss)) : 0
+    #else
+      0, 0, 0
+    #endif
+    );
+}
+
+static void bench_font(rtgui_widget_t *wgt, rt_uint16_t height) {
+  rtgui_font_t *font;
+  rtgui_rect_t rect;
+  rtgui_dc_t *dc;
+
+  font = rtgui_font_refer("hz", height);
+  if (!font) {
+    rt_kprintf("\nno hz%d font\n", height);
+    return;
+  }
+  dc = rtgui_dc_begin_drawing(wgt);
+  if (!dc) {
+    rtgui_font_derefer(font);
+    rt_kprintf("no dc\n");
+    return;
+  }
+  rtgui_dc_get_rect(dc, &rect);
+
+  rt_kprintf("\n[hz%d]\n", height);
+  rt_kprintf("%-8s %10s %10s %10s %10s %10s\n", "pass", "us/glyph",
+    "glyphs/s", "reads", "read bytes", "page hit%");
+  bench_pass(dc, font, &rect, RT_NULL, RT_TRUE);
+  bench_pass(dc, font, &rect, "file", RT_TRUE);
+  bench_pass(dc, font, &rect, "cached", RT_FALSE);
+
+  rtgui_dc_end_drawing(dc, RT_FALSE);
+  rtgui_font_derefer(font);
+}
+
+static void bench_text_print(const char *name, rt_uint32_t us,
+  rt_uint32_t glyphs) {
+  rt_kprintf("%-8s %10d %10d\n", name, us / (TEXT_LOOP * TEXT_NUM),
+    us ? (rt_uint32_t)((rt_uint64_t)glyphs * TEXT_LOOP * 1000000 / us) : 0);
+}
+
+static void bench_text(rtgui_widget_t *wgt, rt_uint16_t height) {
+  rtgui_text_layout_t layout[TEXT_NUM];
+  rtgui_font_t *font;
+  rtgui_rect_t rect;
+  rtgui_dc_t *dc;
+  rt_uint8_t *utf8;
+  rt_uint32_t i, n, glyphs, us;
+  volatile rt_uint16_t code = 0;        /* keep the lookup */
+
+  font = rtgui_font_refer("hz", height);
+  if (!font) {
+    rt_kprintf("\nno hz%d font\n", height);
+    return;
+  }
+  dc = rtgui_dc_begin_drawing(wgt);
+  if (!dc) {
+    rtgui_font_derefer(font);
+    rt_kprintf("no dc\n");
+    return;
+  }
+  rtgui_dc_get_rect(dc, &rect);
+  rt_memset(layout, 0x00, sizeof(layout));
+
+  glyphs = 0;
+  for (i = 0; i < TEXT_NUM; i++) {
+    for (utf8 = (rt_uint8_t *)benchText[i]; *utf8; utf8 += UTF8_SIZE(*utf8))
+      glyphs++;
+    (void)rtgui_text_layout_build(&layout[i], font, benchText[i]);
+  }
+
+  rt_kprintf("\n[text hz%d, %d strings, %d glyphs]\n", height, TEXT_NUM,
+    glyphs);
+  rt_kprintf("%-8s %10s %10s\n", "pass", "us/string", "glyphs/s");
+
+  #if (CONFIG_USING_FONT_HZ)
+    us = micros();
+    for (n = 0; n < TEXT_LOOP; n++)
+      for (i = 0; i < TEXT_NUM; i++)
+        for (utf8 = (rt_uint8_t *)benchText[i]; *utf8;
+          utf8 += UTF8_SIZE(*utf8))
+          code += UnicodeToGB2312(UTF8_TO_UNICODE(utf8, UTF8_SIZE(*utf8)));
+    bench_text_print("convert", micros() - us, glyphs);
+  #endif
+
+  us = micros();
+  for (n = 0; n < TEXT_LOOP; n++)
+    for (i = 0; i < TEXT_NUM; i++)
+      rtgui_font_draw(font, dc, benchText[i], rt_strlen(benchText[i]), &rect);
+  bench_text_print("draw", micros() - us, glyphs);
+
+  us = micros();
+  for (n = 0; n < TEXT_LOOP; n++)
+    for (i = 0; i < TEXT_NUM; i++)
+      rtgui_text_layout_draw(&layout[i], dc, &rect);
+  bench_text_print("layout", micros() - us, glyphs);
+
+  for (i = 0; i < TEXT_NUM; i++)
+    rtgui_text_layout_free(&layout[i]);
+  rtgui_dc_end_drawing(dc, RT_FALSE);
+  rtgui_font_derefer(font);
+  (void)code;
+}
+
+static void bench_all(rtgui_win_t *win) {
+  rtgui_widget_t *wgt = TO_WIDGET(win);
+
+  bench_font(wgt, 16);
+  bench_font(wgt, 12);
+  bench_text(wgt, 16);
+  bench_text(wgt, 12);
+  rt_kprintf("\nDone\n");
+}
+
+rt_bool_t win_event_handler(void *obj, rtgui_evt_generic_t *evt) {
+  rt_bool_t done = RT_FALSE;
+
+  if (DEFAULT_HANDLER(obj)) {
+    done = DEFAULT_HANDLER(obj)(obj, evt);
+  }
+
+  if (IS_EVENT_TYPE(evt, PAINT) && !benchDone) {
+    benchDone = RT_TRUE;
+    bench_all(TO_WIN(obj));
+    done = RT_TRUE;
+  }
+
+  return done;
+}
+
+static void rt_gui_bench_entry(void *param) {
+  rtgui_app_t *app;
+  rtgui_win_t *main_win;
+  (void)param;
+
+  /* create gui app */
+  CREATE_APP_INSTANCE(app, RT_NULL, "FontBench App");
+  if (!app) {
+    rt_kprintf("create app failed\n");
+    return;
+  }
+
+  main_win = CREATE_MAIN_WIN(win_event_handler, "FontBench",
+    RTGUI_WIN_STYLE_DEFAULT);
+  if (!main_win) {
+    rtgui_app_uninit(app);
+    rt_kprintf("create mainwin failed\n");
+    return;
+  }
+
+  rtgui_win_show(main_win, RT_FALSE);
+  rtgui_app_run(app);
+
+  DELETE_WIN_INSTANCE(main_win);
+  rtgui_app_uninit(app);
+}
+
+
+// RT-Thread function called by "RT_T.begin()"
+void rt_setup(void) {
+  rt_thread_t tid;
+
+  tid = rt_thread_create(
+    "bench_font", rt_gui_bench_entry, RT_NULL,
+    CONFIG_APP_STACK_SIZE, CONFIG_APP_PRIORITY, CONFIG_APP_TIMESLICE);
+
+  if (tid) {
+    rt_thread_startup(tid);
+  } else {
+    rt_kprintf("create thread failed\n");
+  }
+}
+
+void setup() {
+  RT_T.begin();
+  // no code here as RT_T.begin() never return
+}
+
+// this function will be called by "Arduino" thread
+void loop() {
+  // may put some code here that will be run repeatedly
+}
@@ -0,0 +1,406 @@
+/***************************************************************************//**
+ * @file    RegionBench.ino
+ * @brief   RTT-GUI library "RegionBench" example
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#include <rtt.h>
+#include <rttgui.h>
+
+/* Check region operations against a brute-force bitmap and measure ops/sec.
+   Enable "RTGUI_MEM_TRACE" in "guiconfig.h" to also get allocations per op.
+   No display is used. */
+
+#define AREA_W          (64)
+#define AREA_H          (64)
+#define MAX_RECTS       (16)
+#define FUZZ_ROUND      (500)
+#define BENCH_ROUND     (100)
+#define BENCH_REPEAT    (100)
+
+typedef rt_uint8_t bitmap_t[AREA_H][AREA_W / 8];
+
+typedef enum {
+  OP_UNION = 0,
+  OP_INTERSECT,
+  OP_SUBTRACT,
+  OP_UNION_RECT,
+  OP_INTERSECT_RECT,
+  OP_SUBTRACT_RECT,
+  OP_VALIDATE,
+  OP_CONTAINS_RECT,
+  OP_NUMBER,
+} bench_op_t;
+
+static const char *opNames[OP_NUMBER] = {
+  "union",
+  "intersect",
+  "subtract",
+  "union_rect",
+  "intersect_rect",
+  "subtract_rect",
+  "validate",
+  "contains_rect",
+};
+
+/* regression case, fixed input of one op */
+typedef struct {
+  const char *name;
+  bench_op_t op;
+  rtgui_rect_t rect;            /* for "*_rect" ops */
+  rt_uint8_t num1, num2;
+  rtgui_rect_t rects1[4];       /* region 1, or rects to validate */
+  rtgui_rect_t rects2[4];       /* region 2 */
+} regress_t;
+
+static const regress_t regressions[] = {
+  /* rtgui_region_subtract() returned FAIL on success (missing braces) */
+  { "subtract_ret", OP_SUBTRACT, { 0, 0, 0, 0 }, 2, 1,
+    { { 0, 0, 10, 4 }, { 0, 6, 10, 10 } },
+    { { 0, 6, 10, 10 } } },
+  /* _quick_sort_rects() compared the wrong rect when scanning down */
+  { "validate_sort", OP_VALIDATE, { 0, 0, 0, 0 }, 3, 0,
+    { { 8, 1, 9, 2 }, { 8, 1, 10, 3 }, { 9, 8, 10, 10 } },
+    { { 0 } } },
+  /* _subtract_func() took right edges as inclusive */
+  { "subtract_edge", OP_SUBTRACT, { 0, 0, 0, 0 }, 1, 2,
+    { { 0, 0, 10, 10 } },
+    { { 0, 0, 4, 10 }, { 6, 0, 8, 10 } } },
+  /* region_op() dropped a row of a partly consumed band */
+  { "op_band_top", OP_SUBTRACT, { 0, 0, 0, 0 }, 1, 1,
+    { { 0, 0, 10, 10 } },
+    { { 0, 3, 10, 6 } } },
+  /* and then the bands after it */
+  { "op_band_rest", OP_SUBTRACT, { 0, 0, 0, 0 }, 2, 1,
+    { { 0, 0, 10, 7 }, { 0, 8, 10, 10 } },
+    { { 0, 3, 10, 6 } } },
+  /* IS_R_INTERSECT() negated only its first term */
+  { "intersect_none", OP_INTERSECT_RECT, { 0, 6, 4, 10 }, 1, 0,
+    { { 0, 0, 4, 4 } },
+    { { 0 } } },
+  { "contains_none", OP_CONTAINS_RECT, { 0, 6, 4, 10 }, 1, 0,
+    { { 0, 0, 4, 4 } },
+    { { 0 } } },
+};
+
+static rt_uint32_t seed = 1;
+static rt_uint32_t failCount[OP_NUMBER];
+
+/* xorshift, repeatable on every target */
+static rt_uint32_t rand32(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static void rand_rect(rtgui_rect_t *rect) {
+  rect->x1 = rand32() % AREA_W;
+  rect->y1 = rand32() % AREA_H;
+  rect->x2 = rect->x1 + 1 + rand32() % (AREA_W - rect->x1);
+  rect->y2 = rect->y1 + 1 + rand32() % (AREA_H - rect->y1);
+}
+
+/* bitmap oracle */
+static void bmp_set(bitmap_t bmp, const rtgui_rect_t *rect) {
+  int x, y;
+
+  for (y = rect->y1; y < rect->y2; y++)
+    for (x = rect->x1; x < rect->x2; x++)
+      bmp[y][x >> 3] |= 1 << (x & 0x07);
+}
+
+static rt_bool_t bmp_get(bitmap_t bmp, int x, int y) {
+  return (bmp[y][x >> 3] & (1 << (x & 0x07))) ? RT_TRUE : RT_FALSE;
+}
+
+static void bmp_from_region(bitmap_t bmp, rtgui_region_t *rgn) {
+  rtgui_rect_t *rects = rtgui_region_rects(rgn);
+  rt_uint32_t i;
+
+  rt_memset(bmp, 0x00, sizeof(bitmap_t));
+  for (i = 0; i < rtgui_region_num_rects(rgn); i++)
+    bmp_set(bmp, &rects[i]);
+}
+
+/* y-x banded, no overlap, no touching rects in a band and tight extents */
+static rt_bool_t check_banding(rtgui_region_t *rgn) {
+  rtgui_rect_t *rects = rtgui_region_rects(rgn);
+  rt_uint32_t num = rtgui_region_num_rects(rgn);
+  rtgui_rect_t ext;
+  rt_uint32_t i;
+
+  if (!num) return RT_TRUE;
+  ext = rects[0];
+  for (i = 0; i < num; i++) {
+    if ((rects[i].x1 >= rects[i].x2) || (rects[i].y1 >= rects[i].y2))
+      return RT_FALSE;
+    if (i) {
+      const rtgui_rect_t *prv = &rects[i - 1];
+
+      if (rects[i].y1 == prv->y1) {
+        /* same band */
+        if ((rects[i].y2 != prv->y2) || (rects[i].x1 <= prv->x2))
+          return RT_FALSE;
+      } else if (rects[i].y1 < prv->y2) {
+        return RT_FALSE;
+      }
+    }
+    if (rects[i].x1 < ext.x1) ext.x1 = rects[i].x1;
+    if (rects[i].y1 < ext.y1) ext.y1 = rects[i].y1;
+    if (rects[i].x2 > ext.x2) ext.x2 = rects[i].x2;
+    if (rects[i].y2 > ext.y2) ext.y2 = rects[i].y2;
+  }
+  return rtgui_rect_is_equal(&ext, &rgn->extents);
+}
+
+static rt_bool_t check_region(rtgui_region_t *rgn, bitmap_t expect) {
+  static bitmap_t got;
+
+  if (!check_banding(rgn)) return RT_FALSE;
+  bmp_from_region(got, rgn);
+  return rt_memcmp(got, expect, sizeof(bitmap_t)) ? RT_FALSE : RT_TRUE;
+}
+
+/* union of "num" rects, or of random rects if "rects" is RT_NULL */
+static void make_region(rtgui_region_t *rgn, bitmap_t bmp,
+  const rtgui_rect_t *rects, rt_uint32_t num) {
+  rtgui_rect_t rect;
+  rt_uint32_t i;
+
+  if (!rects) num = 1 + rand32() % MAX_RECTS;
+  rtgui_region_init_empty(rgn);
+  rt_memset(bmp, 0x00, sizeof(bitmap_t));
+  for (i = 0; i < num; i++) {
+    if (rects) rect = rects[i];
+    else rand_rect(&rect);
+    rtgui_region_union_rect(rgn, rgn, &rect);
+    bmp_set(bmp, &rect);
+  }
+}
+
+/* input of one op */
+typedef struct {
+  rtgui_region_t rgn1, rgn2;
+  rtgui_rect_t rect;
+  rtgui_rect_t rects[MAX_RECTS];  /* to validate */
+  rt_uint32_t num;
+} op_input_t;
+
+static bitmap_t bmp1, bmp2;
+
+/* build input from "tc" or random, and the bitmaps of the sources */
+static void make_input(bench_op_t op, const regress_t *tc, op_input_t *in) {
+  rt_uint32_t i;
+
+  if (tc) {
+    make_region(&in->rgn1, bmp1, tc->rects1, tc->num1);
+    make_region(&in->rgn2, bmp2, tc->rects2, tc->num2);
+    in->rect = tc->rect;
+  } else {
+    make_region(&in->rgn1, bmp1, RT_NULL, 0);
+    make_region(&in->rgn2, bmp2, RT_NULL, 0);
+    rand_rect(&in->rect);
+  }
+  if (OP_VALIDATE != op) return;
+
+  in->num = tc ? tc->num1 : (1 + rand32() % MAX_RECTS);
+  rt_memset(bmp2, 0x00, sizeof(bitmap_t));
+  for (i = 0; i < in->num; i++) {
+    if (tc) in->rects[i] = tc->rects1[i];
+    else rand_rect(&in->rects[i]);
+    bmp_set(bmp2, &in->rects[i]);
+  }
+}
+
+static void free_input(op_input_t *in) {
+  rtgui_region_uninit(&in->rgn2);
+  rtgui_region_uninit(&in->rgn1);
+}
+
+/* run op into "dst", return the status or contains_rect result */
+static int do_op(bench_op_t op, op_input_t *in, rtgui_region_t *dst) {
+  switch (op) {
+  case OP_UNION:
+    return rtgui_region_union(dst, &in->rgn1, &in->rgn2);
+  case OP_INTERSECT:
+    return rtgui_region_intersect(dst, &in->rgn1, &in->rgn2);
+  case OP_SUBTRACT:
+    return rtgui_region_subtract(dst, &in->rgn1, &in->rgn2);
+  case OP_UNION_RECT:
+    return rtgui_region_union_rect(dst, &in->rgn1, &in->rect);
+  case OP_INTERSECT_RECT:
+    return rtgui_region_intersect_rect(dst, &in->rgn1, &in->rect);
+  case OP_SUBTRACT_RECT:
+    return rtgui_region_subtract_rect(dst, &in->rgn1, &in->rect);
+  case OP_VALIDATE:
+  {
+    /* append unsorted and overlapping rects then validate */
+    rtgui_region_t one;
+    int overlap;
+    rt_uint32_t i;
+
+    for (i = 0; i < in->num; i++) {
+      rtgui_region_init_with_extent(&one, &in->rects[i]);
+      rtgui_region_append(dst, &one);
+    }
+    return rtgui_region_validate(dst, &overlap);
+  }
+  case OP_CONTAINS_RECT:
+    return rtgui_region_contains_rect(&in->rgn1, &in->rect);
+  default:
+    return FAIL;
+  }
+}
+
+/* run one op on "tc" or random input, return RT_TRUE if matching the
+   oracle */
+static rt_bool_t run_op(bench_op_t op, const regress_t *tc) {
+  static bitmap_t expect;
+  op_input_t in;
+  rtgui_region_t dst;
+  rtgui_rect_t *rect = &in.rect;
+  rt_bool_t pass;
+  int ret, x, y;
+
+  make_input(op, tc, &in);
+  rtgui_region_init_empty(&dst);
+  ret = do_op(op, &in, &dst);
+
+  if (OP_CONTAINS_RECT == op) {
+    rt_uint32_t num = 0, total = 0;
+
+    for (y = rect->y1; y < rect->y2; y++)
+      for (x = rect->x1; x < rect->x2; x++, total++)
+        if (bmp_get(bmp1, x, y)) num++;
+    pass = (ret == (!num ? RTGUI_REGION_OUT : \
+      ((num == total) ? RTGUI_REGION_IN : RTGUI_REGION_PART)));
+  } else {
+    /* build expected bitmap */
+    rt_memset(expect, 0x00, sizeof(bitmap_t));
+    for (y = 0; y < AREA_H; y++) {
+      for (x = 0; x < AREA_W; x++) {
+        rt_bool_t a = bmp_get(bmp1, x, y);
+        rt_bool_t b = bmp_get(bmp2, x, y);
+        rt_bool_t r = rtgui_rect_contains_point(rect, x, y);
+        rt_bool_t set;
+
+        switch (op) {
+        case OP_UNION:          set = a || b;   break;
+        case OP_INTERSECT:      set = a && b;   break;
+        case OP_SUBTRACT:       set = a && !b;  break;
+        case OP_UNION_RECT:     set = a || r;   break;
+        case OP_INTERSECT_RECT: set = a && r;   break;
+        case OP_SUBTRACT_RECT:  set = a && !r;  break;
+        case OP_VALIDATE:       set = b;        break;
+        default:                set = RT_FALSE; break;
+        }
+        if (set) expect[y][x >> 3] |= 1 << (x & 0x07);
+      }
+    }
+    pass = check_region(&dst, expect) && (PASS == ret);
+  }
+
+  rtgui_region_uninit(&dst);
+  free_input(&in);
+  return pass;
+}
+
+/* run op BENCH_REPEAT times on each of BENCH_ROUND random inputs, return the
+   total time in us, building the inputs is not counted */
+static rt_uint32_t bench_op(bench_op_t op, rt_uint32_t *allocs) {
+  op_input_t in;
+  rtgui_region_t dst;
+  rt_uint32_t i, j, us, total = 0;
+  #ifdef RTGUI_MEM_TRACE
+    rtgui_mem_info_t mem1, mem2;
+  #endif
+
+  *allocs = 0;
+  for (i = 0; i < BENCH_ROUND; i++) {
+    make_input(op, RT_NULL, &in);
+    #ifdef RTGUI_MEM_TRACE
+      rtgui_mem_get_info(&mem1);
+    #endif
+    us = micros();
+    for (j = 0; j < BENCH_REPEAT; j++) {
+      rtgui_region_init_empty(&dst);
+      (void)do_op(op, &in, &dst);
+      rtgui_region_uninit(&dst);
+    }
+    total += micros() - us;
+    #ifdef RTGUI_MEM_TRACE
+      rtgui_mem_get_info(&mem2);
+      *allocs += mem2.alloc_count - mem1.alloc_count;
+    #endif
+    free_input(&in);
+  }
+  return total;
+}
+
+static void rt_region_bench_entry(void *param) {
+  rt_uint32_t op, i, us, allocs, runs = BENCH_ROUND * BENCH_REPEAT;
+  (void)param;
+
+  /* fixed cases of the bugs found */
+  rt_kprintf("\n[regression, %d cases]\n",
+    (int)(sizeof(regressions) / sizeof(regressions[0])));
+  for (i = 0; i < sizeof(regressions) / sizeof(regressions[0]); i++)
+    rt_kprintf("%-16s %s\n", regressions[i].name,
+      run_op(regressions[i].op, &regressions[i]) ? "PASS" : "FAIL");
+
+  /* differential fuzz */
+  rt_kprintf("\n[fuzz, %d rounds]\n", FUZZ_ROUND);
+  for (op = 0; op < OP_NUMBER; op++) {
+    seed = 1 + op;
+    failCount[op] = 0;
+    for (i = 0; i < FUZZ_ROUND; i++) {
+      if (!run_op((bench_op_t)op, RT_NULL)) {
+        if (!failCount[op])
+          rt_kprintf("%s failed at round %d\n", opNames[op], i);
+        failCount[op]++;
+      }
+    }
+    rt_kprintf("%-16s %s (%d failed)\n", opNames[op],
+      failCount[op] ? "FAIL" : "PASS", failCount[op]);
+  }
+
+  /* benchmark, time the total of many runs then divide */
+  rt_kprintf("\n[bench, %d inputs x %d runs]\n", BENCH_ROUND, BENCH_REPEAT);
+  rt_kprintf("%-16s %10s %10s %13s\n", "operation", "ns/op", "ops/sec",
+    "alloc/op");
+  for (op = 0; op < OP_NUMBER; op++) {
+    seed = 1 + op;
+    us = bench_op((bench_op_t)op, &allocs);
+    rt_kprintf("%-16s %10d %10d %10d.%02d\n", opNames[op],
+      (rt_uint32_t)((rt_uint64_t)us * 1000 / runs),
+      us ? (rt_uint32_t)((rt_uint64_t)runs * 1000000 / us) : 0,
+      allocs / runs, (allocs % runs) * 100 / runs);
+  }
+  rt_kprintf("\nDone\n");
+}
+
+
+// RT-Thread function called by "RT_T.begin()"
+void rt_setup(void) {
+  rt_thread_t tid;
+
+  tid = rt_thread_create(
+    "bench_rgn", rt_region_bench_entry, RT_NULL,
+    CONFIG_APP_STACK_SIZE, CONFIG_APP_PRIORITY, CONFIG_APP_TIMESLICE);
+
+  if (tid) {
+    rt_thread_startup(tid);
+  } else {
+    rt_kprintf("create thread failed\n");
+  }
+}
+
+void setup() {
+  RT_T.begin();
+  // no code here as RT_T.begin() never return
+}
+
+// this function will be called by "Arduino" thread
+void loop() {
+  // may put some code here that will be run repeatedly
+}
@@ -0,0 +1,28 @@
+/***************************************************************************//**
+ * @file    Arduino.h
+ * @brief   Arduino API subset of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __ARDUINO_H__
+#define __ARDUINO_H__
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+void setup(void);
+void loop(void);
+
+#endif /* __ARDUINO_H__ */
@@ -0,0 +1,59 @@
+#!/bin/sh
+# Build an example sketch natively for Linux, e.g.
+#   extras/host/build.sh Demo && _host/Demo -o demo.ppm
+# Extra arguments are passed to the compiler, e.g. "-DHOST_LCD_WIDTH=320".
+# The library configuration is still "src/guiconfig.h".
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <example> [cflags...]" >&2
+    exit 1
+fi
+NAME=$1
+shift
+
+ROOT=$(cd "$(dirname "$0")/../.." && pwd)
+HOST=$ROOT/extras/host
+SKETCH=$ROOT/examples/$NAME/$NAME.ino
+OUT=$ROOT/_host
+OBJ=$OUT/obj/$NAME
+if [ ! -f "$SKETCH" ]; then
+    echo "No \"$SKETCH\"" >&2
+    exit 1
+fi
+
+CC=${CC:-cc}
+CXX=${CXX:-c++}
+FLAGS="-O2 -g -Wall -Wno-unused-function -I$ROOT/src -I$HOST $*"
+WRAP="-Wl,--wrap=open,--wrap=stat,--wrap=opendir,--wrap=unlink"
+
+rm -rf "$OBJ"
+mkdir -p "$OBJ"
+
+# "name.o" per source, the path flattened to avoid name clash
+compile() {
+    obj=$OBJ/$(echo "${1#$ROOT/}" | tr '/' '_').o
+    case $1 in
+        *.c)    $CC -std=gnu99 $FLAGS -c "$1" -o "$obj" ;;
+        *.cpp)  $CXX $FLAGS -c "$1" -o "$obj" ;;
+        *.ino)  $CXX $FLAGS -x c++ -include Arduino.h -c "$1" -o "$obj" ;;
+    esac
+}
+
+for src in $(find "$ROOT/src/rtgui" -name '*.c') \
+    "$ROOT/src/lodepng/lodepng.c" "$ROOT/src/tjpgd/tjpgd.c" \
+    "$ROOT/src/rttgui.cpp" "$HOST"/*.c "$HOST"/*.cpp "$SKETCH"; do
+    compile "$src" &
+done
+wait
+if [ $(ls "$OBJ" | wc -l) -ne $(($(find "$ROOT/src/rtgui" -name '*.c' | \
+    wc -l) + 3 + $(ls "$HOST"/*.c "$HOST"/*.cpp | wc -l) + 1)) ]; then
+    echo "Build failed" >&2
+    exit 1
+fi
+
+# library as archive, the unused (e.g. "lodepng") is left out like on board
+ar rcs "$OBJ/libRTT-GUI.a" "$OBJ"/src_*.o
+$CXX $WRAP "$OBJ"/extras_*.o "$OBJ"/examples_*.o "$OBJ/libRTT-GUI.a" \
+    -o "$OUT/$NAME" $LDFLAGS -lpthread -lm
+echo "$OUT/$NAME"
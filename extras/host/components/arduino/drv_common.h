@@ -0,0 +1,11 @@
+/***************************************************************************//**
+ * @file    drv_common.h
+ * @brief   Arduino driver common header of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __DRV_COMMON_H__
+#define __DRV_COMMON_H__
+
+#include "include/rtthread.h"
+
+#endif /* __DRV_COMMON_H__ */
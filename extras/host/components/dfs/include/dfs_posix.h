@@ -0,0 +1,24 @@
+/***************************************************************************//**
+ * @file    dfs_posix.h
+ * @brief   DFS of the host (Linux) port, the POSIX file API of the host
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __DFS_POSIX_H__
+#define __DFS_POSIX_H__
+
+/* "open()", "stat()", "opendir()" and "unlink()" are wrapped by the linker
+   to put absolute paths under the root set by "host_dfs_set_root()" */
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+/* DFS has no "pause()", which is a variable name in the examples */
+#define pause                       host_unistd_pause
+#include <unistd.h>
+#undef pause
+#include <dirent.h>
+
+#ifndef O_BINARY
+# define O_BINARY                   (0)
+#endif
+
+#endif /* __DFS_POSIX_H__ */
@@ -0,0 +1,49 @@
+/***************************************************************************//**
+ * @file    ulog.h
+ * @brief   ulog macros of the host (Linux) port, printed by "rt_kprintf()"
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __ULOG_H__
+#define __ULOG_H__
+
+#include "include/rtthread.h"
+
+#define LOG_LVL_ASSERT              (0)
+#define LOG_LVL_ERROR               (3)
+#define LOG_LVL_WARNING             (4)
+#define LOG_LVL_INFO                (6)
+#define LOG_LVL_DBG                 (7)
+
+#ifndef LOG_TAG
+# define LOG_TAG                    "NO_TAG"
+#endif
+#ifndef LOG_LVL
+# define LOG_LVL                    LOG_LVL_DBG
+#endif
+
+#define ulog_output(lvl, tag, fmt, ...) \
+    rt_kprintf("%c/%s: " fmt "\n", lvl, tag, ##__VA_ARGS__)
+
+#if (LOG_LVL >= LOG_LVL_ERROR)
+# define LOG_E(fmt, ...)            ulog_output('E', LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+# define LOG_E(fmt, ...)
+#endif
+#if (LOG_LVL >= LOG_LVL_WARNING)
+# define LOG_W(fmt, ...)            ulog_output('W', LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+# define LOG_W(fmt, ...)
+#endif
+#if (LOG_LVL >= LOG_LVL_INFO)
+# define LOG_I(fmt, ...)            ulog_output('I', LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+# define LOG_I(fmt, ...)
+#endif
+#if (LOG_LVL >= LOG_LVL_DBG)
+# define LOG_D(fmt, ...)            ulog_output('D', LOG_TAG, fmt, ##__VA_ARGS__)
+#else
+# define LOG_D(fmt, ...)
+#endif
+#define LOG_RAW(...)                rt_kprintf(__VA_ARGS__)
+
+#endif /* __ULOG_H__ */
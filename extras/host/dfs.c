@@ -0,0 +1,73 @@
+/***************************************************************************//**
+ * @file    dfs.c
+ * @brief   File system root of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* The library and sketches use absolute paths on the SD card, e.g.
+   "/font/asc16.fnt". They are opened under "root" by linking with
+   "-Wl,--wrap=open,--wrap=stat,--wrap=opendir,--wrap=unlink". */
+/* Includes ------------------------------------------------------------------*/
+#include <stdarg.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "host.h"
+
+/* Private define ------------------------------------------------------------*/
+#define PATH_LEN_MAX                (512)
+
+/* Private function prototypes -----------------------------------------------*/
+int __real_open(const char *path, int flags, ...);
+int __real_stat(const char *path, struct stat *buf);
+DIR *__real_opendir(const char *path);
+int __real_unlink(const char *path);
+
+/* Private variables ---------------------------------------------------------*/
+static const char *_root = "bin";
+
+/* Private functions ---------------------------------------------------------*/
+static const char *_path(const char *path, char *buf) {
+    if (!path || ('/' != path[0])) return path;
+    (void)snprintf(buf, PATH_LEN_MAX, "%s%s", _root, path);
+    return buf;
+}
+
+/* Public functions ----------------------------------------------------------*/
+void host_dfs_set_root(const char *root) {
+    _root = root;
+}
+
+int __wrap_open(const char *path, int flags, ...) {
+    char buf[PATH_LEN_MAX];
+    mode_t mode = 0;
+
+    if (flags & O_CREAT) {
+        va_list args;
+
+        va_start(args, flags);
+        mode = va_arg(args, mode_t);
+        va_end(args);
+    }
+    return __real_open(_path(path, buf), flags, mode);
+}
+
+int __wrap_stat(const char *path, struct stat *buf) {
+    char name[PATH_LEN_MAX];
+
+    return __real_stat(_path(path, name), buf);
+}
+
+DIR *__wrap_opendir(const char *path) {
+    char buf[PATH_LEN_MAX];
+
+    return __real_opendir(_path(path, buf));
+}
+
+int __wrap_unlink(const char *path) {
+    char buf[PATH_LEN_MAX];
+
+    return __real_unlink(_path(path, buf));
+}
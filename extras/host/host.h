@@ -0,0 +1,39 @@
+/***************************************************************************//**
+ * @file    host.h
+ * @brief   Host (Linux) port of RT-Thread for RTT-GUI
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __HOST_H__
+#define __HOST_H__
+
+#include "include/rtthread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* kernel, "entry" is run by the first thread and never returns */
+void host_kernel_start(void (*entry)(void *param), void *param);
+/* exit after "idle_ms" without any thread or timer to run, or "run_ms" in
+   total, 0 to disable. "hook" is called with the CPU held before exit. */
+void host_kernel_set_exit(rt_uint32_t idle_ms, rt_uint32_t run_ms,
+    void (*hook)(void));
+/* the calling thread is not counted as busy while set */
+void host_thread_set_background(rt_bool_t background);
+
+/* display and touch panel registered by "CONFIG_GUI_DEVICE_NAME" and
+   "CONFIG_TOUCH_DEVICE_NAME" */
+rt_err_t host_lcd_init(void);
+void host_lcd_set_frames(const char *dir, rt_uint32_t interval_ms);
+rt_err_t host_lcd_save(const char *name);
+rt_err_t host_touch_init(void);
+rt_err_t host_touch_add(int x, int y, rt_uint32_t ms);
+
+/* absolute file paths are opened under "root" */
+void host_dfs_set_root(const char *root);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __HOST_H__ */
@@ -0,0 +1,24 @@
+/***************************************************************************//**
+ * @file    rthw.h
+ * @brief   RT-Thread CPU interface of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __RT_HW_H__
+#define __RT_HW_H__
+
+#include "rtthread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* "interrupt" here is the emulated tick, which only runs between the kernel
+   calls of the thread holding the CPU */
+rt_base_t rt_hw_interrupt_disable(void);
+void rt_hw_interrupt_enable(rt_base_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_HW_H__ */
@@ -0,0 +1,487 @@
+/***************************************************************************//**
+ * @file    rtthread.h
+ * @brief   RT-Thread API subset of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __RT_THREAD_H__
+#define __RT_THREAD_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <pthread.h>
+#include "rtconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exported types ------------------------------------------------------------*/
+typedef signed   char               rt_int8_t;
+typedef signed   short              rt_int16_t;
+typedef signed   int                rt_int32_t;
+typedef unsigned char               rt_uint8_t;
+typedef unsigned short              rt_uint16_t;
+typedef unsigned int                rt_uint32_t;
+typedef signed   long long          rt_int64_t;
+typedef unsigned long long          rt_uint64_t;
+typedef int                         rt_bool_t;
+typedef long                        rt_base_t;
+typedef unsigned long               rt_ubase_t;
+typedef rt_base_t                   rt_err_t;
+typedef rt_uint32_t                 rt_time_t;
+typedef rt_uint32_t                 rt_tick_t;
+typedef rt_base_t                   rt_flag_t;
+typedef rt_ubase_t                  rt_size_t;
+typedef rt_base_t                   rt_off_t;
+
+/* Exported defines ----------------------------------------------------------*/
+#define RT_TRUE                     (1)
+#define RT_FALSE                    (0)
+#define RT_NULL                     (0)
+
+#define RT_EOK                      (0)
+#define RT_ERROR                    (1)
+#define RT_ETIMEOUT                 (2)
+#define RT_EFULL                    (3)
+#define RT_EEMPTY                   (4)
+#define RT_ENOMEM                   (5)
+#define RT_ENOSYS                   (6)
+#define RT_EBUSY                    (7)
+#define RT_EIO                      (8)
+#define RT_EINTR                    (9)
+#define RT_EINVAL                   (10)
+
+#define RT_WAITING_FOREVER          (-1)
+#define RT_WAITING_NO               (0)
+
+#define RT_IPC_FLAG_FIFO            (0x00)
+#define RT_IPC_FLAG_PRIO            (0x01)
+
+#define RT_TIMER_FLAG_DEACTIVATED   (0x0)
+#define RT_TIMER_FLAG_ACTIVATED     (0x1)
+#define RT_TIMER_FLAG_ONE_SHOT      (0x0)
+#define RT_TIMER_FLAG_PERIODIC      (0x2)
+#define RT_TIMER_FLAG_HARD_TIMER    (0x0)
+#define RT_TIMER_FLAG_SOFT_TIMER    (0x4)
+#define RT_TIMER_CTRL_SET_TIME      (0x0)
+#define RT_TIMER_CTRL_GET_TIME      (0x1)
+#define RT_TIMER_CTRL_SET_ONESHOT   (0x2)
+#define RT_TIMER_CTRL_SET_PERIODIC  (0x3)
+
+#define RT_DEVICE_FLAG_RDONLY       (0x001)
+#define RT_DEVICE_FLAG_WRONLY       (0x002)
+#define RT_DEVICE_FLAG_RDWR         (0x003)
+#define RT_DEVICE_FLAG_REMOVABLE    (0x004)
+#define RT_DEVICE_FLAG_STANDALONE   (0x008)
+#define RT_DEVICE_FLAG_ACTIVATED    (0x010)
+#define RT_DEVICE_FLAG_SUSPENDED    (0x020)
+#define RT_DEVICE_FLAG_STREAM       (0x040)
+#define RT_DEVICE_FLAG_INT_RX       (0x100)
+#define RT_DEVICE_FLAG_DMA_RX       (0x200)
+#define RT_DEVICE_FLAG_INT_TX       (0x400)
+#define RT_DEVICE_FLAG_DMA_TX       (0x800)
+#define RT_DEVICE_CTRL_RESUME       (0x01)
+#define RT_DEVICE_CTRL_SUSPEND      (0x02)
+#define RT_DEVICE_CTRL_CONFIG       (0x03)
+#define RT_DEVICE_CTRL_SET_INT      (0x10)
+#define RT_DEVICE_CTRL_CLR_INT      (0x11)
+#define RT_DEVICE_CTRL_GET_INT      (0x12)
+#define RT_DEVICE_CTRL_SET_RX_INDICATOR     (0x20)
+#define RT_DEVICE_CTRL_CURSOR_SET_POSITION  (0x10)
+#define RT_DEVICE_CTRL_CURSOR_SET_TYPE      (0x11)
+
+#define rt_inline                   static __inline
+#define RT_UNUSED                   __attribute__((unused))
+#define RTM_EXPORT(symbol)
+#define INIT_BOARD_EXPORT(fn)
+#define INIT_DEVICE_EXPORT(fn)
+#define INIT_COMPONENT_EXPORT(fn)
+#define INIT_ENV_EXPORT(fn)
+#define INIT_APP_EXPORT(fn)
+
+#define RT_ASSERT(EX)               \
+    if (!(EX)) { rt_assert_handler(#EX, __FUNCTION__, __LINE__); }
+
+#define rt_container_of(ptr, type, member) \
+    ((type *)((char *)(ptr) - (unsigned long)(&((type *)0)->member)))
+
+/* Exported types (objects) --------------------------------------------------*/
+typedef struct rt_list_node {
+    struct rt_list_node *next;
+    struct rt_list_node *prev;
+} rt_list_t;
+
+typedef struct rt_slist_node {
+    struct rt_slist_node *next;
+} rt_slist_t;
+
+struct rt_object {
+    char name[RT_NAME_MAX];
+    rt_uint8_t type;
+    rt_uint8_t flag;
+    rt_list_t list;
+};
+typedef struct rt_object *rt_object_t;
+
+struct rt_ipc_object {
+    struct rt_object parent;
+    rt_list_t suspend_thread;               /* threads waiting on it */
+};
+
+struct rt_thread {
+    char name[RT_NAME_MAX];
+    rt_uint8_t type;
+    rt_uint8_t flags;
+    rt_list_t list;
+    rt_list_t tlist;                        /* ready or suspend list */
+    void (*entry)(void *parameter);
+    void *parameter;
+    rt_uint8_t stat;
+    rt_uint8_t current_priority;
+    rt_uint8_t init_priority;
+    rt_ubase_t init_tick;
+    rt_ubase_t remaining_tick;
+    rt_err_t error;
+    rt_ubase_t user_data;
+    /* host */
+    pthread_t pthread;
+    pthread_cond_t cond;
+    rt_tick_t timeout_tick;                 /* valid if in timeout list */
+    rt_list_t timeout_list;
+    rt_bool_t background;                   /* not counted as busy */
+};
+typedef struct rt_thread *rt_thread_t;
+
+struct rt_mutex {
+    struct rt_ipc_object parent;
+    rt_uint16_t value;
+    rt_uint8_t original_priority;
+    rt_uint8_t hold;
+    struct rt_thread *owner;
+};
+typedef struct rt_mutex *rt_mutex_t;
+
+struct rt_mailbox {
+    struct rt_ipc_object parent;
+    rt_ubase_t *msg_pool;
+    rt_uint16_t size;
+    rt_uint16_t entry;
+    rt_uint16_t in_offset;
+    rt_uint16_t out_offset;
+    rt_list_t suspend_sender_thread;
+};
+typedef struct rt_mailbox *rt_mailbox_t;
+
+struct rt_mempool {
+    struct rt_object parent;
+    void *start_address;
+    rt_size_t size;
+    rt_size_t block_size;
+    rt_uint8_t *block_list;
+    rt_size_t block_total_count;
+    rt_size_t block_free_count;
+    rt_list_t suspend_thread;
+};
+typedef struct rt_mempool *rt_mp_t;
+
+struct rt_timer {
+    struct rt_object parent;
+    rt_list_t row;
+    void (*timeout_func)(void *parameter);
+    void *parameter;
+    rt_tick_t init_tick;
+    rt_tick_t timeout_tick;
+};
+typedef struct rt_timer *rt_timer_t;
+
+enum rt_device_class_type {
+    RT_Device_Class_Char = 0,
+    RT_Device_Class_Block,
+    RT_Device_Class_NetIf,
+    RT_Device_Class_MTD,
+    RT_Device_Class_CAN,
+    RT_Device_Class_RTC,
+    RT_Device_Class_Sound,
+    RT_Device_Class_Graphic,
+    RT_Device_Class_I2CBUS,
+    RT_Device_Class_USBDevice,
+    RT_Device_Class_USBHost,
+    RT_Device_Class_SPIBUS,
+    RT_Device_Class_SPIDevice,
+    RT_Device_Class_SDIO,
+    RT_Device_Class_PM,
+    RT_Device_Class_Pipe,
+    RT_Device_Class_Portal,
+    RT_Device_Class_Timer,
+    RT_Device_Class_Miscellaneous,
+    RT_Device_Class_Sensor,
+    RT_Device_Class_Touch,
+    RT_Device_Class_Unknown
+};
+
+typedef struct rt_device *rt_device_t;
+
+struct rt_device_ops {
+    rt_err_t (*init)(rt_device_t dev);
+    rt_err_t (*open)(rt_device_t dev, rt_uint16_t oflag);
+    rt_err_t (*close)(rt_device_t dev);
+    rt_size_t (*read)(rt_device_t dev, rt_off_t pos, void *buffer,
+        rt_size_t size);
+    rt_size_t (*write)(rt_device_t dev, rt_off_t pos, const void *buffer,
+        rt_size_t size);
+    rt_err_t (*control)(rt_device_t dev, int cmd, void *args);
+};
+
+struct rt_device {
+    struct rt_object parent;
+    enum rt_device_class_type type;
+    rt_uint16_t flag;
+    rt_uint16_t open_flag;
+    rt_uint8_t ref_count;
+    rt_uint8_t device_id;
+    rt_err_t (*rx_indicate)(rt_device_t dev, rt_size_t size);
+    rt_err_t (*tx_complete)(rt_device_t dev, void *buffer);
+    #ifdef RT_USING_DEVICE_OPS
+        const struct rt_device_ops *ops;
+    #else
+        rt_err_t (*init)(rt_device_t dev);
+        rt_err_t (*open)(rt_device_t dev, rt_uint16_t oflag);
+        rt_err_t (*close)(rt_device_t dev);
+        rt_size_t (*read)(rt_device_t dev, rt_off_t pos, void *buffer,
+            rt_size_t size);
+        rt_size_t (*write)(rt_device_t dev, rt_off_t pos, const void *buffer,
+            rt_size_t size);
+        rt_err_t (*control)(rt_device_t dev, int cmd, void *args);
+    #endif
+    void *user_data;
+};
+
+/* graphic device */
+enum {
+    RTGRAPHIC_CTRL_RECT_UPDATE = 0,
+    RTGRAPHIC_CTRL_POWERON,
+    RTGRAPHIC_CTRL_POWEROFF,
+    RTGRAPHIC_CTRL_GET_INFO,
+    RTGRAPHIC_CTRL_SET_MODE,
+    RTGRAPHIC_CTRL_GET_EXT
+};
+
+enum {
+    RTGRAPHIC_PIXEL_FORMAT_MONO = 0,
+    RTGRAPHIC_PIXEL_FORMAT_GRAY4,
+    RTGRAPHIC_PIXEL_FORMAT_GRAY16,
+    RTGRAPHIC_PIXEL_FORMAT_RGB332,
+    RTGRAPHIC_PIXEL_FORMAT_RGB444,
+    RTGRAPHIC_PIXEL_FORMAT_RGB565,
+    RTGRAPHIC_PIXEL_FORMAT_RGB565P,
+    RTGRAPHIC_PIXEL_FORMAT_BGR565 = RTGRAPHIC_PIXEL_FORMAT_RGB565P,
+    RTGRAPHIC_PIXEL_FORMAT_RGB666,
+    RTGRAPHIC_PIXEL_FORMAT_RGB888,
+    RTGRAPHIC_PIXEL_FORMAT_BGR888,
+    RTGRAPHIC_PIXEL_FORMAT_ARGB888,
+    RTGRAPHIC_PIXEL_FORMAT_ABGR888,
+    RTGRAPHIC_PIXEL_FORMAT_RESERVED,
+    RTGRAPHIC_PIXEL_FORMAT_RGB2I,
+    RTGRAPHIC_PIXEL_FORMAT_RGB4I,
+    RTGRAPHIC_PIXEL_FORMAT_RGB8I,
+};
+
+struct rt_device_graphic_info {
+    rt_uint8_t pixel_format;
+    rt_uint8_t bits_per_pixel;
+    rt_uint16_t reserved;
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint8_t *framebuffer;
+};
+
+struct rt_device_rect_info {
+    rt_uint16_t x;
+    rt_uint16_t y;
+    rt_uint16_t width;
+    rt_uint16_t height;
+};
+
+/* Exported functions (service) ----------------------------------------------*/
+#define RT_LIST_OBJECT_INIT(object) { &(object), &(object) }
+#define rt_list_entry(node, type, member) \
+    rt_container_of(node, type, member)
+#define rt_list_for_each(pos, head) \
+    for (pos = (head)->next; pos != (head); pos = pos->next)
+#define rt_list_for_each_safe(pos, n, head) \
+    for (pos = (head)->next, n = pos->next; pos != (head); \
+        pos = n, n = pos->next)
+#define rt_slist_entry(node, type, member) \
+    rt_container_of(node, type, member)
+#define rt_slist_for_each(pos, head) \
+    for (pos = (head)->next; pos != RT_NULL; pos = pos->next)
+
+rt_inline void rt_list_init(rt_list_t *l) {
+    l->next = l->prev = l;
+}
+
+rt_inline void rt_list_insert_after(rt_list_t *l, rt_list_t *n) {
+    l->next->prev = n;
+    n->next = l->next;
+    l->next = n;
+    n->prev = l;
+}
+
+rt_inline void rt_list_insert_before(rt_list_t *l, rt_list_t *n) {
+    l->prev->next = n;
+    n->prev = l->prev;
+    l->prev = n;
+    n->next = l;
+}
+
+rt_inline void rt_list_remove(rt_list_t *n) {
+    n->next->prev = n->prev;
+    n->prev->next = n->next;
+    n->next = n->prev = n;
+}
+
+rt_inline int rt_list_isempty(const rt_list_t *l) {
+    return l->next == l;
+}
+
+rt_inline unsigned int rt_list_len(const rt_list_t *l) {
+    unsigned int len = 0;
+    const rt_list_t *p = l;
+
+    while (p->next != l) {
+        p = p->next;
+        len++;
+    }
+    return len;
+}
+
+rt_inline void rt_slist_init(rt_slist_t *l) {
+    l->next = RT_NULL;
+}
+
+rt_inline void rt_slist_append(rt_slist_t *l, rt_slist_t *n) {
+    struct rt_slist_node *node = l;
+
+    while (node->next) node = node->next;
+    node->next = n;
+    n->next = RT_NULL;
+}
+
+rt_inline void rt_slist_insert(rt_slist_t *l, rt_slist_t *n) {
+    n->next = l->next;
+    l->next = n;
+}
+
+rt_inline rt_slist_t *rt_slist_remove(rt_slist_t *l, rt_slist_t *n) {
+    struct rt_slist_node *node = l;
+
+    while (node->next && (node->next != n)) node = node->next;
+    if (node->next != RT_NULL) node->next = node->next->next;
+    return l;
+}
+
+rt_inline unsigned int rt_slist_len(const rt_slist_t *l) {
+    unsigned int len = 0;
+    const rt_slist_t *list = l->next;
+
+    while (list != RT_NULL) {
+        list = list->next;
+        len++;
+    }
+    return len;
+}
+
+/* Exported functions (kernel) -----------------------------------------------*/
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line);
+
+rt_tick_t rt_tick_get(void);
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms);
+
+rt_thread_t rt_thread_create(const char *name,
+    void (*entry)(void *parameter), void *parameter, rt_uint32_t stack_size,
+    rt_uint8_t priority, rt_uint32_t tick);
+rt_err_t rt_thread_delete(rt_thread_t thread);
+rt_err_t rt_thread_startup(rt_thread_t thread);
+rt_thread_t rt_thread_self(void);
+rt_err_t rt_thread_yield(void);
+rt_err_t rt_thread_delay(rt_tick_t tick);
+rt_err_t rt_thread_mdelay(rt_int32_t ms);
+rt_err_t rt_thread_sleep(rt_tick_t tick);
+void rt_enter_critical(void);
+void rt_exit_critical(void);
+rt_uint16_t rt_critical_level(void);
+
+void rt_timer_init(rt_timer_t timer, const char *name,
+    void (*timeout)(void *parameter), void *parameter, rt_tick_t time,
+    rt_uint8_t flag);
+rt_err_t rt_timer_detach(rt_timer_t timer);
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter),
+    void *parameter, rt_tick_t time, rt_uint8_t flag);
+rt_err_t rt_timer_delete(rt_timer_t timer);
+rt_err_t rt_timer_start(rt_timer_t timer);
+rt_err_t rt_timer_stop(rt_timer_t timer);
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg);
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_detach(rt_mutex_t mutex);
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag);
+rt_err_t rt_mutex_delete(rt_mutex_t mutex);
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time);
+rt_err_t rt_mutex_release(rt_mutex_t mutex);
+
+rt_err_t rt_mb_init(rt_mailbox_t mb, const char *name, void *msgpool,
+    rt_size_t size, rt_uint8_t flag);
+rt_err_t rt_mb_detach(rt_mailbox_t mb);
+rt_mailbox_t rt_mb_create(const char *name, rt_size_t size, rt_uint8_t flag);
+rt_err_t rt_mb_delete(rt_mailbox_t mb);
+rt_err_t rt_mb_send(rt_mailbox_t mb, rt_ubase_t value);
+rt_err_t rt_mb_send_wait(rt_mailbox_t mb, rt_ubase_t value,
+    rt_int32_t timeout);
+rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
+
+rt_mp_t rt_mp_create(const char *name, rt_size_t block_count,
+    rt_size_t block_size);
+rt_err_t rt_mp_delete(rt_mp_t mp);
+void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time);
+void rt_mp_free(void *block);
+
+void *rt_malloc(rt_size_t size);
+void rt_free(void *ptr);
+void *rt_realloc(void *ptr, rt_size_t newsize);
+void *rt_calloc(rt_size_t count, rt_size_t size);
+
+rt_device_t rt_device_find(const char *name);
+rt_err_t rt_device_register(rt_device_t dev, const char *name,
+    rt_uint16_t flags);
+rt_err_t rt_device_unregister(rt_device_t dev);
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag);
+rt_err_t rt_device_close(rt_device_t dev);
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer,
+    rt_size_t size);
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer,
+    rt_size_t size);
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg);
+
+void rt_kprintf(const char *fmt, ...);
+rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt,
+    va_list args);
+rt_int32_t rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...);
+rt_int32_t rt_sprintf(char *buf, const char *format, ...);
+void *rt_memset(void *src, int c, rt_ubase_t n);
+void *rt_memcpy(void *dest, const void *src, rt_ubase_t n);
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n);
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count);
+char *rt_strstr(const char *str1, const char *str2);
+rt_int32_t rt_strcasecmp(const char *a, const char *b);
+char *rt_strncpy(char *dest, const char *src, rt_ubase_t n);
+rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count);
+rt_int32_t rt_strcmp(const char *cs, const char *ct);
+rt_size_t rt_strlen(const char *src);
+char *rt_strdup(const char *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RT_THREAD_H__ */
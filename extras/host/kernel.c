@@ -0,0 +1,940 @@
+/***************************************************************************//**
+ * @file    kernel.c
+ * @brief   RT-Thread kernel emulation of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* Each RT-Thread thread is a pthread, but only the one in "_current" runs:
+   it holds "_cpu" until it blocks, like the only thread on a MCU. The switch
+   is done by the scheduler below with the same rules as RT-Thread: highest
+   priority first, round robin by time slice in one priority.
+
+   The tick "interrupt" (timers and timeouts) is run by the running thread at
+   its next kernel call, or by the tick pthread (the one called
+   "host_kernel_start()") if all threads are blocked. So a thread computing
+   without any kernel call is never preempted. */
+/* Includes ------------------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <errno.h>
+
+#include "include/rtthread.h"
+#include "include/rthw.h"
+#include "host.h"
+
+/* Private define ------------------------------------------------------------*/
+#define RT_THREAD_INIT              (0x00)
+#define RT_THREAD_READY             (0x01)
+#define RT_THREAD_SUSPEND           (0x02)
+#define RT_THREAD_RUNNING           (0x03)
+#define RT_THREAD_CLOSE             (0x04)
+
+#define TICK_AFTER(a, b)            ((rt_int32_t)((a) - (b)) >= 0)
+#define TICK_PERIOD_NS              (1000000000L / RT_TICK_PER_SECOND)
+
+/* Private variables ---------------------------------------------------------*/
+static pthread_mutex_t _cpu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _tick_cond = PTHREAD_COND_INITIALIZER;
+static __thread rt_thread_t _me;            /* thread of this pthread */
+static rt_thread_t _current;
+static rt_list_t _ready[RT_THREAD_PRIORITY_MAX];
+static rt_uint32_t _ready_group;            /* bit per priority */
+static rt_list_t _sleepers;                 /* suspended with timeout */
+static rt_list_t _timers;                   /* activated */
+static rt_list_t _devices;
+static rt_tick_t _deadline;                 /* earliest sleeper or timer */
+static rt_bool_t _has_deadline;
+static rt_base_t _irq_level;
+static rt_uint16_t _critical;
+static rt_bool_t _in_isr;
+static rt_bool_t _need_resched;
+static struct timespec _start;
+static rt_uint32_t _idle_ms, _run_ms;
+static void (*_exit_hook)(void);
+
+/* Private functions ---------------------------------------------------------*/
+static rt_tick_t _now(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_tick_t)((ts.tv_sec - _start.tv_sec) * RT_TICK_PER_SECOND + \
+        (ts.tv_nsec - _start.tv_nsec) / TICK_PERIOD_NS);
+}
+
+static void _update_deadline(rt_tick_t tick) {
+    if (!_has_deadline || !TICK_AFTER(tick, _deadline)) {
+        _deadline = tick;
+        _has_deadline = RT_TRUE;
+    }
+}
+
+static void _object_init(struct rt_object *obj, const char *name) {
+    rt_memset(obj->name, 0x00, sizeof(obj->name));
+    if (name) rt_strncpy(obj->name, name, RT_NAME_MAX - 1);
+    rt_list_init(&obj->list);
+}
+
+static rt_thread_t _highest_ready(void) {
+    if (!_ready_group) return RT_NULL;
+    return rt_list_entry(_ready[__builtin_ctz(_ready_group)].next,
+        struct rt_thread, tlist);
+}
+
+static void _insert_ready(rt_thread_t thread) {
+    rt_uint8_t prio = thread->current_priority;
+
+    thread->stat = RT_THREAD_READY;
+    rt_list_insert_before(&_ready[prio], &thread->tlist);
+    _ready_group |= 1UL << prio;
+}
+
+static void _remove_ready(rt_thread_t thread) {
+    rt_uint8_t prio = thread->current_priority;
+
+    rt_list_remove(&thread->tlist);
+    if (rt_list_isempty(&_ready[prio]))
+        _ready_group &= ~(1UL << prio);
+}
+
+static void _wait_cpu(rt_thread_t thread) {
+    while (_current != thread)
+        pthread_cond_wait(&thread->cond, &_cpu);
+}
+
+/* switch to the highest ready thread if it should preempt "_current", the
+   calling thread then waits until it is "_current" again */
+static void _schedule(void) {
+    rt_thread_t from = _current, to;
+
+    if (_critical || _in_isr) {
+        _need_resched = RT_TRUE;
+        return;
+    }
+    _need_resched = RT_FALSE;
+
+    to = _highest_ready();
+    if (from && (RT_THREAD_RUNNING == from->stat)) {
+        if (!to || (to->current_priority > from->current_priority))
+            return;
+        /* same priority: only at the end of time slice */
+        if ((to->current_priority == from->current_priority) && \
+            !TICK_AFTER(_now(), from->remaining_tick + from->init_tick))
+            return;
+        _insert_ready(from);
+        to = _highest_ready();
+    }
+
+    if (to) {
+        _remove_ready(to);
+        to->stat = RT_THREAD_RUNNING;
+        to->remaining_tick = _now();
+        if (to != _me) pthread_cond_signal(&to->cond);
+    }
+    _current = to;
+    if (_me && (_me != to) && (RT_THREAD_CLOSE != _me->stat))
+        _wait_cpu(_me);
+}
+
+/* the tick interrupt: wake up sleepers and run timers */
+static void _tick_isr(void) {
+    rt_tick_t now = _now();
+    rt_list_t expired, *node, *next;
+
+    if (!_has_deadline || !TICK_AFTER(now, _deadline)) return;
+    _in_isr = RT_TRUE;
+    _has_deadline = RT_FALSE;
+
+    rt_list_for_each_safe(node, next, &_sleepers) {
+        rt_thread_t thread = rt_list_entry(node, struct rt_thread,
+            timeout_list);
+
+        if (TICK_AFTER(now, thread->timeout_tick)) {
+            rt_list_remove(&thread->tlist);
+            rt_list_remove(&thread->timeout_list);
+            thread->error = -RT_ETIMEOUT;
+            _insert_ready(thread);
+        } else {
+            _update_deadline(thread->timeout_tick);
+        }
+    }
+
+    /* the timeout functions may start or stop timers */
+    rt_list_init(&expired);
+    rt_list_for_each_safe(node, next, &_timers) {
+        rt_timer_t timer = rt_list_entry(node, struct rt_timer, row);
+
+        if (TICK_AFTER(now, timer->timeout_tick)) {
+            rt_list_remove(&timer->row);
+            rt_list_insert_before(&expired, &timer->row);
+        }
+    }
+    while (!rt_list_isempty(&expired)) {
+        rt_timer_t timer = rt_list_entry(expired.next, struct rt_timer, row);
+
+        rt_list_remove(&timer->row);
+        timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+        if (timer->parent.flag & RT_TIMER_FLAG_PERIODIC)
+            rt_timer_start(timer);
+        timer->timeout_func(timer->parameter);
+    }
+    rt_list_for_each(node, &_timers) {
+        _update_deadline(rt_list_entry(node, struct rt_timer,
+            row)->timeout_tick);
+    }
+
+    _in_isr = RT_FALSE;
+    _need_resched = RT_TRUE;
+}
+
+/* where the running thread may be interrupted or preempted */
+static void _check_point(void) {
+    if (_in_isr || _irq_level || (_me != _current)) return;
+    if (_has_deadline) _tick_isr();
+    if (_critical) return;
+    if (_need_resched || (_ready_group && _current && \
+        (__builtin_ctz(_ready_group) <= _current->current_priority)))
+        _schedule();
+}
+
+/* block the calling thread on "list" (or sleep if RT_NULL) */
+static rt_err_t _suspend(rt_list_t *list, rt_int32_t timeout) {
+    rt_thread_t thread = _me;
+
+    RT_ASSERT((RT_NULL != thread) && (thread == _current));
+    RT_ASSERT(!_in_isr && !_critical && !_irq_level);
+
+    thread->stat = RT_THREAD_SUSPEND;
+    thread->error = RT_EOK;
+    if (list) rt_list_insert_before(list, &thread->tlist);
+    if (timeout > 0) {
+        thread->timeout_tick = _now() + timeout;
+        rt_list_insert_before(&_sleepers, &thread->timeout_list);
+        _update_deadline(thread->timeout_tick);
+    }
+    _schedule();
+    return thread->error;
+}
+
+static void _resume(rt_thread_t thread) {
+    rt_list_remove(&thread->tlist);
+    rt_list_remove(&thread->timeout_list);
+    thread->error = RT_EOK;
+    _insert_ready(thread);
+}
+
+static void _resume_first(rt_list_t *list) {
+    if (!rt_list_isempty(list))
+        _resume(rt_list_entry(list->next, struct rt_thread, tlist));
+}
+
+static void _resume_all(rt_list_t *list, rt_err_t error) {
+    while (!rt_list_isempty(list)) {
+        rt_thread_t thread = rt_list_entry(list->next, struct rt_thread,
+            tlist);
+
+        _resume(thread);
+        thread->error = error;
+    }
+}
+
+static rt_int32_t _time_left(rt_int32_t timeout, rt_tick_t start) {
+    if (timeout <= 0) return timeout;
+    timeout -= (rt_int32_t)(_now() - start);
+    return (timeout > 0) ? timeout : 0;
+}
+
+static void *_thread_main(void *param) {
+    rt_thread_t thread = param;
+
+    pthread_mutex_lock(&_cpu);
+    _me = thread;
+    _wait_cpu(thread);
+    thread->entry(thread->parameter);
+
+    /* exit */
+    thread->stat = RT_THREAD_CLOSE;
+    _schedule();
+    pthread_mutex_unlock(&_cpu);
+    pthread_cond_destroy(&thread->cond);
+    rt_free(thread);
+    return RT_NULL;
+}
+
+static rt_bool_t _is_busy(void) {
+    rt_list_t *node;
+    rt_uint32_t i;
+
+    if (_current && !_current->background) return RT_TRUE;
+    if (!rt_list_isempty(&_timers)) return RT_TRUE;
+    for (i = 0; i < RT_THREAD_PRIORITY_MAX; i++) {
+        rt_list_for_each(node, &_ready[i]) {
+            if (!rt_list_entry(node, struct rt_thread, tlist)->background)
+                return RT_TRUE;
+        }
+    }
+    rt_list_for_each(node, &_sleepers) {
+        if (!rt_list_entry(node, struct rt_thread, timeout_list)->background)
+            return RT_TRUE;
+    }
+    return RT_FALSE;
+}
+
+/* Public functions (host) ---------------------------------------------------*/
+void host_kernel_start(void (*entry)(void *param), void *param) {
+    rt_thread_t thread;
+    rt_tick_t idle_since = 0;
+    rt_bool_t idle = RT_FALSE;
+    rt_uint32_t i;
+
+    for (i = 0; i < RT_THREAD_PRIORITY_MAX; i++)
+        rt_list_init(&_ready[i]);
+    rt_list_init(&_sleepers);
+    rt_list_init(&_timers);
+    rt_list_init(&_devices);
+    clock_gettime(CLOCK_MONOTONIC, &_start);
+    setvbuf(stdout, RT_NULL, _IOLBF, 0);
+
+    pthread_mutex_lock(&_cpu);
+    thread = rt_thread_create("main", entry, param, 0,
+        RT_THREAD_PRIORITY_MAX - 2, 20);
+    RT_ASSERT(RT_NULL != thread);
+    rt_thread_startup(thread);
+
+    /* tick */
+    for ( ; ; ) {
+        struct timespec ts;
+        rt_tick_t now;
+
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += TICK_PERIOD_NS;
+        if (ts.tv_nsec >= 1000000000L) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000L;
+        }
+        (void)pthread_cond_timedwait(&_tick_cond, &_cpu, &ts);
+
+        _tick_isr();
+        if (!_critical && !_irq_level && \
+            (_need_resched || (!_current && _ready_group)))
+            _schedule();
+
+        now = _now();
+        if (_run_ms && TICK_AFTER(now, rt_tick_from_millisecond(_run_ms)))
+            break;
+        if (_is_busy()) {
+            idle = RT_FALSE;
+        } else if (!idle) {
+            idle = RT_TRUE;
+            idle_since = now;
+        } else if (_idle_ms && \
+            TICK_AFTER(now, idle_since + rt_tick_from_millisecond(_idle_ms))) {
+            break;
+        }
+    }
+
+    if (_exit_hook) _exit_hook();
+    fflush(stdout);
+    exit(0);
+}
+
+void host_kernel_set_exit(rt_uint32_t idle_ms, rt_uint32_t run_ms,
+    void (*hook)(void)) {
+    _idle_ms = idle_ms;
+    _run_ms = run_ms;
+    _exit_hook = hook;
+}
+
+void host_thread_set_background(rt_bool_t background) {
+    if (_me) _me->background = background;
+}
+
+/* Public functions (kernel) -------------------------------------------------*/
+void rt_assert_handler(const char *ex, const char *func, rt_size_t line) {
+    fprintf(stderr, "(%s) assertion failed at function:%s, line number:%lu\n",
+        ex, func, (unsigned long)line);
+    abort();
+}
+
+rt_base_t rt_hw_interrupt_disable(void) {
+    return _irq_level++;
+}
+
+void rt_hw_interrupt_enable(rt_base_t level) {
+    _irq_level = level;
+    if (!level) _check_point();
+}
+
+rt_tick_t rt_tick_get(void) {
+    _check_point();
+    return _now();
+}
+
+rt_tick_t rt_tick_from_millisecond(rt_int32_t ms) {
+    if (ms < 0) return (rt_tick_t)RT_WAITING_FOREVER;
+    return (RT_TICK_PER_SECOND * ms + 999) / 1000;
+}
+
+void rt_enter_critical(void) {
+    _critical++;
+}
+
+void rt_exit_critical(void) {
+    if (_critical) _critical--;
+    if (!_critical) _check_point();
+}
+
+rt_uint16_t rt_critical_level(void) {
+    return _critical;
+}
+
+/* thread */
+rt_thread_t rt_thread_create(const char *name,
+    void (*entry)(void *parameter), void *parameter, rt_uint32_t stack_size,
+    rt_uint8_t priority, rt_uint32_t tick) {
+    rt_thread_t thread;
+    pthread_attr_t attr;
+
+    (void)stack_size;
+    RT_ASSERT(priority < RT_THREAD_PRIORITY_MAX);
+    thread = rt_calloc(1, sizeof(struct rt_thread));
+    if (!thread) return RT_NULL;
+
+    rt_strncpy(thread->name, name, RT_NAME_MAX - 1);
+    rt_list_init(&thread->list);
+    rt_list_init(&thread->tlist);
+    rt_list_init(&thread->timeout_list);
+    thread->entry = entry;
+    thread->parameter = parameter;
+    thread->stat = RT_THREAD_INIT;
+    thread->current_priority = thread->init_priority = priority;
+    thread->init_tick = tick ? tick : 1;
+    pthread_cond_init(&thread->cond, RT_NULL);
+
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    if (pthread_create(&thread->pthread, &attr, _thread_main, thread)) {
+        pthread_cond_destroy(&thread->cond);
+        rt_free(thread);
+        thread = RT_NULL;
+    }
+    pthread_attr_destroy(&attr);
+    return thread;
+}
+
+rt_err_t rt_thread_delete(rt_thread_t thread) {
+    /* only the thread itself may exit, by return from its entry */
+    (void)thread;
+    return -RT_ENOSYS;
+}
+
+rt_err_t rt_thread_startup(rt_thread_t thread) {
+    RT_ASSERT(RT_THREAD_INIT == thread->stat);
+    _insert_ready(thread);
+    if (_current) _check_point();
+    else if (!_me) _schedule();
+    return RT_EOK;
+}
+
+rt_thread_t rt_thread_self(void) {
+    return _current;
+}
+
+rt_err_t rt_thread_yield(void) {
+    rt_thread_t thread = _me;
+
+    _check_point();
+    if (!thread || _critical) return RT_EOK;
+    _insert_ready(thread);
+    _schedule();
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_delay(rt_tick_t tick) {
+    _check_point();
+    if (!tick) return rt_thread_yield();
+    (void)_suspend(RT_NULL, (rt_int32_t)tick);
+    return RT_EOK;
+}
+
+rt_err_t rt_thread_mdelay(rt_int32_t ms) {
+    return rt_thread_delay(rt_tick_from_millisecond(ms));
+}
+
+rt_err_t rt_thread_sleep(rt_tick_t tick) {
+    return rt_thread_delay(tick);
+}
+
+/* timer */
+void rt_timer_init(rt_timer_t timer, const char *name,
+    void (*timeout)(void *parameter), void *parameter, rt_tick_t time,
+    rt_uint8_t flag) {
+    _object_init(&timer->parent, name);
+    timer->parent.flag = flag & ~RT_TIMER_FLAG_ACTIVATED;
+    rt_list_init(&timer->row);
+    timer->timeout_func = timeout;
+    timer->parameter = parameter;
+    timer->init_tick = time;
+    timer->timeout_tick = 0;
+}
+
+rt_err_t rt_timer_detach(rt_timer_t timer) {
+    return rt_timer_stop(timer);
+}
+
+rt_timer_t rt_timer_create(const char *name, void (*timeout)(void *parameter),
+    void *parameter, rt_tick_t time, rt_uint8_t flag) {
+    rt_timer_t timer = rt_malloc(sizeof(struct rt_timer));
+
+    if (timer) rt_timer_init(timer, name, timeout, parameter, time, flag);
+    return timer;
+}
+
+rt_err_t rt_timer_delete(rt_timer_t timer) {
+    rt_timer_stop(timer);
+    rt_free(timer);
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_start(rt_timer_t timer) {
+    rt_list_remove(&timer->row);
+    timer->timeout_tick = _now() + (timer->init_tick ? timer->init_tick : 1);
+    timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
+    rt_list_insert_before(&_timers, &timer->row);
+    _update_deadline(timer->timeout_tick);
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_stop(rt_timer_t timer) {
+    if (!(timer->parent.flag & RT_TIMER_FLAG_ACTIVATED)) return -RT_ERROR;
+    rt_list_remove(&timer->row);
+    timer->parent.flag &= ~RT_TIMER_FLAG_ACTIVATED;
+    return RT_EOK;
+}
+
+rt_err_t rt_timer_control(rt_timer_t timer, int cmd, void *arg) {
+    switch (cmd) {
+    case RT_TIMER_CTRL_SET_TIME:
+        timer->init_tick = *(rt_tick_t *)arg;
+        break;
+    case RT_TIMER_CTRL_GET_TIME:
+        *(rt_tick_t *)arg = timer->init_tick;
+        break;
+    case RT_TIMER_CTRL_SET_ONESHOT:
+        timer->parent.flag &= ~RT_TIMER_FLAG_PERIODIC;
+        break;
+    case RT_TIMER_CTRL_SET_PERIODIC:
+        timer->parent.flag |= RT_TIMER_FLAG_PERIODIC;
+        break;
+    default:
+        return -RT_ERROR;
+    }
+    return RT_EOK;
+}
+
+/* mutex, recursive and without priority inheritance */
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag) {
+    _object_init(&mutex->parent.parent, name);
+    mutex->parent.parent.flag = flag;
+    rt_list_init(&mutex->parent.suspend_thread);
+    mutex->value = 1;
+    mutex->hold = 0;
+    mutex->owner = RT_NULL;
+    mutex->original_priority = 0xff;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_detach(rt_mutex_t mutex) {
+    _resume_all(&mutex->parent.suspend_thread, -RT_ERROR);
+    return RT_EOK;
+}
+
+rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag) {
+    rt_mutex_t mutex = rt_malloc(sizeof(struct rt_mutex));
+
+    if (mutex) rt_mutex_init(mutex, name, flag);
+    return mutex;
+}
+
+rt_err_t rt_mutex_delete(rt_mutex_t mutex) {
+    rt_mutex_detach(mutex);
+    rt_free(mutex);
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time) {
+    rt_tick_t start = _now();
+    rt_err_t ret;
+
+    _check_point();
+    RT_ASSERT(!_in_isr);
+    if (mutex->owner == _current) {
+        mutex->hold++;
+        return RT_EOK;
+    }
+    while (mutex->owner) {
+        if (!time) return -RT_ETIMEOUT;
+        ret = _suspend(&mutex->parent.suspend_thread, time);
+        if (RT_EOK != ret) return ret;
+        /* handed over by the owner */
+        if (mutex->owner == _current) return RT_EOK;
+        time = _time_left(time, start);
+    }
+    mutex->owner = _current;
+    mutex->value = 0;
+    mutex->hold = 1;
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex) {
+    rt_list_t *list = &mutex->parent.suspend_thread;
+
+    if (mutex->owner != _current) return -RT_ERROR;
+    if (--mutex->hold) return RT_EOK;
+
+    if (!rt_list_isempty(list)) {
+        rt_thread_t thread = rt_list_entry(list->next, struct rt_thread,
+            tlist);
+
+        _resume(thread);
+        mutex->owner = thread;
+        mutex->hold = 1;
+    } else {
+        mutex->owner = RT_NULL;
+        mutex->value = 1;
+    }
+    _check_point();
+    return RT_EOK;
+}
+
+/* mailbox */
+rt_err_t rt_mb_init(rt_mailbox_t mb, const char *name, void *msgpool,
+    rt_size_t size, rt_uint8_t flag) {
+    _object_init(&mb->parent.parent, name);
+    mb->parent.parent.flag = flag;
+    rt_list_init(&mb->parent.suspend_thread);
+    rt_list_init(&mb->suspend_sender_thread);
+    mb->msg_pool = msgpool;
+    mb->size = (rt_uint16_t)size;
+    mb->entry = 0;
+    mb->in_offset = 0;
+    mb->out_offset = 0;
+    return RT_EOK;
+}
+
+rt_err_t rt_mb_detach(rt_mailbox_t mb) {
+    _resume_all(&mb->parent.suspend_thread, -RT_ERROR);
+    _resume_all(&mb->suspend_sender_thread, -RT_ERROR);
+    return RT_EOK;
+}
+
+rt_mailbox_t rt_mb_create(const char *name, rt_size_t size, rt_uint8_t flag) {
+    rt_mailbox_t mb = rt_malloc(sizeof(struct rt_mailbox));
+
+    if (!mb) return RT_NULL;
+    rt_mb_init(mb, name, rt_malloc(size * sizeof(rt_ubase_t)), size, flag);
+    if (!mb->msg_pool) {
+        rt_free(mb);
+        return RT_NULL;
+    }
+    return mb;
+}
+
+rt_err_t rt_mb_delete(rt_mailbox_t mb) {
+    rt_mb_detach(mb);
+    rt_free(mb->msg_pool);
+    rt_free(mb);
+    return RT_EOK;
+}
+
+rt_err_t rt_mb_send_wait(rt_mailbox_t mb, rt_ubase_t value,
+    rt_int32_t timeout) {
+    rt_tick_t start = _now();
+    rt_err_t ret;
+
+    _check_point();
+    while (mb->entry == mb->size) {
+        if (!timeout || _in_isr) return -RT_EFULL;
+        ret = _suspend(&mb->suspend_sender_thread, timeout);
+        if (RT_EOK != ret) return ret;
+        timeout = _time_left(timeout, start);
+    }
+
+    mb->msg_pool[mb->in_offset] = value;
+    if (++mb->in_offset >= mb->size) mb->in_offset = 0;
+    mb->entry++;
+    _resume_first(&mb->parent.suspend_thread);
+    _check_point();
+    return RT_EOK;
+}
+
+rt_err_t rt_mb_send(rt_mailbox_t mb, rt_ubase_t value) {
+    return rt_mb_send_wait(mb, value, 0);
+}
+
+rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout) {
+    rt_tick_t start = _now();
+    rt_err_t ret;
+
+    _check_point();
+    while (!mb->entry) {
+        if (!timeout || _in_isr) return -RT_ETIMEOUT;
+        ret = _suspend(&mb->parent.suspend_thread, timeout);
+        if (RT_EOK != ret) return ret;
+        timeout = _time_left(timeout, start);
+    }
+
+    *value = mb->msg_pool[mb->out_offset];
+    if (++mb->out_offset >= mb->size) mb->out_offset = 0;
+    mb->entry--;
+    _resume_first(&mb->suspend_sender_thread);
+    _check_point();
+    return RT_EOK;
+}
+
+/* memory pool, each block is after a pointer to its pool */
+rt_mp_t rt_mp_create(const char *name, rt_size_t block_count,
+    rt_size_t block_size) {
+    rt_mp_t mp = rt_malloc(sizeof(struct rt_mempool));
+    rt_size_t i, step;
+    rt_uint8_t *block;
+
+    if (!mp) return RT_NULL;
+    _object_init(&mp->parent, name);
+    rt_list_init(&mp->suspend_thread);
+    mp->block_size = (block_size + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    step = mp->block_size + sizeof(void *);
+    mp->size = step * block_count;
+    mp->start_address = rt_malloc(mp->size);
+    if (!mp->start_address) {
+        rt_free(mp);
+        return RT_NULL;
+    }
+    mp->block_total_count = mp->block_free_count = block_count;
+
+    /* the header of a free block links to the next free block */
+    mp->block_list = RT_NULL;
+    for (i = block_count; i > 0; i--) {
+        block = (rt_uint8_t *)mp->start_address + (i - 1) * step;
+        *(rt_uint8_t **)block = mp->block_list;
+        mp->block_list = block;
+    }
+    return mp;
+}
+
+rt_err_t rt_mp_delete(rt_mp_t mp) {
+    _resume_all(&mp->suspend_thread, -RT_ERROR);
+    rt_free(mp->start_address);
+    rt_free(mp);
+    return RT_EOK;
+}
+
+void *rt_mp_alloc(rt_mp_t mp, rt_int32_t time) {
+    rt_tick_t start = _now();
+    rt_uint8_t *block;
+
+    _check_point();
+    while (!mp->block_free_count) {
+        if (!time || _in_isr) return RT_NULL;
+        if (RT_EOK != _suspend(&mp->suspend_thread, time)) return RT_NULL;
+        time = _time_left(time, start);
+    }
+
+    block = mp->block_list;
+    mp->block_list = *(rt_uint8_t **)block;
+    mp->block_free_count--;
+    *(rt_mp_t *)block = mp;
+    return block + sizeof(void *);
+}
+
+void rt_mp_free(void *block) {
+    rt_uint8_t *header = (rt_uint8_t *)block - sizeof(void *);
+    rt_mp_t mp = *(rt_mp_t *)header;
+
+    *(rt_uint8_t **)header = mp->block_list;
+    mp->block_list = header;
+    mp->block_free_count++;
+    _resume_first(&mp->suspend_thread);
+    _check_point();
+}
+
+/* heap */
+void *rt_malloc(rt_size_t size) {
+    return malloc(size);
+}
+
+void rt_free(void *ptr) {
+    free(ptr);
+}
+
+void *rt_realloc(void *ptr, rt_size_t newsize) {
+    return realloc(ptr, newsize);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size) {
+    return calloc(count, size);
+}
+
+/* device */
+#ifdef RT_USING_DEVICE_OPS
+# define DEV_OPS(dev, op)           ((dev)->ops ? (dev)->ops->op : RT_NULL)
+#else
+# define DEV_OPS(dev, op)           ((dev)->op)
+#endif
+
+rt_device_t rt_device_find(const char *name) {
+    rt_list_t *node;
+
+    rt_list_for_each(node, &_devices) {
+        rt_device_t dev = rt_list_entry(node, struct rt_device, parent.list);
+
+        if (!rt_strncmp(dev->parent.name, name, RT_NAME_MAX)) return dev;
+    }
+    return RT_NULL;
+}
+
+rt_err_t rt_device_register(rt_device_t dev, const char *name,
+    rt_uint16_t flags) {
+    if (rt_device_find(name)) return -RT_ERROR;
+    _object_init(&dev->parent, name);
+    dev->flag = flags;
+    dev->ref_count = 0;
+    dev->open_flag = 0;
+    rt_list_insert_before(&_devices, &dev->parent.list);
+    return RT_EOK;
+}
+
+rt_err_t rt_device_unregister(rt_device_t dev) {
+    rt_list_remove(&dev->parent.list);
+    return RT_EOK;
+}
+
+rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag) {
+    rt_err_t ret = RT_EOK;
+
+    _check_point();
+    if (!dev->ref_count && DEV_OPS(dev, init)) {
+        ret = DEV_OPS(dev, init)(dev);
+        if (RT_EOK != ret) return ret;
+    }
+    if (!dev->ref_count && DEV_OPS(dev, open))
+        ret = DEV_OPS(dev, open)(dev, oflag);
+    if (RT_EOK == ret) {
+        dev->open_flag = oflag;
+        dev->ref_count++;
+    }
+    return ret;
+}
+
+rt_err_t rt_device_close(rt_device_t dev) {
+    if (!dev->ref_count) return -RT_ERROR;
+    if (!--dev->ref_count && DEV_OPS(dev, close))
+        return DEV_OPS(dev, close)(dev);
+    return RT_EOK;
+}
+
+rt_size_t rt_device_read(rt_device_t dev, rt_off_t pos, void *buffer,
+    rt_size_t size) {
+    _check_point();
+    if (DEV_OPS(dev, read)) return DEV_OPS(dev, read)(dev, pos, buffer, size);
+    return 0;
+}
+
+rt_size_t rt_device_write(rt_device_t dev, rt_off_t pos, const void *buffer,
+    rt_size_t size) {
+    _check_point();
+    if (DEV_OPS(dev, write))
+        return DEV_OPS(dev, write)(dev, pos, buffer, size);
+    return 0;
+}
+
+rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg) {
+    _check_point();
+    if (DEV_OPS(dev, control)) return DEV_OPS(dev, control)(dev, cmd, arg);
+    return -RT_ENOSYS;
+}
+
+/* console and string */
+void rt_kprintf(const char *fmt, ...) {
+    va_list args;
+
+    _check_point();
+    va_start(args, fmt);
+    vfprintf(stdout, fmt, args);
+    va_end(args);
+}
+
+rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt,
+    va_list args) {
+    return vsnprintf(buf, size, fmt, args);
+}
+
+rt_int32_t rt_snprintf(char *buf, rt_size_t size, const char *fmt, ...) {
+    va_list args;
+    rt_int32_t ret;
+
+    va_start(args, fmt);
+    ret = vsnprintf(buf, size, fmt, args);
+    va_end(args);
+    return ret;
+}
+
+rt_int32_t rt_sprintf(char *buf, const char *format, ...) {
+    va_list args;
+    rt_int32_t ret;
+
+    va_start(args, format);
+    ret = vsprintf(buf, format, args);
+    va_end(args);
+    return ret;
+}
+
+void *rt_memset(void *src, int c, rt_ubase_t n) {
+    return memset(src, c, n);
+}
+
+void *rt_memcpy(void *dest, const void *src, rt_ubase_t n) {
+    return memcpy(dest, src, n);
+}
+
+void *rt_memmove(void *dest, const void *src, rt_ubase_t n) {
+    return memmove(dest, src, n);
+}
+
+rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count) {
+    return memcmp(cs, ct, count);
+}
+
+char *rt_strstr(const char *str1, const char *str2) {
+    return strstr(str1, str2);
+}
+
+rt_int32_t rt_strcasecmp(const char *a, const char *b) {
+    return strcasecmp(a, b);
+}
+
+char *rt_strncpy(char *dest, const char *src, rt_ubase_t n) {
+    return strncpy(dest, src, n);
+}
+
+rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count) {
+    return strncmp(cs, ct, count);
+}
+
+rt_int32_t rt_strcmp(const char *cs, const char *ct) {
+    return strcmp(cs, ct);
+}
+
+rt_size_t rt_strlen(const char *src) {
+    return strlen(src);
+}
+
+char *rt_strdup(const char *s) {
+    rt_size_t len = strlen(s) + 1;
+    char *tmp = rt_malloc(len);
+
+    if (tmp) rt_memcpy(tmp, s, len);
+    return tmp;
+}
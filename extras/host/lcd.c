@@ -0,0 +1,367 @@
+/***************************************************************************//**
+ * @file    lcd.c
+ * @brief   LCD panel and PPM frame sink of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "include/rtgui.h"
+#include "host.h"
+
+/* Private define ------------------------------------------------------------*/
+/* size of "ILI9341", or "SSD1306" for MONO */
+#ifndef HOST_LCD_WIDTH
+# if (CONFIG_USING_MONO)
+#  define HOST_LCD_WIDTH            (128)
+# else
+#  define HOST_LCD_WIDTH            (240)
+# endif
+#endif
+#ifndef HOST_LCD_HEIGHT
+# if (CONFIG_USING_MONO)
+#  define HOST_LCD_HEIGHT           (64)
+# else
+#  define HOST_LCD_HEIGHT           (320)
+# endif
+#endif
+
+/* the same panel as "CONFIG_GUI_DEVICE_NAME", with the framebuffer only if
+   "RTGUI_USING_FRAMEBUFFER" */
+#if (CONFIG_USING_MONO)
+# define LCD_FORMAT                 RTGRAPHIC_PIXEL_FORMAT_MONO
+# define LCD_BITS                   (1)
+# define LCD_SIZE                   \
+    (HOST_LCD_WIDTH * ((HOST_LCD_HEIGHT + 7) >> 3))
+#elif (CONFIG_USING_RGB565)
+# define LCD_FORMAT                 RTGRAPHIC_PIXEL_FORMAT_RGB565
+# define LCD_BITS                   (16)
+#elif (CONFIG_USING_RGB888)
+# define LCD_FORMAT                 RTGRAPHIC_PIXEL_FORMAT_RGB888
+# define LCD_BITS                   (RTGUI_RGB888_PIXEL_BITS)
+#else
+# error "Unsupported color format for host LCD"
+#endif
+#define LCD_BPP                     (LCD_BITS >> 3)
+#define LCD_PITCH                   (HOST_LCD_WIDTH * LCD_BPP)
+#ifndef LCD_SIZE
+# define LCD_SIZE                   (LCD_PITCH * HOST_LCD_HEIGHT)
+#endif
+
+#define PIXEL(x, y)                 (_lcd.buffer + LCD_PITCH * (y) + \
+                                     LCD_BPP * (x))
+#define CLIP_X(x)                   \
+    (((x) < 0) ? 0 : (((x) > HOST_LCD_WIDTH) ? HOST_LCD_WIDTH : (x)))
+#define CLIP_Y(y)                   \
+    (((y) < 0) ? 0 : (((y) > HOST_LCD_HEIGHT) ? HOST_LCD_HEIGHT : (y)))
+#define IS_OUTSIDE(x, y)            (((x) < 0) || ((y) < 0) || \
+                                     ((x) >= HOST_LCD_WIDTH) || \
+                                     ((y) >= HOST_LCD_HEIGHT))
+#define FRAME_PATH_MAX              (256)
+
+/* Private variables ---------------------------------------------------------*/
+static struct host_lcd {
+    struct rt_device parent;
+    rt_uint8_t buffer[LCD_SIZE];
+    rt_uint32_t update_count;
+    const char *frame_dir;
+    rt_uint32_t frame_interval;
+    rt_uint32_t frame_count;
+    rt_tick_t frame_tick;
+} _lcd;
+
+/* Private functions ---------------------------------------------------------*/
+/* the pixel operations take native pixel and x2 / y2 are exclusive, like the
+   ones in "memfb.c" */
+#if (LCD_BITS == 1)
+#define PAGE(x, y)                  (&_lcd.buffer[((y) >> 3) * \
+                                     HOST_LCD_WIDTH + (x)])
+
+static void _lcd_set_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) return;
+    if (*c)
+        *PAGE(x, y) |=  (1 << (y & 0x07));
+    else
+        *PAGE(x, y) &= ~(1 << (y & 0x07));
+}
+
+static void _lcd_get_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) {
+        *c = 0;
+        return;
+    }
+    *c = (*PAGE(x, y) & (1 << (y & 0x07))) ? 1 : 0;
+}
+
+static void _lcd_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    int x;
+
+    x2 = CLIP_X(x2);
+    for (x = CLIP_X(x1); x < x2; x++)
+        _lcd_set_pixel(c, x, y);
+}
+
+static void _lcd_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    int y;
+
+    y2 = CLIP_Y(y2);
+    for (y = CLIP_Y(y1); y < y2; y++)
+        _lcd_set_pixel(c, x, y);
+}
+
+static void _lcd_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    rtgui_color_t pixel;
+    int i;
+
+    for (i = 0; i < (x2 - x1); i++) {
+        pixel = (pixels[i >> 3] & (1 << (i & 0x07))) ? 1 : 0;
+        _lcd_set_pixel(&pixel, x1 + i, y);
+    }
+}
+
+#undef PAGE
+
+#else /* LCD_BITS == 1 */
+
+rt_inline void _lcd_put(rt_uint8_t *ptr, rtgui_color_t pixel) {
+    #if (LCD_BITS == 16)
+        *(rt_uint16_t *)ptr = (rt_uint16_t)pixel;
+    #elif (LCD_BITS == 32)
+        *(rtgui_color_t *)ptr = pixel;
+    #else
+        ptr[0] = (pixel >> 16) & 0xff;
+        ptr[1] = (pixel >> 8) & 0xff;
+        ptr[2] = pixel & 0xff;
+    #endif
+}
+
+static void _lcd_set_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) return;
+    _lcd_put(PIXEL(x, y), *c);
+}
+
+/* rtgui color for RGB565 as "_rgb565_get_pixel()" expects, native else */
+static void _lcd_get_pixel(rtgui_color_t *c, int x, int y) {
+    rt_uint8_t *ptr;
+
+    if (IS_OUTSIDE(x, y)) {
+        *c = 0;
+        return;
+    }
+    ptr = PIXEL(x, y);
+
+    #if (LCD_BITS == 16)
+    {
+        rt_uint16_t pixel = *(rt_uint16_t *)ptr;
+
+        #ifdef RTGUI_BIG_ENDIAN_OUTPUT
+            pixel = (pixel << 8) | (pixel >> 8);
+        #endif
+        *c = rtgui_color_from_565(pixel);
+    }
+    #elif (LCD_BITS == 32)
+        *c = *(rtgui_color_t *)ptr;
+    #else
+        *c = (ptr[0] << 16) | (ptr[1] << 8) | ptr[2];
+    #endif
+}
+
+static void _lcd_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    rt_uint8_t *ptr;
+    int x;
+
+    if ((y < 0) || (y >= HOST_LCD_HEIGHT)) return;
+    x1 = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    ptr = PIXEL(x1, y);
+    for (x = x1; x < x2; x++, ptr += LCD_BPP)
+        _lcd_put(ptr, *c);
+}
+
+static void _lcd_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    rt_uint8_t *ptr;
+    int y;
+
+    if ((x < 0) || (x >= HOST_LCD_WIDTH)) return;
+    y1 = CLIP_Y(y1);
+    y2 = CLIP_Y(y2);
+    ptr = PIXEL(x, y1);
+    for (y = y1; y < y2; y++, ptr += LCD_PITCH)
+        _lcd_put(ptr, *c);
+}
+
+static void _lcd_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    int x;
+
+    if ((y < 0) || (y >= HOST_LCD_HEIGHT)) return;
+    x = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    if (x2 <= x) return;
+    rt_memcpy(PIXEL(x, y), pixels + (x - x1) * LCD_BPP, (x2 - x) * LCD_BPP);
+}
+
+/* set window once and burst, as the panel drivers do */
+static void _lcd_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    y2 = CLIP_Y(y2);
+    for (y1 = CLIP_Y(y1); y1 < y2; y1++)
+        _lcd_draw_hline(c, x1, x2, y1);
+}
+
+#ifdef RTGUI_USING_EXT_OPS
+static void _lcd_blit_rect(rt_uint8_t *pixels, rt_uint32_t pitch, int x1,
+    int y1, int x2, int y2) {
+    for (; y1 < y2; y1++, pixels += pitch)
+        _lcd_draw_raw_hline(pixels, x1, x2, y1);
+}
+
+static void _lcd_move_rect(int x1, int y1, int x2, int y2, int dx, int dy) {
+    rt_int32_t pitch = LCD_PITCH;
+    rt_uint32_t len;
+    rt_uint8_t *src;
+    int y;
+
+    x1 = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    y1 = CLIP_Y(y1);
+    y2 = CLIP_Y(y2);
+    if ((x1 >= x2) || (y1 >= y2)) return;
+    len = (x2 - x1) * LCD_BPP;
+    src = PIXEL(x1, y1);
+    if (dy > 0) {
+        src += LCD_PITCH * (y2 - y1 - 1);
+        pitch = -pitch;
+    }
+    for (y = y1; y < y2; y++, src += pitch)
+        rt_memmove(src + LCD_PITCH * dy + LCD_BPP * dx, src, len);
+}
+#endif
+
+static const struct rtgui_graphic_ext_ops _lcd_ext_ops = {
+    .fill_rect = _lcd_fill_rect,
+    #ifdef RTGUI_USING_EXT_OPS
+        .blit_rect = _lcd_blit_rect,
+        .move_rect = _lcd_move_rect,
+    #endif
+};
+
+#endif /* LCD_BITS == 1 */
+
+static const struct rtgui_graphic_driver_ops _lcd_ops = {
+    _lcd_set_pixel,
+    _lcd_get_pixel,
+    _lcd_draw_hline,
+    _lcd_draw_vline,
+    _lcd_draw_raw_hline,
+};
+
+static rt_err_t _lcd_control(rt_device_t dev, int cmd, void *args) {
+    (void)dev;
+
+    switch (cmd) {
+    case RTGRAPHIC_CTRL_GET_INFO:
+    {
+        struct rt_device_graphic_info *info = args;
+
+        info->pixel_format = LCD_FORMAT;
+        info->bits_per_pixel = LCD_BITS;
+        info->width = HOST_LCD_WIDTH;
+        info->height = HOST_LCD_HEIGHT;
+        #ifdef RTGUI_USING_FRAMEBUFFER
+            info->framebuffer = _lcd.buffer;
+        #else
+            info->framebuffer = RT_NULL;
+        #endif
+        break;
+    }
+
+    case RTGRAPHIC_CTRL_RECT_UPDATE:
+        _lcd.update_count++;
+        if (_lcd.frame_dir && (!_lcd.frame_count || \
+            ((rt_tick_get() - _lcd.frame_tick) >= _lcd.frame_interval))) {
+            char name[FRAME_PATH_MAX];
+
+            rt_snprintf(name, sizeof(name), "%s/%05d.ppm", _lcd.frame_dir,
+                _lcd.frame_count++);
+            (void)host_lcd_save(name);
+            _lcd.frame_tick = rt_tick_get();
+        }
+        break;
+
+    #if (LCD_BITS != 1)
+    case RTGRAPHIC_CTRL_GET_EXT:
+        *(const struct rtgui_graphic_ext_ops **)args = &_lcd_ext_ops;
+        break;
+    #endif
+
+    case RTGRAPHIC_CTRL_POWERON:
+    case RTGRAPHIC_CTRL_POWEROFF:
+        break;
+
+    default:
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops _lcd_dev_ops = {
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _lcd_control,
+};
+#endif
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t host_lcd_init(void) {
+    rt_device_t dev = &_lcd.parent;
+
+    dev->type = RT_Device_Class_Graphic;
+    #ifdef RT_USING_DEVICE_OPS
+        dev->ops = &_lcd_dev_ops;
+    #else
+        dev->control = _lcd_control;
+    #endif
+    dev->user_data = (void *)&_lcd_ops;
+
+    return rt_device_register(dev, CONFIG_GUI_DEVICE_NAME, RT_DEVICE_FLAG_RDWR);
+}
+
+void host_lcd_set_frames(const char *dir, rt_uint32_t interval_ms) {
+    _lcd.frame_dir = dir;
+    _lcd.frame_interval = rt_tick_from_millisecond(interval_ms);
+}
+
+/* save the screen of the GUI device (this panel or e.g. "MEMFB") */
+rt_err_t host_lcd_save(const char *name) {
+    const struct rtgui_graphic_driver_ops *ops;
+    struct rt_device_graphic_info info;
+    rtgui_color_t c;
+    rt_device_t dev;
+    FILE *file;
+    int x, y;
+
+    dev = rt_device_find(CONFIG_GUI_DEVICE_NAME);
+    if (!dev || (RT_EOK != rt_device_control(dev, RTGRAPHIC_CTRL_GET_INFO,
+        &info)))
+        return -RT_ERROR;
+    ops = dev->user_data;
+
+    file = fopen(name, "wb");
+    if (!file) return -RT_EIO;
+    fprintf(file, "P6\n%d %d\n255\n", info.width, info.height);
+    for (y = 0; y < info.height; y++) {
+        for (x = 0; x < info.width; x++) {
+            ops->get_pixel(&c, x, y);
+            if (1 == info.bits_per_pixel) c = c ? 0xffffff : 0;
+            fputc(RTGUI_RGB_R(c), file);
+            fputc(RTGUI_RGB_G(c), file);
+            fputc(RTGUI_RGB_B(c), file);
+        }
+    }
+    fclose(file);
+    return RT_EOK;
+}
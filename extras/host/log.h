@@ -0,0 +1,7 @@
+/***************************************************************************//**
+ * @file    log.h
+ * @brief   Arduino RT-Thread log header of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* define "LOG_LVL" and "LOG_TAG" before including this file */
+#include "components/utilities/ulog/ulog.h"
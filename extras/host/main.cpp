@@ -0,0 +1,145 @@
+/***************************************************************************//**
+ * @file    main.cpp
+ * @brief   Arduino RT-Thread entry of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* Run a sketch natively, e.g. "_host/Demo -o demo.ppm -p 120,160@500".
+    -o <file>       save the last frame (PPM) at exit
+    -f <dir>[@ms]   save a frame (PPM) per screen update, at most one per "ms"
+    -p <x>,<y>@<ms> tap the touch panel "ms" after start, repeatable
+    -i <ms>         exit after "ms" idle (default 1000, 0 to disable)
+    -t <ms>         exit after "ms" in total (default 0 to disable)
+    -r <dir>        root of the absolute paths (default "bin") */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rtt.h>
+#include <rttgui.h>
+
+extern "C" {
+    #include "host.h"
+}
+
+/* Private define ------------------------------------------------------------*/
+#define TAP_NUM_MAX                 (32)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct host_tap_arg {
+    int x, y;
+    rt_uint32_t ms;
+} host_tap_arg_t;
+
+/* Private variables ---------------------------------------------------------*/
+static const char *_output = RT_NULL;
+static host_tap_arg_t _taps[TAP_NUM_MAX];
+static rt_uint32_t _tap_num = 0;
+static struct timespec _start;
+
+/* Private functions ---------------------------------------------------------*/
+static void _save_output(void) {
+    if (!_output) return;
+    if (RT_EOK != host_lcd_save(_output))
+        fprintf(stderr, "Failed to save \"%s\"\n", _output);
+}
+
+/* the Arduino "main" thread */
+static void _arduino_entry(void *param) {
+    rt_uint32_t i;
+    rt_err_t ret;
+
+    (void)param;
+    ret = host_lcd_init();
+    RT_ASSERT(RT_EOK == ret);
+    ret = host_touch_init();
+    RT_ASSERT(RT_EOK == ret);
+    RTT_GUI.begin();
+    rt_setup();
+    for (i = 0; i < _tap_num; i++)
+        (void)host_touch_add(_taps[i].x, _taps[i].y, _taps[i].ms);
+    (void)ret;
+
+    for ( ; ; ) {
+        loop();
+        /* an empty loop() is not counted as busy */
+        host_thread_set_background(RT_TRUE);
+        rt_thread_delay(1);
+        host_thread_set_background(RT_FALSE);
+    }
+}
+
+static void _usage(const char *name) {
+    fprintf(stderr, "Usage: %s [-o file.ppm] [-f dir[@ms]] [-p x,y@ms]... "
+        "[-i idle_ms] [-t run_ms] [-r root]\n", name);
+    exit(1);
+}
+
+/* Public functions ----------------------------------------------------------*/
+unsigned long millis(void) {
+    return micros() / 1000;
+}
+
+unsigned long micros(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)((ts.tv_sec - _start.tv_sec) * 1000000L + \
+        (ts.tv_nsec - _start.tv_nsec) / 1000);
+}
+
+void delay(unsigned long ms) {
+    rt_thread_mdelay(ms);
+}
+
+void RT_Thread::begin(void) {
+    host_kernel_start(_arduino_entry, RT_NULL);
+}
+
+RT_Thread RT_T;
+
+int main(int argc, char *argv[]) {
+    rt_uint32_t idle_ms = 1000, run_ms = 0, interval;
+    char *at;
+    int opt;
+
+    clock_gettime(CLOCK_MONOTONIC, &_start);
+    while (-1 != (opt = getopt(argc, argv, "o:f:p:i:t:r:"))) {
+        switch (opt) {
+        case 'o':
+            _output = optarg;
+            break;
+        case 'f':
+            interval = 0;
+            at = strchr(optarg, '@');
+            if (at) {
+                *at = '\0';
+                interval = strtoul(at + 1, RT_NULL, 0);
+            }
+            host_lcd_set_frames(optarg, interval);
+            break;
+        case 'p':
+            if (_tap_num >= TAP_NUM_MAX) _usage(argv[0]);
+            if (3 != sscanf(optarg, "%d,%d@%u", &_taps[_tap_num].x,
+                &_taps[_tap_num].y, &_taps[_tap_num].ms))
+                _usage(argv[0]);
+            _tap_num++;
+            break;
+        case 'i':
+            idle_ms = strtoul(optarg, RT_NULL, 0);
+            break;
+        case 't':
+            run_ms = strtoul(optarg, RT_NULL, 0);
+            break;
+        case 'r':
+            host_dfs_set_root(optarg);
+            break;
+        default:
+            _usage(argv[0]);
+        }
+    }
+    host_kernel_set_exit(idle_ms, run_ms, _save_output);
+
+    setup();
+    return 0;
+}
@@ -0,0 +1,17 @@
+/***************************************************************************//**
+ * @file    rtconfig.h
+ * @brief   RT-Thread configuration of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __RTCONFIG_H__
+#define __RTCONFIG_H__
+
+#define RT_NAME_MAX                 (8)
+#define RT_ALIGN_SIZE               (4)
+#define RT_THREAD_PRIORITY_MAX      (32)
+#define RT_TICK_PER_SECOND          (1000)
+
+#define RT_USING_ULOG
+#define RT_USING_DFS
+
+#endif /* __RTCONFIG_H__ */
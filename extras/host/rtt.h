@@ -0,0 +1,27 @@
+/***************************************************************************//**
+ * @file    rtt.h
+ * @brief   Arduino RT-Thread library header of the host (Linux) port
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+#ifndef __RTT_H__
+#define __RTT_H__
+
+#include <Arduino.h>
+
+extern "C" {
+    #include "include/rtthread.h"
+    #include "include/rthw.h"
+}
+
+class RT_Thread {
+ public:
+    /* start the kernel, never return */
+    void begin(void);
+};
+
+extern RT_Thread RT_T;
+
+/* called by "RT_T.begin()" */
+void rt_setup(void);
+
+#endif /* __RTT_H__ */
@@ -0,0 +1,127 @@
+/***************************************************************************//**
+ * @file    touch.c
+ * @brief   Touch panel of the host (Linux) port, taps scripted by timer
+ * @author  onelife <onelife.real[at]gmail.com>
+ ******************************************************************************/
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+#include "host.h"
+
+#ifdef CONFIG_TOUCH_DEVICE_NAME
+
+/* Private define ------------------------------------------------------------*/
+#define TAP_HOLD_MS                 (50)
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct host_tap {
+    struct rt_timer timer;
+    rtgui_touch_t data;
+} host_tap_t;
+
+/* Private variables ---------------------------------------------------------*/
+static struct rt_device _touch;
+static rtgui_touch_t _data;
+static void (*_indicator)(void);
+
+/* Private functions ---------------------------------------------------------*/
+/* "buffer" gets the pointer of touch data, returns 1 while touched */
+static rt_size_t _touch_read(rt_device_t dev, rt_off_t pos, void *buffer,
+    rt_size_t size) {
+    (void)dev;
+    (void)pos;
+    (void)size;
+
+    *(rtgui_touch_t **)buffer = &_data;
+    return (RTGUI_TOUCH_DOWN == _data.type) ? 1 : 0;
+}
+
+static rt_err_t _touch_control(rt_device_t dev, int cmd, void *args) {
+    (void)dev;
+
+    switch (cmd) {
+    case RT_DEVICE_CTRL_SET_RX_INDICATOR:
+        _indicator = (void (*)(void))args;
+        break;
+
+    default:
+        return -RT_ERROR;
+    }
+
+    return RT_EOK;
+}
+
+/* called by tick as the touch interrupt */
+static void _touch_event(void *param) {
+    host_tap_t *tap = param;
+
+    _data = tap->data;
+    if (_indicator) _indicator();
+    if (RTGUI_TOUCH_UP == tap->data.type) {
+        rt_timer_detach(&tap->timer);
+        rt_free(tap);
+        return;
+    }
+    /* lift after hold */
+    tap->data.type = RTGUI_TOUCH_UP;
+    rt_timer_control(&tap->timer, RT_TIMER_CTRL_SET_TIME,
+        &(rt_tick_t){ rt_tick_from_millisecond(TAP_HOLD_MS) });
+    rt_timer_start(&tap->timer);
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops _touch_ops = {
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    _touch_read,
+    RT_NULL,
+    _touch_control,
+};
+#endif
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t host_touch_init(void) {
+    rt_device_t dev = &_touch;
+
+    _data.type = RTGUI_TOUCH_NONE;
+    dev->type = RT_Device_Class_Touch;
+    #ifdef RT_USING_DEVICE_OPS
+        dev->ops = &_touch_ops;
+    #else
+        dev->read = _touch_read;
+        dev->control = _touch_control;
+    #endif
+
+    return rt_device_register(dev, CONFIG_TOUCH_DEVICE_NAME,
+        RT_DEVICE_FLAG_RDONLY | RT_DEVICE_FLAG_INT_RX);
+}
+
+/* tap at (x, y) "ms" after start */
+rt_err_t host_touch_add(int x, int y, rt_uint32_t ms) {
+    host_tap_t *tap;
+
+    tap = rt_malloc(sizeof(host_tap_t));
+    if (!tap) return -RT_ENOMEM;
+    tap->data.id = 0;
+    tap->data.type = RTGUI_TOUCH_DOWN;
+    tap->data.point.x = x;
+    tap->data.point.y = y;
+    rt_timer_init(&tap->timer, "tap", _touch_event, tap,
+        rt_tick_from_millisecond(ms ? ms : 1), RT_TIMER_FLAG_ONE_SHOT);
+    return rt_timer_start(&tap->timer);
+}
+
+#else /* CONFIG_TOUCH_DEVICE_NAME */
+
+rt_err_t host_touch_init(void) {
+    return RT_EOK;
+}
+
+rt_err_t host_touch_add(int x, int y, rt_uint32_t ms) {
+    (void)x;
+    (void)y;
+    (void)ms;
+    return -RT_ENOSYS;
+}
+
+#endif /* CONFIG_TOUCH_DEVICE_NAME */
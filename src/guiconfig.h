@@ -44,6 +44,7 @@
 // #define CONFIG_GUI_DEVICE_NAME              "SSD1331"   // RGB565
 // #define CONFIG_KEY_DEVICE_NAME              "BTN"
 // #define CONFIG_GUI_DEVICE_NAME              "SSD1306"   // MONO
+// #define CONFIG_GUI_DEVICE_NAME              "MEMFB"     // CONFIG_USING_MEM_FB
 
 /* Color */
 #define CONFIG_USING_MONO                   (0)
@@ -51,6 +52,12 @@
 #define CONFIG_USING_RGB565P                (0)
 #define CONFIG_USING_RGB888                 (0)
 
+/* Memory Framebuffer (headless display, e.g. for benchmarking) */
+#define CONFIG_USING_MEM_FB                 (0)
+#define CONFIG_MEM_FB_WIDTH                 (240)
+#define CONFIG_MEM_FB_HEIGHT                (320)
+#define CONFIG_MEM_FB_BITS_PER_PIXEL        (16)        // 1: MONO, 16: RGB565, 24: RGB888
+
 /* Image Decoder */
 #define CONFIG_USING_IMAGE_XPM              (1)
 #define CONFIG_USING_IMAGE_BMP              (1)
@@ -62,6 +69,15 @@
 #define CONFIG_USING_FONT_16                (1)
 #define CONFIG_USING_FONT_HZ                (0)
 #define CONFIG_USING_FONT_FILE              (1)
+#define CONFIG_FONT_LOAD_MAX                (8 * 1024)  // load smaller font file into RAM
+#define CONFIG_FONT_PAGE_SIZE               (512)       // page cache for larger font file
+#define CONFIG_FONT_PAGE_NUM                (8)         // min 1
+#define CONFIG_FONT_READ_AHEAD              (2)         // pages read per miss
+/* font file address (e.g. in XIP flash) to use it in place, 0 to open file */
+#define CONFIG_FONT_ASC12_MAP               (0)
+#define CONFIG_FONT_ASC16_MAP               (0)
+#define CONFIG_FONT_HZ12_MAP                (0)
+#define CONFIG_FONT_HZ16_MAP                (0)
 
 /* APP */
 #define CONFIG_APP_PRIORITY                 (RTGUI_SERVER_PRIORITY + (RT_THREAD_PRIORITY_MAX >> 3))
@@ -76,6 +92,8 @@
 // #define RTGUI_LOG_EVENT
 // #define RTGUI_OBJECT_TRACE
 // #define RTGUI_USING_CURSOR
+// #define RTGUI_USING_DC_STAT
+// #define RTGUI_MEM_TRACE
 
 
 /* Event Config */
@@ -93,6 +111,25 @@
 #if (CONFIG_USING_MONO)
 # define RTGUI_USING_FRAMEBUFFER
 #endif
+/* RAM cost is for 32-bit MCU, "pitch" is bytes per screen line */
+#ifdef RTGUI_USING_FRAMEBUFFER
+// # define RTGUI_USING_DOUBLE_BUFFER       // heap: pitch * height, a back buffer
+#else
+// # define RTGUI_USING_STRIP               // heap: pitch * RTGUI_STRIP_LINES when painting
+#endif
+#define RTGUI_STRIP_LINES                   (16)        // 7.5KB for 240 wide RGB565
+#define RTGUI_MEM_FB_NAME                   "MEMFB"
+// #define RTGUI_USING_EXT_OPS              // device "ext_ops" follow "driver.h"
+#define RTGUI_SPAN_BATCH_SIZE               (16)        // stack: 6 bytes each
+#define RTGUI_USING_DC_BUFFER                           // heap: pitch * height per buffer dc only
+#define RTGUI_USING_DC_AA                               // heap: edge table per polygon when drawing
+#define RTGUI_DC_HW_POOL_SIZE               (4)         // max 32, 0: heap only; RAM: 16 bytes each
+#define RTGUI_USING_DAMAGE                              // RAM: ~120 bytes (lock, timer and region)
+#define RTGUI_DAMAGE_MAX_RECTS              (4)         // heap and stack: 8 bytes each
+#define RTGUI_DAMAGE_FLUSH_DELAY            (RT_TICK_PER_SECOND / 50)  // flushed by timer if no more event
+#define RTGUI_USING_GLYPH_CACHE                         // stack: 128 bytes when drawing a char
+#define RTGUI_GLYPH_CACHE_SIZE              (4 * 1024)  // bytes of heap, at most
+#define RTGUI_GLYPH_CACHE_HASH              (32)        // buckets, power of 2; RAM: 4 bytes each
 
 
 /* Color Config */
@@ -52,6 +52,10 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y);
     void rtgui_cursor_show(void);
     void rtgui_cursor_hide(void);
     rt_bool_t rtgui_mouse_is_intersect(rtgui_rect_t *rect);
+#  ifdef RTGUI_USING_DOUBLE_BUFFER
+    void rtgui_cursor_compose(const rtgui_gfx_driver_t *drv,
+        const rtgui_rect_t *rect);
+#  endif
 # endif
 # ifdef RTGUI_USING_WINMOVE
     rt_bool_t rtgui_winmove_is_moving(void);
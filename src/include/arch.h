@@ -37,6 +37,19 @@ extern "C" {
 #define rtgui_exit_critical         rt_exit_critical
 
 /* Exported types ------------------------------------------------------------*/
+#ifdef RTGUI_MEM_TRACE
+typedef struct rtgui_mem_info {
+    rt_uint32_t allocated_size;
+    rt_uint32_t max_allocated;
+    rt_uint32_t alloc_count;
+    rt_uint32_t free_count;
+    rt_uint32_t pool_used;              /* pooled objects in use */
+    rt_uint32_t pool_max_used;
+    rt_uint32_t pool_alloc_count;       /* allocations served by pools */
+    rt_uint32_t pool_miss_count;        /* pool empty, fell back to heap */
+} rtgui_mem_info_t;
+#endif
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported functions ------------------------------------------------------- */
 rt_err_t rtgui_system_init(void);
@@ -51,6 +64,11 @@ void rtgui_timer_stop(rtgui_timer_t *timer);
 void *rtgui_malloc(rt_size_t size);
 void rtgui_free(void *ptr);
 void *rtgui_realloc(void *ptr, rt_size_t size);
+#ifdef RTGUI_MEM_TRACE
+    void rtgui_mem_get_info(rtgui_mem_info_t *info);
+    void rtgui_mem_pool_alloc_hook(rt_bool_t hit);
+    void rtgui_mem_pool_free_hook(void);
+#endif
 
 void rtgui_get_screen_rect(rtgui_rect_t *rect);
 void rtgui_screen_lock(rt_int32_t timeout);
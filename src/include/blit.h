@@ -58,10 +58,20 @@ extern "C" {
 /* Exported types ------------------------------------------------------------*/
 typedef void (*rtgui_blit_line_func)(rt_uint8_t *_dst, rt_uint8_t *_src,
     rt_uint32_t len, rt_uint8_t scale, rtgui_image_palette_t *palette);
+/* source-over ARGB "color" on "len" native pixels */
+typedef void (*rtgui_blend_fill_func)(rt_uint8_t *dst, rtgui_color_t color,
+    rt_uint32_t len);
+/* source-over "len" ARGB pixels on native pixels */
+typedef void (*rtgui_blend_line_func)(rt_uint8_t *dst, const rtgui_color_t *src,
+    rt_uint32_t len);
 
 /* Exported functions ------------------------------------------------------- */
 rtgui_blit_line_func rtgui_get_blit_line_func(rt_uint8_t src_fmt,
     rt_uint8_t dst_fmt);
+rtgui_blend_fill_func rtgui_get_blend_fill_func(rt_uint8_t dst_fmt);
+rtgui_blend_line_func rtgui_get_blend_line_func(rt_uint8_t dst_fmt);
+rtgui_color_t rtgui_blit_pixel(rt_uint8_t dst_fmt, rtgui_color_t color,
+    rt_uint8_t dither);
 
 #ifdef __cplusplus
 }
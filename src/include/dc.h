@@ -42,16 +42,35 @@ extern "C" {
 typedef enum rtgui_dc_type {
     RTGUI_DC_HW,
     RTGUI_DC_CLIENT,
+    RTGUI_DC_BUFFER,
 } rtgui_dc_type_t;
 
+/* sector of a circle, "start" to "end" clockwise in degree */
+typedef struct rtgui_sector {
+    int sx, sy;                         /* start direction in Q15 */
+    int ex, ey;                         /* end direction in Q15 */
+    rt_bool_t wide;                     /* over 180 degree */
+} rtgui_sector_t;
+
+/* polygon fill rule */
+typedef enum rtgui_fill_rule {
+    RTGUI_FILL_EVEN_ODD,
+    RTGUI_FILL_NON_ZERO,
+} rtgui_fill_rule_t;
+
 struct rtgui_dc_engine {
     /* interface */
     void (*draw_point)(rtgui_dc_t *dc, int x, int y);
     void (*draw_color_point)(rtgui_dc_t *dc, int x, int y, rtgui_color_t color);
+    /* read back a point, RT_FALSE if not visible */
+    rt_bool_t (*get_color_point)(rtgui_dc_t *dc, int x, int y, rtgui_color_t *color);
     void (*draw_vline)(rtgui_dc_t *dc, int x, int y1, int y2);
     void (*draw_hline)(rtgui_dc_t *dc, int x1, int x2, int y);
+    void (*draw_hspans)(rtgui_dc_t *dc, rtgui_color_t *color, const rtgui_span_t *spans, rt_uint32_t num);
     void (*fill_rect)(rtgui_dc_t *dc, rtgui_rect_t *rect);
     void (*blit_line)(rtgui_dc_t *dc, int x1, int x2, int y, rt_uint8_t *line_data);
+    /* source-over "argb" pixels, or "color" if RT_NULL, x2 is exclusive */
+    void (*blend_line)(rtgui_dc_t *dc, int x1, int x2, int y, rtgui_color_t color, const rtgui_color_t *argb);
     void (*blit)(rtgui_dc_t *dc, struct rtgui_point *dc_point, rtgui_dc_t *dest, rtgui_rect_t *rect);
 
     rt_bool_t (*fini)(rtgui_dc_t *dc);
@@ -79,12 +98,52 @@ struct rtgui_dc_hw {
     const rtgui_gfx_driver_t *hw_driver;
 };
 
+#ifdef RTGUI_USING_DC_BUFFER
+/*
+ * The buffer device context
+ *
+ * The buffer DC is a memory canvas in any supported pixel format. It has its
+ * own gc and the logic coordinate is the pixel position in the buffer. The
+ * content is shown by blitting to a client or hardware DC.
+ *
+ */
+struct rtgui_dc_buffer {
+    rtgui_dc_t _super;
+    rtgui_gc_t gc;
+    rt_uint8_t pixel_format;
+    rt_uint8_t bits_per_pixel;
+    rt_uint16_t pitch;
+    rt_uint16_t width;
+    rt_uint16_t height;
+    rt_uint8_t *pixel;
+};
+#endif
+
+
+/* collect horizontal lines and draw them in one call */
+typedef struct rtgui_span_batch {
+    rtgui_dc_t *dc;
+    rtgui_color_t *color;               /* RT_NULL for foreground */
+    rt_uint32_t num;
+    rtgui_span_t spans[RTGUI_SPAN_BATCH_SIZE];
+} rtgui_span_batch_t;
+
+#ifdef RTGUI_USING_DC_STAT
+typedef struct rtgui_dc_stat {
+    rt_uint32_t clip_rects;             /* clip rects visited by client dc */
+} rtgui_dc_stat_t;
+#endif
 
 #define RTGUI_DC(dc)            ((rtgui_dc_t*)(dc))
 #define RTGUI_DC_FC(dc)         (rtgui_dc_get_gc(RTGUI_DC(dc))->foreground)
 #define RTGUI_DC_BC(dc)         (rtgui_dc_get_gc(RTGUI_DC(dc))->background)
 #define RTGUI_DC_FONT(dc)       (rtgui_dc_get_gc(RTGUI_DC(dc))->font)
 #define RTGUI_DC_TEXTALIGN(dc)  (rtgui_dc_get_gc(RTGUI_DC(dc))->textalign)
+#define RTGUI_DC_IS_AA(dc)      \
+    (rtgui_dc_get_gc(RTGUI_DC(dc))->drawstyle & RTGUI_DRAWSTYLE_AA)
+/* translucent color drawn by blending, see "RTGUI_DRAWSTYLE_BLEND" */
+#define RTGUI_GC_IS_BLEND(gc, c)    \
+    (((gc)->drawstyle & RTGUI_DRAWSTYLE_BLEND) && (RTGUI_RGB_A(c) != 0xff))
 
 /* Exported constants --------------------------------------------------------*/
 
@@ -99,24 +158,65 @@ rtgui_dc_t *rtgui_dc_hw_create(rtgui_widget_t *owner);
 /* create a client dc */
 rtgui_dc_t *rtgui_dc_client_create(rtgui_widget_t *owner);
 void rtgui_dc_client_init(rtgui_widget_t *owner);
+#ifdef RTGUI_USING_DC_BUFFER
+/* create a buffer dc, free by rtgui_dc_destory() */
+rtgui_dc_t *rtgui_dc_buffer_create(int width, int height);
+rtgui_dc_t *rtgui_dc_buffer_create_pixformat(rt_uint8_t pixel_format,
+    int width, int height);
+rt_uint8_t *rtgui_dc_buffer_get_pixel(rtgui_dc_t *dc);
+#endif
+#ifdef RTGUI_USING_DC_AA
+/* anti-aliased primitives, used instead when "RTGUI_DRAWSTYLE_AA" is set */
+void rtgui_dc_aa_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2);
+void rtgui_dc_aa_draw_ellipse(rtgui_dc_t *dc, int x, int y, int rx, int ry,
+    const rtgui_sector_t *sec);
+void rtgui_dc_aa_fill_ellipse(rtgui_dc_t *dc, int x, int y, int rx, int ry);
+void rtgui_dc_aa_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy,
+    int count, rtgui_fill_rule_t rule);
+#endif
+#ifdef RTGUI_USING_DC_STAT
+void rtgui_dc_client_get_stat(rtgui_dc_stat_t *stat, rt_bool_t reset);
+#endif
 
 /* begin and end a drawing */
 rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner);
 void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update);
 
+void rtgui_dc_span_batch_init(rtgui_span_batch_t *batch, rtgui_dc_t *dc,
+    rtgui_color_t *color);
+void rtgui_dc_span_batch_add(rtgui_span_batch_t *batch, int x1, int x2, int y);
+void rtgui_dc_span_batch_flush(rtgui_span_batch_t *batch);
+/* 1bpp mask, "pitch" in bits and MSB first. Set bits in foreground, clear
+   bits in background if RTGUI_TEXTSTYLE_DRAW_BACKGROUND */
+void rtgui_dc_draw_mono_mask(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *bits, rt_uint32_t pitch);
+
 void rtgui_dc_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2);
 void rtgui_dc_draw_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 void rtgui_dc_fill_rect_forecolor(rtgui_dc_t *dc, rtgui_rect_t *rect);
 void rtgui_dc_draw_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r);
 void rtgui_dc_fill_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r);
-/** Fill a vertical gradient rect from @c1 to @c2 */
+/* gradient fills, 565 formats are dithered with "RTGUI_DRAWSTYLE_DITHER" */
 void rtgui_dc_fill_gradient_rectv(rtgui_dc_t *dc, rtgui_rect_t *rect,
-                                  rtgui_color_t c1, rtgui_color_t c2);
+    rtgui_color_t c1, rtgui_color_t c2);
+void rtgui_dc_fill_gradient_recth(rtgui_dc_t *dc, rtgui_rect_t *rect,
+    rtgui_color_t c1, rtgui_color_t c2);
+void rtgui_dc_fill_gradient_radial(rtgui_dc_t *dc, rtgui_rect_t *rect,
+    int x, int y, int r, rtgui_color_t c1, rtgui_color_t c2);
 void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end);
 void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r, rt_int16_t start, rt_int16_t end);
 void rtgui_dc_fill_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r, rt_int16_t start, rt_int16_t end);
+void rtgui_dc_fill_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r1, rt_int16_t r2, rt_int16_t start, rt_int16_t end);
+/* sin() and cos() of degree in Q15 (32768 is 1.0) */
+int rtgui_sin_q15(int angle);
+int rtgui_cos_q15(int angle);
+rt_bool_t rtgui_dc_sector_init(rtgui_sector_t *sec, int start, int end,
+    rt_bool_t *full);
+rt_bool_t rtgui_dc_sector_has(const rtgui_sector_t *sec, int x, int y);
 
 void rtgui_dc_draw_text(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect);
+void rtgui_dc_draw_text_layout(rtgui_dc_t *dc, const char *text,
+    rtgui_text_layout_t *layout, rtgui_rect_t *rect);
 void rtgui_dc_draw_text_stroke(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect,
                                rtgui_color_t color_stroke, rtgui_color_t color_core);
 
@@ -131,6 +231,8 @@ void rtgui_dc_draw_focus_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 
 void rtgui_dc_draw_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count);
 void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count);
+void rtgui_dc_fill_polygon_rule(rtgui_dc_t *dc, const int *vx, const int *vy,
+    int count, rtgui_fill_rule_t rule);
 
 void rtgui_dc_draw_circle(rtgui_dc_t *dc, int x, int y, int r);
 void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r);
@@ -161,6 +263,14 @@ rt_inline void rtgui_dc_draw_color_point(rtgui_dc_t *dc, int x, int y,
     return dc->engine->draw_color_point(dc, x, y, color);
 }
 
+/*
+ * get the color of a point on dc, RT_FALSE if the point is not visible
+ */
+rt_inline rt_bool_t rtgui_dc_get_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t *color) {
+    return dc->engine->get_color_point(dc, x, y, color);
+}
+
 /*
  * draw a vertical line on dc
  */
@@ -175,6 +285,22 @@ rt_inline void rtgui_dc_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y) {
     return dc->engine->draw_hline(dc, x1, x2, y);
 }
 
+/*
+ * draw horizontal lines on dc with foreground color
+ */
+rt_inline void rtgui_dc_draw_hspans(rtgui_dc_t *dc, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    return dc->engine->draw_hspans(dc, RT_NULL, spans, num);
+}
+
+/*
+ * draw horizontal lines on dc with specified color
+ */
+rt_inline void rtgui_dc_draw_color_hspans(rtgui_dc_t *dc, rtgui_color_t color,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    return dc->engine->draw_hspans(dc, &color, spans, num);
+}
+
 /*
  * fill a rect with background color
  */
@@ -183,7 +309,23 @@ rt_inline void rtgui_dc_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
 }
 
 /*
- * blit a dc (x, y) on another dc(rect)
+ * source-over a line of ARGB pixels on dc, x2 is exclusive
+ */
+rt_inline void rtgui_dc_blend_line(rtgui_dc_t *dc, int x1, int x2, int y,
+    const rtgui_color_t *argb) {
+    return dc->engine->blend_line(dc, x1, x2, y, 0, argb);
+}
+
+/*
+ * source-over a horizontal line of color on dc, x2 is exclusive
+ */
+rt_inline void rtgui_dc_blend_hline(rtgui_dc_t *dc, int x1, int x2, int y,
+    rtgui_color_t color) {
+    return dc->engine->blend_line(dc, x1, x2, y, color, RT_NULL);
+}
+
+/*
+ * blit a dc (x, y) on another dc(rect), only buffer dc is supported as source
  */
 rt_inline void rtgui_dc_blit(rtgui_dc_t *dc, struct rtgui_point *point,
     rtgui_dc_t *dst, rtgui_rect_t *rect) {
@@ -203,6 +345,9 @@ rt_uint8_t rtgui_dc_get_pixel_format(rtgui_dc_t *dc);
 /* coordinate conversion */
 void rtgui_dc_logic_to_device(rtgui_dc_t* dc, struct rtgui_point *point);
 void rtgui_dc_rect_to_device(rtgui_dc_t* dc, rtgui_rect_t* rect);
+/* move pixels by (dx, dy) and report the area left to redraw */
+rt_bool_t rtgui_dc_scroll_area(rtgui_dc_t *dc, rtgui_rect_t *rect, int dx,
+    int dy, rtgui_region_t *exposed);
 
 #endif /* IMPORT_TYPES */
 
@@ -32,6 +32,13 @@
 /* Exported types ------------------------------------------------------------*/
 typedef struct rtgui_gfx_driver rtgui_gfx_driver_t;
 
+/* horizontal span, same coordinates as "draw_hline" */
+typedef struct rtgui_span {
+    rt_int16_t x1;
+    rt_int16_t x2;
+    rt_int16_t y;
+} rtgui_span_t;
+
 /* graphic driver operations */
 struct rtgui_graphic_driver_ops {
     void (*set_pixel)(rtgui_color_t *c, int x, int y);
@@ -39,9 +46,21 @@ struct rtgui_graphic_driver_ops {
     void (*draw_hline)(rtgui_color_t *c, int x1, int x2, int y);
     void (*draw_vline)(rtgui_color_t *c, int x , int y1, int y2);
     void (*draw_raw_hline)(rt_uint8_t *pixels, int x1, int x2, int y);
+    /* not used in device ops (device->user_data) */
+    void (*draw_hspans)(rtgui_color_t *c, const rtgui_span_t *spans,
+        rt_uint32_t num);
+    void (*fill_rect)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
 };
 
-/* graphic extension operations */
+/* graphic extension operations of the device (RTGRAPHIC_CTRL_GET_EXT), any of
+   them may be RT_NULL. They are called only with "RTGUI_USING_EXT_OPS", the
+   driver then follows the contract:
+   - "*c" is the native pixel (see rtgui_gfx_color_to_native()), not the
+     rtgui_color_t
+   - (x1, y1) is inclusive and x2 / y2 are exclusive, as "draw_hline"
+   - the area is on screen
+   Without the option the struct is the original one, so the drivers written
+   before keep working. */
 struct rtgui_graphic_ext_ops {
     void (*draw_line)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
     void (*draw_rect)(rtgui_color_t *c, int x1, int y1, int x2, int y2);
@@ -50,6 +69,15 @@ struct rtgui_graphic_ext_ops {
     void (*fill_circle)(rtgui_color_t *c, int x, int y, int r);
     void (*draw_ellipse)(rtgui_color_t *c, int x, int y, int rx, int ry);
     void (*fill_ellipse)(rtgui_color_t *c, int x, int y, int rx, int ry);
+    #ifdef RTGUI_USING_EXT_OPS
+        /* set window (x1, y1) - (x2, y2) once and burst the native pixels,
+           "pitch" is the bytes per line of "pixels" */
+        void (*blit_rect)(rt_uint8_t *pixels, rt_uint32_t pitch, int x1,
+            int y1, int x2, int y2);
+        /* hardware scroll, copy (x1, y1) - (x2, y2) by (dx, dy), the two may
+           overlap and both are on screen */
+        void (*move_rect)(int x1, int y1, int x2, int y2, int dx, int dy);
+    #endif
 };
 
 struct rtgui_gfx_driver {
@@ -62,11 +90,43 @@ struct rtgui_gfx_driver {
     rt_uint16_t height;
     /* framebuffer address and ops */
     rt_uint8_t *framebuffer;
+    /* scanout buffer, if "framebuffer" is the back buffer */
+    rt_uint8_t *front_buffer;
     struct rt_device* device;
     const struct rtgui_graphic_driver_ops *ops;
+    /* same as "ops" but take native pixel, see rtgui_gfx_color_to_native() */
+    const struct rtgui_graphic_driver_ops *native_ops;
     const struct rtgui_graphic_ext_ops *ext_ops;
 };
 
+/* screen update statistics, bytes in native pixel format */
+typedef struct rtgui_damage_stat {
+    rt_uint32_t add_count;              /* damage rects added */
+    rt_uint32_t flush_count;            /* damage flushes */
+    rt_uint32_t update_count;           /* RTGRAPHIC_CTRL_RECT_UPDATE calls */
+    rt_uint32_t bytes_requested;        /* sum of damage rects added */
+    rt_uint32_t bytes_damaged;          /* union of damage rects added */
+    rt_uint32_t bytes_pushed;           /* sum of RTGRAPHIC_CTRL_RECT_UPDATE */
+} rtgui_damage_stat_t;
+
+#ifdef RTGUI_USING_STRIP
+    typedef struct rtgui_strip_stat {
+        rt_uint32_t strip_count;        /* strips pushed */
+        rt_uint32_t strip_pixels;       /* band area of these strips */
+        rt_uint32_t push_pixels;        /* pixels pushed */
+        rt_uint32_t bus_bytes;          /* bytes pushed */
+        rt_uint32_t burst_count;        /* windows set to push */
+        rt_uint32_t read_pixels;        /* pixels read back to seed bands */
+    } rtgui_strip_stat_t;
+#endif
+
+#if (CONFIG_USING_MEM_FB)
+    typedef struct rtgui_mem_fb_stat {
+        rt_uint32_t update_count;       /* RTGRAPHIC_CTRL_RECT_UPDATE calls */
+        rt_uint32_t update_pixels;      /* pixels covered by these calls */
+    } rtgui_mem_fb_stat_t;
+#endif
+
 #ifdef RTGUI_USING_HW_CURSOR
     enum rtgui_cursor_type {
         RTGUI_CURSOR_ARROW,
@@ -84,7 +144,43 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev);
 REFERENCE_GETTER_PROTOTYPE(gfx_device, rtgui_gfx_driver_t);
 void rtgui_gfx_get_rect(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
 void rtgui_gfx_update_screen(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
+void rtgui_gfx_damage_add(const rtgui_gfx_driver_t *driver, rtgui_rect_t *rect);
+void rtgui_gfx_damage_flush(const rtgui_gfx_driver_t *driver, rt_bool_t force);
+void rtgui_gfx_damage_get_stat(rtgui_damage_stat_t *stat, rt_bool_t reset);
+
+#ifdef RTGUI_USING_STRIP
+    rt_err_t rtgui_gfx_strip_begin(rtgui_region_t *clip,
+        const rtgui_color_t *background);
+    rt_bool_t rtgui_gfx_strip_next(void);
+    void rtgui_gfx_strip_get_stat(rtgui_strip_stat_t *stat, rt_bool_t reset);
+#endif
 rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *driver);
+rtgui_color_t rtgui_gfx_color_to_native(rtgui_color_t color);
+void rtgui_gfx_blend_hline(int x1, int x2, int y, rtgui_color_t color,
+    const rtgui_color_t *argb);
+rt_bool_t rtgui_gfx_move_rect(rtgui_rect_t *rect, int dx, int dy);
+
+/* native pixel of gc colors, converted only when the color changed */
+rt_inline rtgui_color_t *rtgui_gc_native_fg(rtgui_gc_t *gc) {
+    if (gc->fg_key != gc->foreground) {
+        gc->fg_native = rtgui_gfx_color_to_native(gc->foreground);
+        gc->fg_key = gc->foreground;
+    }
+    return &gc->fg_native;
+}
+
+rt_inline rtgui_color_t *rtgui_gc_native_bg(rtgui_gc_t *gc) {
+    if (gc->bg_key != gc->background) {
+        gc->bg_native = rtgui_gfx_color_to_native(gc->background);
+        gc->bg_key = gc->background;
+    }
+    return &gc->bg_native;
+}
+
+rt_inline void rtgui_gc_invalidate(rtgui_gc_t *gc) {
+    gc->fg_key = ~gc->foreground;
+    gc->bg_key = ~gc->background;
+}
 
 #ifdef CONFIG_TOUCH_DEVICE_NAME
     rt_err_t rtgui_set_touch_device(rt_device_t dev);
@@ -96,6 +192,12 @@ rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *driver);
     GETTER_PROTOTYPE(key_device, rt_device_t);
 #endif /* CONFIG_KEY_DEVICE_NAME */
 
+#if (CONFIG_USING_MEM_FB)
+    rt_err_t rtgui_mem_fb_init(void);
+    rt_uint8_t *rtgui_mem_fb_get_buffer(void);
+    void rtgui_mem_fb_get_stat(rtgui_mem_fb_stat_t *stat, rt_bool_t reset);
+#endif /* CONFIG_USING_MEM_FB */
+
 #ifdef RTGUI_USING_HW_CURSOR
     void rtgui_cursor_set_device(const char* device_name);
     void rtgui_cursor_set_position(rt_uint16_t x, rt_uint16_t y);
@@ -185,6 +185,8 @@ typedef enum rtgui_evt_type {
     RTGUI_EVENT_TIMER,
     /* clip rect information */
     RTGUI_EVENT_CLIP_INFO,
+    /* screen damage is due to flush */
+    RTGUI_EVENT_UPDATE_FLUSH,
     /* mouse and keyboard event */
     RTGUI_EVENT_MOUSE_MOTION                = 0x4000,
     RTGUI_EVENT_MOUSE_BUTTON,
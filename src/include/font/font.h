@@ -39,14 +39,51 @@ typedef struct rtgui_font_engine rtgui_font_engine_t;
 typedef struct rtgui_fnt_font rtgui_fnt_font_t;
 typedef struct rtgui_bmp_font rtgui_bmp_font_t;
 typedef struct rtgui_font rtgui_font_t;
+typedef struct rtgui_text_layout rtgui_text_layout_t;
+
+#if (CONFIG_USING_FONT_FILE)
+    typedef struct rtgui_font_file rtgui_font_file_t;
+
+    enum rtgui_font_storage {
+        RTGUI_FONT_STORAGE_NONE = 0,        /* not opened yet */
+        RTGUI_FONT_STORAGE_MAP,             /* at "map", e.g. XIP flash */
+        RTGUI_FONT_STORAGE_RAM,             /* whole file loaded */
+        RTGUI_FONT_STORAGE_CACHE,           /* page cache */
+        RTGUI_FONT_STORAGE_READ,            /* seek and read per glyph */
+    };
+
+    struct rtgui_font_file {
+        const char *fname;
+        int fd;
+        rt_uint8_t storage;
+        const rt_uint8_t *map;              /* file address or RT_NULL */
+        const rt_uint8_t *base;             /* MAP and RAM storage */
+        rt_uint8_t *pages;                  /* CACHE storage */
+        rt_uint32_t page_off[CONFIG_FONT_PAGE_NUM];
+        rt_uint32_t page_use[CONFIG_FONT_PAGE_NUM];
+        rt_uint32_t use;
+    };
+
+    typedef struct rtgui_font_file_stat {
+        rt_uint32_t glyph_count;            /* glyphs read */
+        rt_uint32_t read_count;             /* file system reads */
+        rt_uint32_t read_bytes;             /* bytes read from file system */
+        rt_uint32_t page_hit;               /* page cache hits */
+        rt_uint32_t page_miss;              /* page cache misses */
+    } rtgui_font_file_stat_t;
+#endif
 
 struct rtgui_font_engine {
     rt_err_t (*font_init)(rtgui_font_t *font);
+    void (*font_uninit)(rtgui_font_t *font);
     rt_err_t (*font_open)(rtgui_font_t *font);
     void (*font_close)(rtgui_font_t *font);
     rt_uint8_t (*font_draw_char)(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect);
     rt_uint8_t (*font_get_width)(rtgui_font_t *font, const char *text);
+    /* 1bpp glyph, "font->width" bits per row and MSB first, return width */
+    rt_uint8_t (*font_get_mask)(rtgui_font_t *font, rt_uint16_t code,
+        rt_uint8_t *mask);
 };
 
 struct rtgui_fnt_font {
@@ -54,16 +91,14 @@ struct rtgui_fnt_font {
     const rt_uint16_t *offset;
     const rt_uint8_t *width;
     #if (CONFIG_USING_FONT_FILE)
-        const char *fname;
-        int fd;
+        rtgui_font_file_t file;
     #endif
 };
 
 struct rtgui_bmp_font {
     void *data;
     #if (CONFIG_USING_FONT_FILE)
-        const char *fname;
-        int fd;
+        rtgui_font_file_t file;
     #endif
 };
 
@@ -81,6 +116,31 @@ struct rtgui_font {
     rt_slist_t list;                        /* the font list */
 };
 
+/* decoded and measured text, reused until the text or the font changes */
+typedef struct rtgui_text_glyph {
+    rt_uint16_t code;                       /* code in font */
+    rt_uint8_t width;                       /* x advance */
+    rt_uint8_t alt;                         /* drawn by the companion font */
+} rtgui_text_glyph_t;
+
+struct rtgui_text_layout {
+    rtgui_font_t *font;                     /* RT_NULL if not built */
+    rtgui_font_t *alt;                      /* companion font ("asc"/"hz") */
+    rtgui_text_glyph_t *glyphs;
+    rt_uint16_t count;                      /* #glyphs */
+    rt_uint16_t width;                      /* sum of x advances */
+};
+
+#ifdef RTGUI_USING_GLYPH_CACHE
+    typedef struct rtgui_glyph_cache_stat {
+        rt_uint32_t hit_count;          /* glyphs drawn from cache */
+        rt_uint32_t miss_count;         /* glyphs read from font */
+        rt_uint32_t evict_count;        /* glyphs dropped for space */
+        rt_uint32_t glyphs;             /* glyphs in cache */
+        rt_uint32_t bytes;              /* bytes in cache */
+    } rtgui_glyph_cache_stat_t;
+#endif
+
 #undef __FONT_H__
 #else /* IMPORT_TYPES */
 
@@ -137,6 +197,27 @@ rt_uint8_t rtgui_font_get_width(rtgui_font_t *font, const char *text);
 rt_uint32_t rtgui_font_get_string_width(rtgui_font_t *font, const char *text);
 void rtgui_font_get_metrics(rtgui_font_t *font, const char *text,
     rtgui_rect_t *rect);
+rt_err_t rtgui_text_layout_build(rtgui_text_layout_t *layout,
+    rtgui_font_t *font, const char *text);
+void rtgui_text_layout_free(rtgui_text_layout_t *layout);
+void rtgui_text_layout_get_metrics(rtgui_text_layout_t *layout,
+    rtgui_rect_t *rect);
+void rtgui_text_layout_draw(rtgui_text_layout_t *layout, rtgui_dc_t *dc,
+    rtgui_rect_t *rect);
+#if (CONFIG_USING_FONT_FILE)
+    rt_err_t rtgui_font_file_open(rtgui_font_file_t *file);
+    void rtgui_font_file_close(rtgui_font_file_t *file);
+    void rtgui_font_file_unload(rtgui_font_file_t *file);
+    const rt_uint8_t *rtgui_font_file_read(rtgui_font_file_t *file,
+        rt_uint32_t offset, rt_uint32_t size, rt_uint8_t *buf);
+    void rtgui_font_file_get_stat(rtgui_font_file_stat_t *stat,
+        rt_bool_t reset);
+#endif
+#ifdef RTGUI_USING_GLYPH_CACHE
+    void rtgui_font_cache_flush(rtgui_font_t *font);
+    void rtgui_font_cache_get_stat(rtgui_glyph_cache_stat_t *stat,
+        rt_bool_t reset);
+#endif
 
 #if (CONFIG_USING_FONT_HZ)
 rt_uint16_t UnicodeToGB2312(rt_uint16_t unicode);
@@ -36,10 +36,10 @@ extern "C" {
 /* Exported defines ----------------------------------------------------------*/
 /*  true if rect r1 and r2 are overlap */
 #define IS_R_INTERSECT(r1, r2)      \
-    (  !((r1)->x2 <= (r2)->x1)  ||  \
+    (!( ((r1)->x2 <= (r2)->x1)  ||  \
         ((r1)->x1 >= (r2)->x2)  ||  \
         ((r1)->y2 <= (r2)->y1)  ||  \
-        ((r1)->y1 >= (r2)->y2)  )
+        ((r1)->y1 >= (r2)->y2)  ))
 
 /* true if rect contains point (x, y) */
 #define IS_P_INSIDE(r, x, y)    \
@@ -48,19 +48,19 @@ extern "C" {
         ((r)->y2 >  (y))    &&  \
         ((r)->y1 <= (y))    )
 
-/* true if vline intersect rect */
+/* true if vline intersect rect, y2 is exclusive */
 #define IS_VL_INTERSECT(r, x, y1, y2) \
-    (  !((r)->x1 >  ( x))   ||  \
+    (!( ((r)->x1 >  ( x))   ||  \
         ((r)->x2 <= ( x))   ||  \
         ((r)->y2 <= (y1))   ||  \
-        ((r)->y1 >  (y2))   )
+        ((r)->y1 >= (y2))   ))
 
-/* true if hline intersect rect */
+/* true if hline intersect rect, x2 is exclusive */
 #define IS_HL_INTERSECT(r, x1, x2, y) \
-    (  !((r)->y1 >  ( y))   ||  \
+    (!( ((r)->y1 >  ( y))   ||  \
         ((r)->y2 <= ( y))   ||  \
         ((r)->x2 <= (x1))   ||  \
-        ((r)->x1 >  (x2))   )
+        ((r)->x1 >= (x2))   ))
 
 /* true if rect r1 contains rect r2 */
 #define IS_R_INSIDE(r1, r2)         \
@@ -112,6 +112,13 @@ struct rtgui_region {
     rtgui_region_data_t *data;
 };
 
+/* A band is the rects of a region with the same y1 and y2, sorted by x1.
+   Bands are sorted by y1. Keep the last band found as the search hint. */
+typedef struct rtgui_region_band {
+    rt_uint32_t idx;                        /* first rect of the band */
+    rt_uint32_t num;                        /* rects in the band */
+} rtgui_region_band_t;
+
 /* Exported constants --------------------------------------------------------*/
 
 #undef __RTGUI_REGION_H__
@@ -157,6 +164,10 @@ void rtgui_region_empty(rtgui_region_t *region);
 void rtgui_region_dump(rtgui_region_t *region);
 void rtgui_region_draw_clip(rtgui_region_t *region, rtgui_dc_t *dc);
 rt_bool_t rtgui_region_is_flat(rtgui_region_t *region);
+rt_uint32_t rtgui_region_find_band(rtgui_region_t *region, int y,
+    rtgui_region_band_t *band);
+rt_uint32_t rtgui_region_next_band(rtgui_region_t *region,
+    rtgui_region_band_t *band);
 
 /* rect functions */
 void rtgui_rect_move(rtgui_rect_t *rect, int x, int y);
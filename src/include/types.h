@@ -188,7 +188,13 @@ struct rtgui_gc {
     rtgui_color_t background;
     rt_uint16_t textstyle;
     rt_uint16_t textalign;
+    rt_uint16_t drawstyle;
     rtgui_font_t *font;
+    /* native pixel cache, valid when key equals the color */
+    rtgui_color_t fg_key;
+    rtgui_color_t fg_native;
+    rtgui_color_t bg_key;
+    rtgui_color_t bg_native;
 };
 
 typedef enum rtgui_orient {
@@ -242,6 +248,13 @@ enum rtgui_text_style {
     RTGUI_TEXTSTYLE_OUTLINE                 = 0x04,
 };
 
+enum rtgui_draw_style {
+    RTGUI_DRAWSTYLE_NORMAL                  = 0x00,
+    RTGUI_DRAWSTYLE_AA                      = 0x01,
+    RTGUI_DRAWSTYLE_BLEND                   = 0x02,
+    RTGUI_DRAWSTYLE_DITHER                  = 0x04,
+};
+
 typedef enum rtgui_blend_mode {
     RTGUI_BLENDMODE_NONE                    = 0x00,
     RTGUI_BLENDMODE_BLEND,
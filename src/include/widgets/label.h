@@ -49,6 +49,7 @@ extern "C" {
 struct rtgui_label {
     rtgui_widget_t _super;
     char *text;
+    rtgui_text_layout_t layout;             /* text decoded for drawing */
 };
 
 /* Exported constants --------------------------------------------------------*/
@@ -42,6 +42,7 @@
 #define LIST_SETTER(mname)                  rtgui_list_set_##mname
 
 /* Exported types ------------------------------------------------------------*/
+/* after changing an item in place, call rtgui_list_item_changed() */
 struct rtgui_list_item {
     char *name;
     rtgui_image_t *image;
@@ -52,8 +53,10 @@ struct rtgui_list {
     rtgui_widget_t _super;
     /* PRIVATE */
     rtgui_list_item_t *items;
+    rtgui_text_layout_t *layouts;           /* decoded item names */
     rt_uint16_t page_sz;                    /* #items per page */
     rt_uint16_t count;                      /* #items */
+    rt_uint16_t top;                        /* first visible item */
     rt_int32_t current;                     /* current item */
     rtgui_evt_hdl_t on_item;
 };
@@ -71,6 +74,7 @@ rtgui_list_t *rtgui_create_list(rtgui_container_t *cntr, rtgui_evt_hdl_t hdl,
 void rtgui_list_set_items(rtgui_list_t *list, rtgui_list_item_t *items,
     rt_uint16_t count);
 void rtgui_list_set_current(rtgui_list_t *list, rt_int32_t idx);
+void rtgui_list_item_changed(rtgui_list_t *list, rt_int32_t idx);
 MEMBER_SETTER_PROTOTYPE(rtgui_list_t, list, rtgui_evt_hdl_t, on_item);
 
 void _theme_draw_selected(rtgui_dc_t *dc, rtgui_rect_t *rect);
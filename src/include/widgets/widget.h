@@ -141,6 +141,10 @@ void rtgui_widget_update_clip(rtgui_widget_t *wgt);
 void rtgui_widget_show(rtgui_widget_t *wgt);
 void rtgui_widget_hide(rtgui_widget_t *wgt);
 void rtgui_widget_update(rtgui_widget_t *wgt);
+#ifdef RTGUI_USING_STRIP
+rt_bool_t rtgui_widget_strip_paint(rtgui_widget_t *wgt, rtgui_region_t *clip,
+    rtgui_evt_generic_t *evt);
+#endif
 rt_bool_t rtgui_widget_onshow(rtgui_obj_t *obj, void *param);
 rt_bool_t rtgui_widget_onhide(rtgui_obj_t *obj, void *param);
 rt_bool_t rtgui_widget_onpaint(rtgui_obj_t *obj, rtgui_evt_generic_t *evt);
@@ -128,7 +128,7 @@ rt_err_t rtgui_app_init(rtgui_app_t *app, const char *name, rt_bool_t is_srv) {
             ret = -RT_ENOMEM;
             break;
         }
-        self->user_data = (rt_uint32_t)app;
+        self->user_data = (rt_ubase_t)app;
 
         if (is_srv) {
             rtgui_event_pool = rt_mp_create(name, RTGUI_EVENT_POOL_NUMBER,
@@ -223,6 +223,13 @@ rt_inline rt_bool_t _app_dispatch_event_to_win(
             return RT_TRUE;
         }
         if (EVENT_HANDLER(tgt)) {
+            #ifdef RTGUI_USING_STRIP
+                /* window repaint from server, band by band over what is
+                   visible */
+                if (IS_EVENT_TYPE(evt, PAINT) && rtgui_widget_strip_paint(
+                    TO_WIDGET(tgt), &TO_WIN(tgt)->outer_clip, evt))
+                    return RT_TRUE;
+            #endif
             return EVENT_HANDLER(tgt)(tgt, evt);
         } else {
             return RT_FALSE;
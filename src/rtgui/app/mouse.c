@@ -66,6 +66,10 @@ struct rtgui_cursor {
         /* cursor image and saved cursor */
         rtgui_image_t *cursor_image;
         void *rect_copy;
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* composed on front buffer */
+            rt_bool_t on_front;
+        #endif
     #endif /* RTGUI_USING_CURSOR */
 
     #ifdef RTGUI_USING_WINMOVE
@@ -148,6 +152,22 @@ static rtgui_cursor_t *_cursor;
 /* Private functions ---------------------------------------------------------*/
 #ifdef RTGUI_USING_CURSOR
 
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+/* the cursor is kept out of back buffer and composed on front buffer, see
+   rtgui_cursor_compose() */
+rt_inline rt_bool_t _cursor_is_front(void) {
+    return display()->front_buffer != RT_NULL;
+}
+
+/* push the cursor area at (x, y) to front buffer and screen */
+static void _cursor_front_update(rt_uint16_t x, rt_uint16_t y) {
+    rtgui_rect_t rect = _cursor->rect;
+
+    rtgui_rect_move(&rect, x, y);
+    rtgui_gfx_update_screen(display(), &rect);
+}
+#endif /* RTGUI_USING_DOUBLE_BUFFER */
+
 /* display the saved cursor area to screen */
 static void _cursor_rect_restore(void) {
     rt_uint8_t *fb;
@@ -239,7 +259,7 @@ static void _cursor_draw(void) {
     /* draw */
     for (y = rect.y1; y < rect.y2; y++)
         for (x = rect.x1; x < rect.x2; x++, pixel++)
-            if (0xff != RTGUI_RGB_A(*pixel))
+            if (RTGUI_RGB_A(*pixel))
                 display()->ops->set_pixel(pixel, x, y);
 
     /* update rect */
@@ -507,6 +527,10 @@ void rtgui_cursor_uninit(void) {
 }
 
 void rtgui_cursor_move(rt_uint16_t x, rt_uint16_t y) {
+    #if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+        rt_uint16_t old_x = _cursor->cx, old_y = _cursor->cy;
+    #endif
+
     #ifdef RTGUI_USING_CURSOR
         rt_mutex_take(&cursor_lock, RT_WAITING_FOREVER);
     #endif
@@ -546,6 +570,14 @@ void rtgui_cursor_move(rt_uint16_t x, rt_uint16_t y) {
             #endif
         }
 
+        #if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+            /* recompose the old and new area */
+            if (_cursor->on_front) {
+                _cursor_front_update(old_x, old_y);
+                _cursor_front_update(_cursor->cx, _cursor->cy);
+            }
+        #endif
+
         #ifdef RTGUI_USING_HW_CURSOR
             rtgui_cursor_set_position(_cursor->cx, _cursor->cy);
         #endif
@@ -646,6 +678,17 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y) {
     void rtgui_cursor_show(void) {
         if (!_cursor->show_cursor) return;
 
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* drawing never touches it, so shown once and never hidden */
+            if (_cursor_is_front()) {
+                if (!_cursor->on_front) {
+                    _cursor->on_front = RT_TRUE;
+                    _cursor_front_update(_cursor->cx, _cursor->cy);
+                }
+                return;
+            }
+        #endif
+
         _cursor->cursor_count++;
         LOG_D("->cursor cnt %d", _cursor->cursor_count);
 
@@ -658,6 +701,10 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y) {
     void rtgui_cursor_hide(void) {
         if (!_cursor->show_cursor) return;
 
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            if (_cursor_is_front()) return;
+        #endif
+
         if (1 == _cursor->cursor_count)
             _cursor_rect_restore();
 
@@ -668,6 +715,57 @@ rt_bool_t rtgui_monitor_contain_point(rt_slist_t *list, int x, int y) {
     rt_bool_t rtgui_mouse_is_intersect(rtgui_rect_t *rect) {
         return rtgui_rect_is_intersect(&(_cursor->rect), rect);
     }
+
+    #ifdef RTGUI_USING_DOUBLE_BUFFER
+    /* draw the cursor within "rect" on front buffer, called by driver after
+       copying "rect" from back buffer */
+    void rtgui_cursor_compose(const rtgui_gfx_driver_t *drv,
+        const rtgui_rect_t *rect) {
+        rtgui_rect_t area, screen;
+        rtgui_color_t *pixel, native;
+        rt_uint8_t *ptr;
+        int x, y, w;
+
+        if (!_cursor || !_cursor->on_front || !_cursor->show_cursor) return;
+
+        area = _cursor->rect;
+        rtgui_rect_move(&area, _cursor->cx, _cursor->cy);
+        rtgui_rect_intersect((rtgui_rect_t *)rect, &area);
+        rtgui_rect_init(&screen, 0, 0, drv->width, drv->height);
+        rtgui_rect_intersect(&screen, &area);
+        if ((area.x1 >= area.x2) || (area.y1 >= area.y2)) return;
+        w = _cursor->cursor_image->w;
+
+        for (y = area.y1; y < area.y2; y++) {
+            pixel = (rtgui_color_t *)_cursor->cursor_image->data + \
+                (y - _cursor->cy) * w + (area.x1 - _cursor->cx);
+            for (x = area.x1; x < area.x2; x++, pixel++) {
+                if (!RTGUI_RGB_A(*pixel)) continue;
+                native = rtgui_gfx_color_to_native(*pixel);
+                switch (drv->bits_per_pixel) {
+                case 1:
+                    /* one byte per column in each 8-line page */
+                    ptr = drv->front_buffer + (y >> 3) * drv->width + x;
+                    if (native != black)
+                        *ptr |= 1 << (y & 0x07);
+                    else
+                        *ptr &= ~(1 << (y & 0x07));
+                    break;
+                case 16:
+                    ptr = drv->front_buffer + y * drv->pitch + x * 2;
+                    *(rt_uint16_t *)ptr = (rt_uint16_t)native;
+                    break;
+                case 32:
+                    ptr = drv->front_buffer + y * drv->pitch + x * 4;
+                    *(rt_uint32_t *)ptr = native;
+                    break;
+                default:
+                    return;
+                }
+            }
+        }
+    }
+    #endif /* RTGUI_USING_DOUBLE_BUFFER */
 #endif /* RTGUI_USING_CURSOR */
 
 #ifdef RTGUI_USING_WINMOVE
@@ -273,6 +273,10 @@ static rt_bool_t _server_event_handler(void *obj, rtgui_evt_generic_t *evt) {
     case RTGUI_EVENT_COMMAND:
         break;
 
+    case RTGUI_EVENT_UPDATE_FLUSH:
+        /* flushed below */
+        break;
+
     case RTGUI_EVENT_UPDATE_BEGIN:
         #ifdef RTGUI_USING_CURSOR
             rtgui_cursor_hide();
@@ -284,8 +288,7 @@ static rt_bool_t _server_event_handler(void *obj, rtgui_evt_generic_t *evt) {
             /* handle screen update */
             rtgui_gfx_driver_t *drv = rtgui_get_gfx_device();
             if (drv) {
-                rtgui_gfx_update_screen(drv,
-                    &(evt->update_end.rect));
+                rtgui_gfx_damage_add(drv, &(evt->update_end.rect));
             }
             #ifdef RTGUI_USING_CURSOR
                 rtgui_cursor_show();
@@ -322,6 +325,8 @@ static rt_bool_t _server_event_handler(void *obj, rtgui_evt_generic_t *evt) {
         rtgui_response(evt, ack);
         RTGUI_FREE_EVENT(evt);
     }
+    /* frame boundary: no more pending event or damage is old enough */
+    rtgui_gfx_damage_flush(rtgui_get_gfx_device(), !_srv_app->mb->entry);
     return done;    // who care server handler return value?
 }
 
@@ -45,13 +45,12 @@
 #ifndef RTGUI_LOG_EVENT
 # define rtgui_log_event(tgt, evt)
 #endif
-// #define RTGUI_MEM_TRACE
 #define SYNC_ACK_NUMBER             (1)
 
 /* Private variables ---------------------------------------------------------*/
 static struct rt_mutex _screen_lock;
 static struct rt_mailbox ack_sync;
-static rt_uint8_t ack_pool[SYNC_ACK_NUMBER];
+static rt_ubase_t ack_pool[SYNC_ACK_NUMBER];
 static rtgui_event_timer_t _timer_evt = {
     .base = {
         .type = RTGUI_EVENT_TIMER,
@@ -183,11 +182,7 @@ RTM_EXPORT(rtgui_timer_stop);
 /* RTGUI Memory Management                                              */
 /************************************************************************/
 #ifdef RTGUI_MEM_TRACE
-struct rtgui_mem_info {
-    rt_uint32_t allocated_size;
-    rt_uint32_t max_allocated;
-};
-struct rtgui_mem_info mem_info;
+rtgui_mem_info_t mem_info;
 
 #define MEMTRACE_MAX        4096
 #define MEMTRACE_HASH_SIZE  256
@@ -213,7 +208,7 @@ void rti_memtrace_init(void) {
     item_free = &trace_list[0];
     item = &trace_list[0];
 
-    for (index = 1; index < MEMTRACE_HASH_SIZE; index ++) {
+    for (index = 1; index < MEMTRACE_MAX; index ++) {
         item->next = &trace_list[index];
         item = item->next;
     }
@@ -225,6 +220,7 @@ void rti_malloc_hook(void *ptr, rt_uint32_t len) {
     rt_uint32_t index;
     struct rti_memtrace_item *item;
 
+    mem_info.alloc_count++;
     if (RT_NULL == item_free) return;
 
     mem_info.allocated_size += len;
@@ -257,6 +253,7 @@ void rti_free_hook(void *ptr) {
     rt_uint32_t index;
     struct rti_memtrace_item *item;
 
+    mem_info.free_count++;
     /* get hash item index */
     index = ((rt_uint32_t)ptr) % MEMTRACE_HASH_SIZE;
     if (RT_NULL != item_hash[index]) {
@@ -338,12 +335,41 @@ void rtgui_free(void *ptr) {
 RTM_EXPORT(rtgui_free);
 
 
+#ifdef RTGUI_MEM_TRACE
+void rtgui_mem_get_info(rtgui_mem_info_t *info) {
+    *info = mem_info;
+}
+RTM_EXPORT(rtgui_mem_get_info);
+
+/* called by object pools, a miss is followed by rtgui_malloc() */
+void rtgui_mem_pool_alloc_hook(rt_bool_t hit) {
+    if (!hit) {
+        mem_info.pool_miss_count++;
+        return;
+    }
+    mem_info.pool_alloc_count++;
+    mem_info.pool_used++;
+    if (mem_info.pool_max_used < mem_info.pool_used)
+        mem_info.pool_max_used = mem_info.pool_used;
+}
+RTM_EXPORT(rtgui_mem_pool_alloc_hook);
+
+void rtgui_mem_pool_free_hook(void) {
+    mem_info.pool_used--;
+}
+RTM_EXPORT(rtgui_mem_pool_free_hook);
+#endif
+
 #if defined(RTGUI_MEM_TRACE) && defined(RT_USING_FINSH)
 # include "components/finsh/finsh.h"
 
 void list_guimem(void) {
-    rt_kprintf("Current Used: %d, Maximal Used: %d\n",
-        mem_info.allocated_size, mem_info.max_allocated);
+    rt_kprintf("Current Used: %d, Maximal Used: %d, Alloc: %d, Free: %d\n",
+        mem_info.allocated_size, mem_info.max_allocated,
+        mem_info.alloc_count, mem_info.free_count);
+    rt_kprintf("Pool Used: %d, Maximal Used: %d, Alloc: %d, Miss: %d\n",
+        mem_info.pool_used, mem_info.pool_max_used,
+        mem_info.pool_alloc_count, mem_info.pool_miss_count);
 }
 FINSH_FUNCTION_EXPORT(list_guimem, display memory information);
 #endif
@@ -390,6 +416,7 @@ const char *rtgui_event_text(rtgui_evt_generic_t *evt) {
     case RTGUI_EVENT_TIMER:         return "<EVT>Timer";
     /* clip rect information */
     case RTGUI_EVENT_CLIP_INFO:     return "<EVT>ClipInfo";
+    case RTGUI_EVENT_UPDATE_FLUSH:  return "<EVT>UpdateFlush";
     /* mouse and keyboard event */
     case RTGUI_EVENT_MOUSE_MOTION:  return "<Mouse>Motion";
     case RTGUI_EVENT_MOUSE_BUTTON:  return "<Mouse>Button";
@@ -423,3 +423,329 @@ rtgui_blit_line_func rtgui_get_blit_line_func(rt_uint8_t src_fmt,
 
     return RT_NULL;
 }
+
+/* Source-over blending kernels: d = s * a + d * (1 - a). Alpha 0 keeps the
+   destination and alpha 255 overwrites it. */
+#if (CONFIG_USING_RGB565 || CONFIG_USING_RGB565P)
+/* Two 565 pixels in one 32-bit word are split into two sets of lanes, each
+   field has 5 spare bits above it to hold the product of 5-bit alpha:
+   - LO: B0, R0 and G1 of the word
+   - HI: G0, B1 and R1 of the word shifted right by 5 */
+#define BLEND_565_LO                (0x07e0f81fUL)
+#define BLEND_565_HI                (0x07c0f83fUL)
+/* 8-bit alpha to 5-bit, 0 to 32 */
+#define BLEND_ALPHA5(c)             ((RTGUI_RGB_A(c) + 4) >> 3)
+
+/* byte swap of RTGUI_BIG_ENDIAN_OUTPUT, "swap" is a constant */
+rt_inline rt_uint16_t _blend_swap16(rt_bool_t swap, rt_uint32_t p) {
+    p &= 0xffff;
+    return swap ? (rt_uint16_t)((p << 8) | (p >> 8)) : (rt_uint16_t)p;
+}
+
+rt_inline rt_uint32_t _blend_swap32(rt_bool_t swap, rt_uint32_t p) {
+    return swap ? (((p & 0x00ff00ffUL) << 8) | ((p >> 8) & 0x00ff00ffUL)) : p;
+}
+
+/* "s_lo" and "s_hi" are the source lanes premultiplied by alpha */
+rt_inline rt_uint32_t _blend_565x2(rt_uint32_t s_lo, rt_uint32_t s_hi,
+    rt_uint32_t d, rt_uint32_t ia) {
+    rt_uint32_t lo, hi;
+
+    lo = ((s_lo + (d & BLEND_565_LO) * ia) >> 5) & BLEND_565_LO;
+    hi = ((s_hi + ((d >> 5) & BLEND_565_HI) * ia) >> 5) & BLEND_565_HI;
+    return lo | (hi << 5);
+}
+
+/* "s" and "d" are in RRRRRGGGGGGBBBBB (or BGR) order, "a" is 5-bit */
+rt_inline rt_uint16_t _blend_565(rt_uint32_t s, rt_uint32_t d, rt_uint32_t a) {
+    s = (s | (s << 16)) & BLEND_565_LO;
+    d = (d | (d << 16)) & BLEND_565_LO;
+    d = ((s * a + d * (32 - a)) >> 5) & BLEND_565_LO;
+    return (rt_uint16_t)(d | (d >> 16));
+}
+
+rt_inline void _blend_fill_565(rt_uint16_t *dst, rt_uint32_t src,
+    rt_uint32_t a, rt_uint32_t len, rt_bool_t swap) {
+    rt_uint32_t s_lo, s_hi, ia;
+
+    if (!a || !len) return;
+    if (a >= 32) {
+        src = _blend_swap16(swap, src);
+        while (len--) *dst++ = (rt_uint16_t)src;
+        return;
+    }
+
+    src |= src << 16;
+    s_lo = (src & BLEND_565_LO) * a;
+    s_hi = ((src >> 5) & BLEND_565_HI) * a;
+    ia = 32 - a;
+
+    /* align to word */
+    if ((rt_ubase_t)dst & 0x02) {
+        *dst = _blend_swap16(swap, _blend_565x2(s_lo, s_hi,
+            _blend_swap16(swap, *dst), ia));
+        dst++;
+        len--;
+    }
+    for (; len >= 2; len -= 2, dst += 2) {
+        rt_uint32_t d = _blend_swap32(swap, *(rt_uint32_t *)dst);
+
+        *(rt_uint32_t *)dst = _blend_swap32(swap,
+            _blend_565x2(s_lo, s_hi, d, ia));
+    }
+    if (len)
+        *dst = _blend_swap16(swap, _blend_565x2(s_lo, s_hi,
+            _blend_swap16(swap, *dst), ia));
+}
+#endif /* CONFIG_USING_RGB565 || CONFIG_USING_RGB565P */
+
+#if (CONFIG_USING_RGB565)
+#ifdef RTGUI_BIG_ENDIAN_OUTPUT
+# define BLEND_565_SWAP             RT_TRUE
+#else
+# define BLEND_565_SWAP             RT_FALSE
+#endif
+
+/* unlike rtgui_color_to_565(), not swapped */
+rt_inline rt_uint32_t _to_565(rtgui_color_t c) {
+    return ((RTGUI_RGB_R(c) >> 3) << 11) | ((RTGUI_RGB_G(c) >> 2) << 5) | \
+           (RTGUI_RGB_B(c) >> 3);
+}
+
+static void blend_fill_rgb565(rt_uint8_t *dst, rtgui_color_t color,
+    rt_uint32_t len) {
+    _blend_fill_565((rt_uint16_t *)dst, _to_565(color), BLEND_ALPHA5(color),
+        len, BLEND_565_SWAP);
+}
+
+static void blend_line_rgb565(rt_uint8_t *_dst, const rtgui_color_t *src,
+    rt_uint32_t len) {
+    rt_uint16_t *dst = (rt_uint16_t *)_dst;
+    rt_uint32_t a;
+
+    for (; len; len--, src++, dst++) {
+        a = BLEND_ALPHA5(*src);
+        if (!a) continue;
+        if (a >= 32)
+            *dst = _blend_swap16(BLEND_565_SWAP, _to_565(*src));
+        else
+            *dst = _blend_swap16(BLEND_565_SWAP, _blend_565(_to_565(*src),
+                _blend_swap16(BLEND_565_SWAP, *dst), a));
+    }
+}
+#endif /* CONFIG_USING_RGB565 */
+
+#if (CONFIG_USING_RGB565P)
+static void blend_fill_rgb565p(rt_uint8_t *dst, rtgui_color_t color,
+    rt_uint32_t len) {
+    _blend_fill_565((rt_uint16_t *)dst, rtgui_color_to_565p(color),
+        BLEND_ALPHA5(color), len, RT_FALSE);
+}
+
+static void blend_line_rgb565p(rt_uint8_t *_dst, const rtgui_color_t *src,
+    rt_uint32_t len) {
+    rt_uint16_t *dst = (rt_uint16_t *)_dst;
+    rt_uint32_t a;
+
+    for (; len; len--, src++, dst++) {
+        a = BLEND_ALPHA5(*src);
+        if (!a) continue;
+        if (a >= 32)
+            *dst = rtgui_color_to_565p(*src);
+        else
+            *dst = _blend_565(rtgui_color_to_565p(*src), *dst, a);
+    }
+}
+#endif /* CONFIG_USING_RGB565P */
+
+#if (CONFIG_USING_RGB888 || CONFIG_USING_ARGB888)
+/* 8-bit alpha to 0 - 256 */
+#define BLEND_ALPHA8(c)             (RTGUI_RGB_A(c) + (RTGUI_RGB_A(c) >> 7))
+
+/* red and blue are blended together, the result is opaque */
+rt_inline rt_uint32_t _blend_8888(rt_uint32_t s_rb, rt_uint32_t s_g,
+    rt_uint32_t d, rt_uint32_t ia) {
+    rt_uint32_t rb, g;
+
+    rb = ((s_rb + (d & 0xff00ff) * ia) >> 8) & 0xff00ff;
+    g = ((s_g + (d & 0x00ff00) * ia) >> 8) & 0x00ff00;
+    return 0xff000000 | rb | g;
+}
+
+#if (CONFIG_USING_ARGB888) || (RTGUI_RGB888_PIXEL_BITS == 32)
+static void blend_fill_32(rt_uint8_t *_dst, rtgui_color_t color,
+    rt_uint32_t len) {
+    rt_uint32_t *dst = (rt_uint32_t *)_dst;
+    rt_uint32_t a = BLEND_ALPHA8(color);
+    rt_uint32_t s_rb, s_g, ia;
+
+    if (!a) return;
+    if (a >= 256) {
+        color |= 0xff000000;
+        while (len--) *dst++ = color;
+        return;
+    }
+
+    s_rb = (color & 0xff00ff) * a;
+    s_g = (color & 0x00ff00) * a;
+    ia = 256 - a;
+    for (; len; len--, dst++)
+        *dst = _blend_8888(s_rb, s_g, *dst, ia);
+}
+
+static void blend_line_32(rt_uint8_t *_dst, const rtgui_color_t *src,
+    rt_uint32_t len) {
+    rt_uint32_t *dst = (rt_uint32_t *)_dst;
+    rt_uint32_t a;
+
+    for (; len; len--, src++, dst++) {
+        a = BLEND_ALPHA8(*src);
+        if (!a) continue;
+        if (a >= 256)
+            *dst = *src;
+        else
+            *dst = _blend_8888((*src & 0xff00ff) * a, (*src & 0x00ff00) * a,
+                *dst, 256 - a);
+    }
+}
+#endif
+
+#if (CONFIG_USING_RGB888) && (RTGUI_RGB888_PIXEL_BITS == 24)
+/* bytes are in R, G, B order, see RGB888_FROM_RGB() */
+static void blend_fill_24(rt_uint8_t *dst, rtgui_color_t color,
+    rt_uint32_t len) {
+    rt_uint32_t a = BLEND_ALPHA8(color);
+    rt_uint32_t s_r, s_g, s_b, ia;
+
+    if (!a) return;
+    if (a >= 256) a = 256;
+    s_r = RTGUI_RGB_R(color) * a;
+    s_g = RTGUI_RGB_G(color) * a;
+    s_b = RTGUI_RGB_B(color) * a;
+    ia = 256 - a;
+    for (; len; len--, dst += 3) {
+        dst[0] = (rt_uint8_t)((s_r + dst[0] * ia) >> 8);
+        dst[1] = (rt_uint8_t)((s_g + dst[1] * ia) >> 8);
+        dst[2] = (rt_uint8_t)((s_b + dst[2] * ia) >> 8);
+    }
+}
+
+static void blend_line_24(rt_uint8_t *dst, const rtgui_color_t *src,
+    rt_uint32_t len) {
+    rt_uint32_t a, ia;
+
+    for (; len; len--, src++, dst += 3) {
+        a = BLEND_ALPHA8(*src);
+        if (!a) continue;
+        ia = 256 - a;
+        dst[0] = (rt_uint8_t)((RTGUI_RGB_R(*src) * a + dst[0] * ia) >> 8);
+        dst[1] = (rt_uint8_t)((RTGUI_RGB_G(*src) * a + dst[1] * ia) >> 8);
+        dst[2] = (rt_uint8_t)((RTGUI_RGB_B(*src) * a + dst[2] * ia) >> 8);
+    }
+}
+#endif
+#endif /* CONFIG_USING_RGB888 || CONFIG_USING_ARGB888 */
+
+rtgui_blend_fill_func rtgui_get_blend_fill_func(rt_uint8_t dst_fmt) {
+    switch (dst_fmt) {
+    #if (CONFIG_USING_RGB565)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return blend_fill_rgb565;
+    #endif
+
+    #if (CONFIG_USING_RGB565P)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return blend_fill_rgb565p;
+    #endif
+
+    #if (CONFIG_USING_RGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        #if (RTGUI_RGB888_PIXEL_BITS == 32)
+            return blend_fill_32;
+        #else
+            return blend_fill_24;
+        #endif
+    #endif
+
+    #if (CONFIG_USING_ARGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return blend_fill_32;
+    #endif
+
+    default:
+        /* no kernel for MONO and indexed formats */
+        return RT_NULL;
+    }
+}
+
+rtgui_blend_line_func rtgui_get_blend_line_func(rt_uint8_t dst_fmt) {
+    switch (dst_fmt) {
+    #if (CONFIG_USING_RGB565)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return blend_line_rgb565;
+    #endif
+
+    #if (CONFIG_USING_RGB565P)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return blend_line_rgb565p;
+    #endif
+
+    #if (CONFIG_USING_RGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        #if (RTGUI_RGB888_PIXEL_BITS == 32)
+            return blend_line_32;
+        #else
+            return blend_line_24;
+        #endif
+    #endif
+
+    #if (CONFIG_USING_ARGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return blend_line_32;
+    #endif
+
+    default:
+        return RT_NULL;
+    }
+}
+
+/* ARGB "color" to the native pixel of "dst_fmt". For 565 formats "dither"
+   (0 - 15, an ordered dither threshold) is added in proportion to the
+   truncated bits, 0 is plain truncation. */
+rtgui_color_t rtgui_blit_pixel(rt_uint8_t dst_fmt, rtgui_color_t color,
+    rt_uint8_t dither) {
+    switch (dst_fmt) {
+    #if (CONFIG_USING_MONO)
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        return rtgui_color_to_mono(color);
+    #endif
+
+    #if (CONFIG_USING_RGB565 || CONFIG_USING_RGB565P)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        if (dither) {
+            rt_uint32_t r, g, b;
+
+            /* 3 bits truncated from R and B, 2 bits from G */
+            r = _MIN(RTGUI_RGB_R(color) + (dither >> 1), 0xff);
+            g = _MIN(RTGUI_RGB_G(color) + (dither >> 2), 0xff);
+            b = _MIN(RTGUI_RGB_B(color) + (dither >> 1), 0xff);
+            color = RTGUI_ARGB(RTGUI_RGB_A(color), r, g, b);
+        }
+        #if (CONFIG_USING_RGB565)
+            if (RTGRAPHIC_PIXEL_FORMAT_RGB565 == dst_fmt)
+                return rtgui_color_to_565(color);
+        #endif
+        return rtgui_color_to_565p(color);
+    #endif
+
+    #if (CONFIG_USING_RGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return rtgui_color_to_888(color);
+    #endif
+
+    default:
+        (void)dither;
+        return color;
+    }
+}
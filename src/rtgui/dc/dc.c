@@ -25,11 +25,10 @@
  * 2011-04-25     Bernard      fix fill polygon issue, which found by loveic
  */
 
-#include <stdlib.h> /* fir qsort  */
-#include <math.h>   /* for sin/cos etc */
 
 #include "include/rtgui.h"
 #include "include/font/font.h"
+#include "include/blit.h"
 
 #ifdef RT_USING_ULOG
 # define LOG_LVL                    RTGUI_LOG_LEVEL
@@ -40,9 +39,9 @@
 # define LOG_D                      LOG_E
 #endif /* RT_USING_ULOG */
 
-static int _int_compare(const void *a, const void *b) {
-    return (*(const int *) a) - (*(const int *) b);
-}
+static void _fill_round_spans(rtgui_dc_t *dc, int x1, int y1, int x2, int y2,
+    int r);
+
 
 void rtgui_dc_destory(rtgui_dc_t *dc)
 {
@@ -53,10 +52,141 @@ void rtgui_dc_destory(rtgui_dc_t *dc)
 }
 RTM_EXPORT(rtgui_dc_destory);
 
+void rtgui_dc_span_batch_init(rtgui_span_batch_t *batch, rtgui_dc_t *dc,
+    rtgui_color_t *color) {
+    batch->dc = dc;
+    batch->color = color;
+    batch->num = 0;
+}
+RTM_EXPORT(rtgui_dc_span_batch_init);
+
+void rtgui_dc_span_batch_add(rtgui_span_batch_t *batch, int x1, int x2,
+    int y) {
+    rtgui_span_t *span = &batch->spans[batch->num];
+
+    span->x1 = x1;
+    span->x2 = x2;
+    span->y = y;
+    if (++batch->num >= RTGUI_SPAN_BATCH_SIZE)
+        rtgui_dc_span_batch_flush(batch);
+}
+RTM_EXPORT(rtgui_dc_span_batch_add);
+
+void rtgui_dc_span_batch_flush(rtgui_span_batch_t *batch) {
+    if (!batch->num) return;
+    batch->dc->engine->draw_hspans(batch->dc, batch->color, batch->spans,
+        batch->num);
+    batch->num = 0;
+}
+RTM_EXPORT(rtgui_dc_span_batch_flush);
+
+/* intersect logic "box" with the visible extents of "dc", once per call
+   instead of per pixel or span */
+static rt_bool_t _dc_clip_box(rtgui_dc_t *dc, rtgui_rect_t *box) {
+    rtgui_rect_t ext;
+
+    switch (dc->type) {
+    case RTGUI_DC_CLIENT:
+    {
+        rtgui_widget_t *owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+
+        ext = *rtgui_region_extents(&owner->clip);
+        rtgui_rect_move(&ext, -owner->extent.x1, -owner->extent.y1);
+        break;
+    }
+
+    case RTGUI_DC_HW:
+    {
+        rtgui_widget_t *owner = ((struct rtgui_dc_hw *)dc)->owner;
+
+        rtgui_gfx_get_rect(rtgui_get_gfx_device(), &ext);
+        rtgui_rect_intersect(&owner->extent, &ext);
+        rtgui_rect_move(&ext, -owner->extent.x1, -owner->extent.y1);
+        break;
+    }
+
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+    {
+        struct rtgui_dc_buffer *buf = (struct rtgui_dc_buffer *)dc;
+
+        rtgui_rect_set(&ext, 0, 0, buf->width, buf->height);
+        break;
+    }
+    #endif
+
+    default:
+        LOG_E("bad dc type %d", dc->type);
+        return RT_FALSE;
+    }
+
+    rtgui_rect_intersect(&ext, box);
+    return (box->x1 < box->x2) && (box->y1 < box->y2);
+}
+
+#define _MONO_BIT(bits, pos)            \
+    ((bits)[(pos) >> 3] & (0x80 >> ((pos) & 0x07)))
+
+static void _mono_add_run(rtgui_span_batch_t *fg, rtgui_span_batch_t *bg,
+    rt_bool_t set, int x1, int x2, int y) {
+    if (set)
+        rtgui_dc_span_batch_add(fg, x1, x2, y);
+    else if (bg)
+        rtgui_dc_span_batch_add(bg, x1, x2, y);
+}
+
+void rtgui_dc_draw_mono_mask(rtgui_dc_t *dc, int x, int y, int w, int h,
+    const rt_uint8_t *bits, rt_uint32_t pitch) {
+    rtgui_span_batch_t fg, bg, *pbg;
+    rtgui_color_t bc;
+    rtgui_rect_t box;
+    rt_uint32_t pos;
+    int row, col, start;
+    rt_bool_t set, last;
+
+    if (!dc || !rtgui_dc_get_visible(dc)) return;
+
+    /* skip the clipped rows and columns without decoding them */
+    rtgui_rect_set(&box, x, y, w, h);
+    if (!_dc_clip_box(dc, &box)) return;
+
+    bc = RTGUI_DC_BC(dc);
+    pbg = (rtgui_dc_get_gc(dc)->textstyle & RTGUI_TEXTSTYLE_DRAW_BACKGROUND) ?
+        &bg : RT_NULL;
+    rtgui_dc_span_batch_init(&fg, dc, RT_NULL);
+    rtgui_dc_span_batch_init(&bg, dc, &bc);
+
+    for (row = box.y1; row < box.y2; row++) {
+        /* one span for each run of the same color */
+        pos = (row - y) * pitch + (box.x1 - x);
+        last = _MONO_BIT(bits, pos) ? RT_TRUE : RT_FALSE;
+        for (col = box.x1 + 1, start = box.x1; col < box.x2; col++) {
+            pos++;
+            set = _MONO_BIT(bits, pos) ? RT_TRUE : RT_FALSE;
+            if (set == last) continue;
+            _mono_add_run(&fg, pbg, last, start, col, row);
+            start = col;
+            last = set;
+        }
+        _mono_add_run(&fg, pbg, last, start, box.x2, row);
+    }
+    rtgui_dc_span_batch_flush(&fg);
+    rtgui_dc_span_batch_flush(&bg);
+}
+RTM_EXPORT(rtgui_dc_draw_mono_mask);
+
 void rtgui_dc_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2)
 {
     if (dc == RT_NULL) return;
 
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc))
+    {
+        rtgui_dc_aa_draw_line(dc, x1, y1, x2, y2);
+        return;
+    }
+#endif
+
     if (y1 == y2)
     {
         rtgui_dc_draw_hline(dc, x1, x2, y1);
@@ -219,34 +349,18 @@ RTM_EXPORT(rtgui_dc_draw_round_rect);
 
 void rtgui_dc_fill_round_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int r)
 {
-    rtgui_rect_t rect_temp;
-
     RT_ASSERT(((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r));
 
     if (((rect->x2 - rect->x1) / 2 >= r) && ((rect->y2 - rect->y1) / 2 >= r))
     {
-        rect_temp.x1 = rect->x1 + r;
-        rect_temp.y1 = rect->y1;
-        rect_temp.x2 = rect->x2 - r;
-        rect_temp.y2 = rect->y2;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rect_temp.x1 = rect->x1;
-        rect_temp.y1 = rect->y1 + r;
-        rect_temp.x2 = rect->x1 + r;
-        rect_temp.y2 = rect->y2 - r;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rect_temp.x1 = rect->x2 - r;
-        rect_temp.y1 = rect->y1 + r;
-        rect_temp.x2 = rect->x2;
-        rect_temp.y2 = rect->y2 - r;
-        rtgui_dc_fill_rect_forecolor(dc, &rect_temp);//fill rect with foreground
-
-        rtgui_dc_fill_circle(dc, rect->x1 + r, rect->y1 + r, r);
-        rtgui_dc_fill_circle(dc, rect->x2 - r, rect->y2 - r, r);
-        rtgui_dc_fill_circle(dc, rect->x2 - r, rect->y1 + r, r);
-        rtgui_dc_fill_circle(dc, rect->x1 + r, rect->y2 - r, r);
+        /* keep the corner centers apart, or the corners would overlap */
+        r = _MIN(r, (rect->x2 - rect->x1 - 1) / 2);
+        r = _MIN(r, (rect->y2 - rect->y1 - 1) / 2);
+        if (r < 0)
+            return;
+
+        _fill_round_spans(dc, rect->x1 + r, rect->y1 + r,
+            rect->x2 - 1 - r, rect->y2 - 1 - r, r);
     }
 }
 RTM_EXPORT(rtgui_dc_fill_round_rect);
@@ -265,31 +379,239 @@ void rtgui_dc_draw_shaded_rect(rtgui_dc_t *dc, rtgui_rect_t *rect,
 }
 RTM_EXPORT(rtgui_dc_draw_shaded_rect);
 
+/* Gradient fills: the colors are interpolated once into a ramp, which is
+   converted to native pixels (or per pixel if dithered) and streamed row by
+   row through "blit_line". Translucent colors with "RTGUI_DRAWSTYLE_BLEND"
+   go through "blend_line" instead. */
+typedef struct rtgui_gradient {
+    rtgui_dc_t *dc;
+    rt_uint8_t fmt;
+    rt_uint8_t bpp;                     /* bytes per pixel, 0 for ARGB line */
+    rt_bool_t blend;
+    rt_bool_t dither;
+    rtgui_color_t *ramp;                /* ARGB */
+    rt_uint8_t *native;                 /* RT_NULL if dithered */
+    rt_uint8_t *line;
+} rtgui_gradient_t;
+
+/* 4x4 ordered dither thresholds */
+static const rt_uint8_t _dither_4x4[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+rt_inline void _gradient_store(rt_uint8_t *ptr, rt_uint8_t bpp,
+    rtgui_color_t pixel) {
+    switch (bpp) {
+    case 2:
+        *(rt_uint16_t *)ptr = (rt_uint16_t)pixel;
+        break;
+
+    case 3:
+        /* same as dc buffer */
+        ptr[0] = (pixel >> 16) & 0xff;
+        ptr[1] = (pixel >> 8) & 0xff;
+        ptr[2] = pixel & 0xff;
+        break;
+
+    default:
+        *(rt_uint32_t *)ptr = pixel;
+        break;
+    }
+}
+
+/* set pixel "i" of the line to ramp entry "idx", (x, y) picks the threshold
+   of dither */
+rt_inline void _gradient_put(rtgui_gradient_t *g, rt_uint32_t i, int x, int y,
+    rt_uint32_t idx) {
+    rt_uint8_t *ptr;
+
+    if (!g->bpp) {
+        ((rtgui_color_t *)g->line)[i] = g->ramp[idx];
+        return;
+    }
+
+    ptr = g->line + i * g->bpp;
+    if (g->native) {
+        rt_memcpy(ptr, g->native + idx * g->bpp, g->bpp);
+        return;
+    }
+    _gradient_store(ptr, g->bpp, rtgui_blit_pixel(g->fmt, g->ramp[idx],
+        _dither_4x4[y & 0x03][x & 0x03]));
+}
+
+/* draw the line, x2 is exclusive */
+static void _gradient_flush(rtgui_gradient_t *g, int x1, int x2, int y) {
+    const rtgui_color_t *argb = (const rtgui_color_t *)g->line;
+
+    if (g->bpp) {
+        g->dc->engine->blit_line(g->dc, x1, x2, y, g->line);
+    } else if (g->blend) {
+        rtgui_dc_blend_line(g->dc, x1, x2, y, argb);
+    } else {
+        /* less than a byte per pixel */
+        for (; x1 < x2; x1++)
+            rtgui_dc_draw_color_point(g->dc, x1, y, *argb++);
+    }
+}
+
+/* "num" ARGB colors from "c1" to "c2", in 16.16 fixed point */
+static void _gradient_ramp(rtgui_color_t *ramp, rt_uint32_t num,
+    rtgui_color_t c1, rtgui_color_t c2) {
+    rt_int32_t val[4], step[4];
+    rt_uint32_t i, k, shift;
+
+    for (k = 0; k < 4; k++) {
+        shift = 24 - (k << 3);
+        val[k] = (((c1 >> shift) & 0xff) << 16) + 0x8000;
+        step[k] = (rt_int32_t)((c2 >> shift) & 0xff) - \
+                  (rt_int32_t)((c1 >> shift) & 0xff);
+        step[k] = (num > 1) ? step[k] * 65536 / (rt_int32_t)(num - 1) : 0;
+    }
+
+    for (i = 0; i < num; i++) {
+        ramp[i] = RTGUI_ARGB(val[0] >> 16, val[1] >> 16, val[2] >> 16,
+            val[3] >> 16);
+        for (k = 0; k < 4; k++)
+            val[k] += step[k];
+    }
+}
+
+static rt_bool_t _gradient_init(rtgui_gradient_t *g, rtgui_dc_t *dc,
+    rt_uint32_t num, rt_uint32_t width, rtgui_color_t c1, rtgui_color_t c2) {
+    rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+    rt_uint8_t bits;
+    rt_uint32_t i, size;
+
+    g->dc = dc;
+    g->fmt = rtgui_dc_get_pixel_format(dc);
+    #ifdef RTGUI_USING_DC_BUFFER
+        if (RTGUI_DC_BUFFER == dc->type)
+            bits = ((struct rtgui_dc_buffer *)dc)->bits_per_pixel;
+        else
+    #endif
+            bits = rtgui_get_gfx_device()->bits_per_pixel;
+
+    g->blend = RTGUI_GC_IS_BLEND(gc, c1) || RTGUI_GC_IS_BLEND(gc, c2);
+    g->bpp = (g->blend || (bits < 8)) ? 0 : _BIT2BYTE(bits);
+    g->dither = (gc->drawstyle & RTGUI_DRAWSTYLE_DITHER) && \
+        ((RTGRAPHIC_PIXEL_FORMAT_RGB565 == g->fmt) || \
+         (RTGRAPHIC_PIXEL_FORMAT_RGB565P == g->fmt));
+
+    /* ARGB ramp, line and native ramp */
+    size = (num + width) * sizeof(rtgui_color_t);
+    if (g->bpp && !g->dither)
+        size += num * g->bpp;
+    g->ramp = (rtgui_color_t *)rtgui_malloc(size);
+    if (!g->ramp) {
+        LOG_E("no mem for gradient");
+        return RT_FALSE;
+    }
+    g->line = (rt_uint8_t *)(g->ramp + num);
+    g->native = RT_NULL;
+
+    _gradient_ramp(g->ramp, num, c1, c2);
+    if (g->bpp && !g->dither) {
+        g->native = g->line + width * sizeof(rtgui_color_t);
+        for (i = 0; i < num; i++)
+            _gradient_store(g->native + i * g->bpp, g->bpp,
+                rtgui_blit_pixel(g->fmt, g->ramp[i], 0));
+    }
+    return RT_TRUE;
+}
+
+/* fill "rect" from "c1" at the top to "c2" at the bottom */
 void rtgui_dc_fill_gradient_rectv(rtgui_dc_t *dc, rtgui_rect_t *rect,
-                                  rtgui_color_t c1, rtgui_color_t c2)
-{
-    int y, step;
-    rtgui_color_t fc;
+    rtgui_color_t c1, rtgui_color_t c2) {
+    rtgui_gradient_t g;
+    rt_uint32_t i, w;
+    int x, y;
 
     RT_ASSERT(dc != RT_NULL);
     RT_ASSERT(rect != RT_NULL);
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2)) return;
 
-    step = RECT_H(*rect);
-    fc = RTGUI_DC_FC(dc);
+    w = rect->x2 - rect->x1;
+    if (!_gradient_init(&g, dc, rect->y2 - rect->y1, w, c1, c2)) return;
 
-    for (y = rect->y1; y < rect->y2; y++)
-    {
-        RTGUI_DC_FC(dc) = RTGUI_ARGB(((int)RTGUI_RGB_A(c2) - RTGUI_RGB_A(c1)) * (y - rect->y1) / step + RTGUI_RGB_A(c1),
-                                     ((int)RTGUI_RGB_R(c2) - RTGUI_RGB_R(c1)) * (y - rect->y1) / step + RTGUI_RGB_R(c1),
-                                     ((int)RTGUI_RGB_G(c2) - RTGUI_RGB_G(c1)) * (y - rect->y1) / step + RTGUI_RGB_G(c1),
-                                     ((int)RTGUI_RGB_B(c2) - RTGUI_RGB_B(c1)) * (y - rect->y1) / step + RTGUI_RGB_B(c1));
-        rtgui_dc_draw_hline(dc, rect->x1, rect->x2, y);
+    for (y = rect->y1, i = 0; y < rect->y2; y++, i++) {
+        if (g.blend) {
+            rtgui_dc_blend_hline(dc, rect->x1, rect->x2, y, g.ramp[i]);
+            continue;
+        }
+        /* the line is reused until the native pixel changes */
+        if (!g.native || !i || rt_memcmp(g.native + i * g.bpp,
+            g.native + (i - 1) * g.bpp, g.bpp))
+            for (x = rect->x1; x < rect->x2; x++)
+                _gradient_put(&g, x - rect->x1, x, y, i);
+        _gradient_flush(&g, rect->x1, rect->x2, y);
     }
 
-    RTGUI_DC_FC(dc) = fc;
+    rtgui_free(g.ramp);
 }
 RTM_EXPORT(rtgui_dc_fill_gradient_rectv);
 
+/* fill "rect" from "c1" at the left to "c2" at the right */
+void rtgui_dc_fill_gradient_recth(rtgui_dc_t *dc, rtgui_rect_t *rect,
+    rtgui_color_t c1, rtgui_color_t c2) {
+    rtgui_gradient_t g;
+    rt_uint32_t w;
+    int x, y;
+
+    RT_ASSERT(dc != RT_NULL);
+    RT_ASSERT(rect != RT_NULL);
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2)) return;
+
+    w = rect->x2 - rect->x1;
+    if (!_gradient_init(&g, dc, w, w, c1, c2)) return;
+
+    for (y = rect->y1; y < rect->y2; y++) {
+        /* only dither changes the line */
+        if ((y == rect->y1) || g.dither)
+            for (x = rect->x1; x < rect->x2; x++)
+                _gradient_put(&g, x - rect->x1, x, y, x - rect->x1);
+        _gradient_flush(&g, rect->x1, rect->x2, y);
+    }
+
+    rtgui_free(g.ramp);
+}
+RTM_EXPORT(rtgui_dc_fill_gradient_recth);
+
+/* fill "rect" from "c1" at (x, y) to "c2" at radius "r" and beyond */
+void rtgui_dc_fill_gradient_radial(rtgui_dc_t *dc, rtgui_rect_t *rect,
+    int x, int y, int r, rtgui_color_t c1, rtgui_color_t c2) {
+    rtgui_gradient_t g;
+    rt_uint32_t w, d, d2;
+    int px, py, dx, dy;
+
+    RT_ASSERT(dc != RT_NULL);
+    RT_ASSERT(rect != RT_NULL);
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2) || (r < 0)) return;
+
+    w = rect->x2 - rect->x1;
+    if (!_gradient_init(&g, dc, r + 1, w, c1, c2)) return;
+
+    for (py = rect->y1; py < rect->y2; py++) {
+        dy = py - y;
+        dx = rect->x1 - x;
+        /* the distance changes at most 1 per pixel, walk it from a lower
+           bound instead of taking square root */
+        d = _MAX(_ABS(dx), _ABS(dy));
+        for (px = rect->x1; px < rect->x2; px++, dx++) {
+            d2 = dx * dx + dy * dy;
+            while ((d + 1) * (d + 1) <= d2) d++;
+            while (d * d > d2) d--;
+            _gradient_put(&g, px - rect->x1, px, py, _MIN(d, (rt_uint32_t)r));
+        }
+        _gradient_flush(&g, rect->x1, rect->x2, py);
+    }
+
+    rtgui_free(g.ramp);
+}
+RTM_EXPORT(rtgui_dc_fill_gradient_radial);
+
 void rtgui_dc_draw_focus_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
     rt_int16_t x, y;
 
@@ -323,6 +645,29 @@ void rtgui_dc_draw_text(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect) {
 }
 RTM_EXPORT(rtgui_dc_draw_text);
 
+/* draw "text" through "layout", which is rebuilt only if the font changed */
+void rtgui_dc_draw_text_layout(rtgui_dc_t *dc, const char *text,
+    rtgui_text_layout_t *layout, rtgui_rect_t *rect) {
+    rtgui_font_t *font;
+
+    RT_ASSERT(dc != RT_NULL);
+
+    font = RTGUI_DC_FONT(dc);
+    if (!font) {
+        /* use system default font */
+        font = rtgui_font_default();
+    }
+
+    if (layout->font != font) {
+        if (RT_EOK != rtgui_text_layout_build(layout, font, text)) {
+            if (text) rtgui_dc_draw_text(dc, text, rect);
+            return;
+        }
+    }
+    rtgui_text_layout_draw(layout, dc, rect);
+}
+RTM_EXPORT(rtgui_dc_draw_text_layout);
+
 void rtgui_dc_draw_text_stroke(rtgui_dc_t *dc, const char *text, rtgui_rect_t *rect,
                                rtgui_color_t color_stroke, rtgui_color_t color_core)
 {
@@ -463,96 +808,127 @@ void rtgui_dc_draw_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int cou
 }
 RTM_EXPORT(rtgui_dc_draw_polygon);
 
-void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy, int count)
-{
-    int i;
-    int y, xa, xb;
-    int miny, maxy;
-    int x1, y1;
-    int x2, y2;
-    int ind1, ind2;
-    int ints;
-    int *poly_ints = RT_NULL;
+/* polygon edge, x in 16.16 fixed point and stepped once per scanline */
+typedef struct rtgui_poly_edge {
+    int x;
+    int dx;
+    int ymin;
+    int ymax;
+    int dir;
+} rtgui_poly_edge_t;
+
+void rtgui_dc_fill_polygon_rule(rtgui_dc_t *dc, const int *vx, const int *vy,
+    int count, rtgui_fill_rule_t rule) {
+    rtgui_poly_edge_t *edges, **ael, *e;
+    rtgui_span_batch_t batch;
+    int i, j, num, next, active;
+    int y, maxy, xa, xb, wind;
 
-    /*
-     * Sanity check number of edges
-     */
     if (count < 3) return;
 
-    /*
-     * Allocate temp array, only grow array
-     */
-    poly_ints = (int *) rtgui_malloc(sizeof(int) * count);
-    if (poly_ints == RT_NULL) return ; /* no memory, failed */
-
-    /*
-     * Determine Y maximal
-     */
-    miny = vy[0];
-    maxy = vy[0];
-    for (i = 1; (i < count); i++)
-    {
-        if (vy[i] < miny) miny = vy[i];
-        else if (vy[i] > maxy) maxy = vy[i];
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc)) {
+        rtgui_dc_aa_fill_polygon(dc, vx, vy, count, rule);
+        return;
     }
+#endif
 
-    /*
-     * Draw, scanning y
-     */
-    for (y = miny; (y <= maxy); y++)
-    {
-        ints = 0;
-        for (i = 0; (i < count); i++)
-        {
-            if (!i)
-            {
-                ind1 = count - 1;
-                ind2 = 0;
-            }
-            else
-            {
-                ind1 = i - 1;
-                ind2 = i;
-            }
-            y1 = vy[ind1];
-            y2 = vy[ind2];
-            if (y1 < y2)
-            {
-                x1 = vx[ind1];
-                x2 = vx[ind2];
-            }
-            else if (y1 > y2)
-            {
-                y2 = vy[ind1];
-                y1 = vy[ind2];
-                x2 = vx[ind1];
-                x1 = vx[ind2];
-            }
-            else
-            {
-                continue;
-            }
+    /* active edge list and edge table in one block */
+    ael = (rtgui_poly_edge_t **)rtgui_malloc(
+        (sizeof(rtgui_poly_edge_t *) + sizeof(rtgui_poly_edge_t)) * count);
+    if (!ael) return;
+    edges = (rtgui_poly_edge_t *)(ael + count);
 
-            if (((y >= y1) && (y < y2)) || ((y == maxy) && (y > y1) && (y <= y2)))
-            {
-                poly_ints[ints++] = ((65536 * (y - y1)) / (y2 - y1)) * (x2 - x1) + (65536 * x1);
-            }
+    /* build edge table sorted by ymin, horizontal edges are skipped */
+    num = 0;
+    maxy = vy[0];
+    for (i = 0; i < count; i++) {
+        int x1 = vx[i ? i - 1 : count - 1], y1 = vy[i ? i - 1 : count - 1];
+        int x2 = vx[i], y2 = vy[i];
+        rtgui_poly_edge_t edge;
+
+        if (y2 > maxy) maxy = y2;
+        if (y1 == y2) continue;
+        edge.dir = 1;
+        if (y1 > y2) {
+            int t;
+            t = x1; x1 = x2; x2 = t;
+            t = y1; y1 = y2; y2 = t;
+            edge.dir = -1;
         }
+        edge.x = x1 << 16;
+        edge.dx = ((x2 - x1) << 16) / (y2 - y1);
+        edge.ymin = y1;
+        edge.ymax = y2;
+
+        for (j = num; (j > 0) && (edges[j - 1].ymin > y1); j--)
+            edges[j] = edges[j - 1];
+        edges[j] = edge;
+        num++;
+    }
+    if (!num) {
+        rtgui_free(ael);
+        return;
+    }
 
-        qsort(poly_ints, ints, sizeof(int), _int_compare);
+    rtgui_dc_span_batch_init(&batch, dc, RT_NULL);
+    next = 0;
+    active = 0;
+    y = edges[0].ymin;
+    while ((next < num) || active) {
+        /* skip the gap between two disjoint parts */
+        if (!active && (y < edges[next].ymin))
+            y = edges[next].ymin;
+        /* new edges */
+        while ((next < num) && (edges[next].ymin == y))
+            ael[active++] = &edges[next++];
+        /* retired edges, the bottom row is closed by the edges ending there */
+        for (i = 0, j = 0; i < active; i++) {
+            e = ael[i];
+            if ((e->ymax > y) || ((y == maxy) && (e->ymin < y)))
+                ael[j++] = e;
+        }
+        active = j;
+
+        /* keep sorted by x, mostly sorted already from the last row */
+        for (i = 1; i < active; i++) {
+            e = ael[i];
+            for (j = i; (j > 0) && (ael[j - 1]->x > e->x); j--)
+                ael[j] = ael[j - 1];
+            ael[j] = e;
+        }
 
-        for (i = 0; (i < ints); i += 2)
-        {
-            xa = poly_ints[i] + 1;
+        /* spans */
+        wind = 0;
+        for (i = 0; i + 1 < active; i++) {
+            if (RTGUI_FILL_NON_ZERO == rule) {
+                wind += ael[i]->dir;
+                if (!wind) continue;
+            } else if (i & 1) {
+                continue;
+            }
+            xa = ael[i]->x + 1;
             xa = (xa >> 16) + ((xa & 32768) >> 15);
-            xb = poly_ints[i + 1] - 1;
+            xb = ael[i + 1]->x - 1;
             xb = (xb >> 16) + ((xb & 32768) >> 15);
-            rtgui_dc_draw_hline(dc, xa, xb, y);
+            if (xa < xb)
+                rtgui_dc_span_batch_add(&batch, xa, xb, y);
         }
+
+        if (y >= maxy) break;
+        for (i = 0; i < active; i++)
+            ael[i]->x += ael[i]->dx;
+        y++;
     }
+    rtgui_dc_span_batch_flush(&batch);
 
-    /* release memory */
-    rtgui_free(poly_ints);
+    rtgui_free(ael);
+}
+RTM_EXPORT(rtgui_dc_fill_polygon_rule);
+
+void rtgui_dc_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy,
+    int count) {
+    rtgui_dc_fill_polygon_rule(dc, vx, vy, count, RTGUI_FILL_EVEN_ODD);
 }
 RTM_EXPORT(rtgui_dc_fill_polygon);
 
@@ -562,77 +938,45 @@ void rtgui_dc_draw_circle(rtgui_dc_t *dc, int x, int y, int r)
 }
 RTM_EXPORT(rtgui_dc_draw_circle);
 
-enum
-{
-    QUARTER_BTM,
-    QUARTER_BTM_LEFT,
-    QUARTER_BTM_RIGHT,
-    QUARTER_TOP,
-    QUARTER_TOP_LEFT,
-    QUARTER_TOP_RIGHT,
-    QUARTER_FULL,
-};
+rt_inline void _round_rows(rtgui_span_batch_t *batch, int x1, int x2,
+    int top, int btm) {
+    rtgui_dc_span_batch_add(batch, x1, x2, top);
+    if (btm != top)
+        rtgui_dc_span_batch_add(batch, x1, x2, btm);
+}
 
-static void _fill_quarter_circle(rtgui_dc_t *dc,
-                                 rt_int16_t ox, rt_int16_t oy,
-                                 rt_int16_t rad, int quadrant)
-{
-    /* Midpoint circle algorithm. */
+/* Fill a circle of radius "r" stretched to a round rect, the corner centers
+   are (x1, y1) - (x2, y2) inclusive. Midpoint circle algorithm gives the
+   half width of each row once, so every pixel is in exactly one span. */
+static void _fill_round_spans(rtgui_dc_t *dc, int x1, int y1, int x2, int y2,
+    int r) {
+    rtgui_span_batch_t batch;
     int dk, x, y;
 
-    dk = 1 - rad;
+    rtgui_dc_span_batch_init(&batch, dc, RT_NULL);
+    dk = 1 - r;
     x = 0;
-    y = rad;
-
-    while (x <= y)
-    {
-        switch (quadrant)
-        {
-        case QUARTER_BTM:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy + x);
-            break;
-        case QUARTER_BTM_LEFT:
-            rtgui_dc_draw_hline(dc, ox, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox, ox + y, oy + x);
-            break;
-        case QUARTER_BTM_RIGHT:
-            rtgui_dc_draw_hline(dc, ox, ox - x, oy + y);
-            rtgui_dc_draw_hline(dc, ox, ox - y, oy + x);
-            break;
-        case QUARTER_TOP_RIGHT:
-            rtgui_dc_draw_hline(dc, ox, ox - x, oy - y);
-            rtgui_dc_draw_hline(dc, ox, ox - y, oy - x);
-            break;
-        case QUARTER_TOP_LEFT:
-            rtgui_dc_draw_hline(dc, ox, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox, ox + y, oy - x);
-            break;
-        case QUARTER_TOP:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy - x);
-            break;
-        case QUARTER_FULL:
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy + y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy + x);
-            rtgui_dc_draw_hline(dc, ox - x, ox + x, oy - y);
-            rtgui_dc_draw_hline(dc, ox - y, ox + y, oy - x);
-            break;
-        default:
-            RT_ASSERT(0);
-        };
-
-        if (dk > 0)
-        {
+    y = r;
+
+    while (x <= y) {
+        /* rows "x" away from the centers, half width "y" */
+        _round_rows(&batch, x1 - y, x2 + y + 1, y1 - x, y2 + x);
+        if (dk > 0) {
+            /* leaving rows "y" away, "x" is the widest of them */
+            if (y != x)
+                _round_rows(&batch, x1 - x, x2 + x + 1, y1 - y, y2 + y);
             y--;
             dk += 2 * (x - y) + 5;
-        }
-        else
-        {
+        } else {
             dk += 2 * x + 3;
         }
         x++;
     }
+
+    /* straight part between the centers */
+    for (y = y1 + 1; y < y2; y++)
+        rtgui_dc_span_batch_add(&batch, x1 - r, x2 + r + 1, y);
+    rtgui_dc_span_batch_flush(&batch);
 }
 
 void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r)
@@ -652,10 +996,66 @@ void rtgui_dc_fill_circle(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t
         return;
     }
 
-    _fill_quarter_circle(dc, x, y, r, QUARTER_FULL);
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc))
+    {
+        rtgui_dc_aa_fill_ellipse(dc, x, y, r, r);
+        return;
+    }
+#endif
+
+    _fill_round_spans(dc, x, y, x, y, r);
 }
 RTM_EXPORT(rtgui_dc_fill_circle);
 
+/* sin() of 0 - 90 degree in Q15, round(sin(d) * 32768),
+   generated by "tools/gen_sin_q15.py" */
+static const rt_uint16_t _sin_q15[91] = {
+        0,   572,  1144,  1715,  2286,  2856,  3425,  3993,
+     4560,  5126,  5690,  6252,  6813,  7371,  7927,  8481,
+     9032,  9580, 10126, 10668, 11207, 11743, 12275, 12803,
+    13328, 13848, 14365, 14876, 15384, 15886, 16384, 16877,
+    17364, 17847, 18324, 18795, 19261, 19720, 20174, 20622,
+    21063, 21498, 21926, 22348, 22763, 23170, 23571, 23965,
+    24351, 24730, 25102, 25466, 25822, 26170, 26510, 26842,
+    27166, 27482, 27789, 28088, 28378, 28660, 28932, 29197,
+    29452, 29698, 29935, 30163, 30382, 30592, 30792, 30983,
+    31164, 31336, 31499, 31651, 31795, 31928, 32052, 32166,
+    32270, 32365, 32449, 32524, 32588, 32643, 32688, 32723,
+    32748, 32763, 32768
+};
+
+/* sin() of integer degree in Q15 */
+int rtgui_sin_q15(int angle) {
+    angle %= 360;
+    if (angle < 0) angle += 360;
+
+    if (angle <= 90) return _sin_q15[angle];
+    if (angle <= 180) return _sin_q15[180 - angle];
+    if (angle <= 270) return -_sin_q15[angle - 180];
+    return -_sin_q15[360 - angle];
+}
+RTM_EXPORT(rtgui_sin_q15);
+
+/* cos() of integer degree in Q15 */
+int rtgui_cos_q15(int angle) {
+    return rtgui_sin_q15(angle % 360 + 90);
+}
+RTM_EXPORT(rtgui_cos_q15);
+
+/* sin() of 1/256 degree, interpolated between two table entries */
+static int _sin_q15_frac(int angle) {
+    int deg = angle >> 8;
+    int s0 = rtgui_sin_q15(deg);
+
+    return s0 + (rtgui_sin_q15(deg + 1) - s0) * (angle & 0xff) / 256;
+}
+
+/* same as (int)(r * v / 32768.0) */
+rt_inline int _q15_mul(int r, int v) {
+    return r * v / 32768;
+}
+
 void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r, rt_int16_t start, rt_int16_t end)
 {
     rt_int16_t cx = 0;
@@ -667,7 +1067,7 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
     rt_int16_t ypcy, ymcy, ypcx, ymcx;
     rt_uint8_t drawoct;
     int startoct, endoct, oct, stopval_start, stopval_end;
-    double temp;
+    int temp;
 
     stopval_start = 0;
     stopval_end = 0;
@@ -682,6 +1082,18 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
         return;
     }
 
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc))
+    {
+        rtgui_sector_t sec;
+        rt_bool_t full;
+
+        if (rtgui_dc_sector_init(&sec, start, end, &full))
+            rtgui_dc_aa_draw_ellipse(dc, x, y, r, r, full ? RT_NULL : &sec);
+        return;
+    }
+#endif
+
     /*
      * Draw arc
      * Octant labelling
@@ -727,23 +1139,22 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
             {
             case 0:
             case 3:
-                temp = sin(start * M_PI / 180);
+                temp = rtgui_sin_q15(start);
                 break;
             case 1:
             case 6:
-                temp = cos(start * M_PI / 180);
+                temp = rtgui_cos_q15(start);
                 break;
             case 2:
             case 5:
-                temp = -cos(start * M_PI / 180);
+                temp = -rtgui_cos_q15(start);
                 break;
             case 4:
             case 7:
-                temp = -sin(start * M_PI / 180);
+                temp = -rtgui_sin_q15(start);
                 break;
             }
-            temp *= r;
-            stopval_start = (int)temp; // always round down.
+            stopval_start = _q15_mul(r, temp); // always round down.
             // This isn't arbitrary, but requires graph paper to explain well.
             // The basic idea is that we're always changing drawoct after we draw, so we
             // stop immediately after we render the last sensible pixel at x = ((int)temp).
@@ -760,23 +1171,22 @@ void rtgui_dc_draw_arc(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t r,
             {
             case 0:
             case 3:
-                temp = sin(end * M_PI / 180);
+                temp = rtgui_sin_q15(end);
                 break;
             case 1:
             case 6:
-                temp = cos(end * M_PI / 180);
+                temp = rtgui_cos_q15(end);
                 break;
             case 2:
             case 5:
-                temp = -cos(end * M_PI / 180);
+                temp = -rtgui_cos_q15(end);
                 break;
             case 4:
             case 7:
-                temp = -sin(end * M_PI / 180);
+                temp = -rtgui_sin_q15(end);
                 break;
             }
-            temp *= r;
-            stopval_end = (int)temp;
+            stopval_end = _q15_mul(r, temp);
 
             // and whether to draw in this octant initially
             if (startoct == endoct)
@@ -884,7 +1294,7 @@ void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
 {
     rt_int16_t start_x, start_y;
     rt_int16_t end_x, end_y;
-    double temp;
+    int temp;
     rt_int16_t temp_val = 0;
 
     /* Sanity check radius */
@@ -902,30 +1312,30 @@ void rtgui_dc_draw_annulus(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
     rtgui_dc_draw_arc(dc, x, y, r1, start, end);
     rtgui_dc_draw_arc(dc, x, y, r2, start, end);
 
-    temp     = cos(start * M_PI / 180);
-    temp_val = (int)(temp * r1);
+    temp     = rtgui_cos_q15(start);
+    temp_val = _q15_mul(r1, temp);
     start_x  = x + temp_val;
-    temp_val = (int)(temp * r2);
+    temp_val = _q15_mul(r2, temp);
     end_x    = x + temp_val;
 
-    temp     = sin(start * M_PI / 180);
-    temp_val = (int)(temp * r1);
+    temp     = rtgui_sin_q15(start);
+    temp_val = _q15_mul(r1, temp);
     start_y  = y + temp_val;
-    temp_val = (int)(temp * r2);
+    temp_val = _q15_mul(r2, temp);
     end_y    = y + temp_val;
 
     rtgui_dc_draw_line(dc, start_x, start_y, end_x, end_y);
 
-    temp     = cos(end * M_PI / 180);
-    temp_val = (int)(temp * r1);
+    temp     = rtgui_cos_q15(end);
+    temp_val = _q15_mul(r1, temp);
     start_x  = x + temp_val;
-    temp_val = (int)(temp * r2);
+    temp_val = _q15_mul(r2, temp);
     end_x    = x + temp_val;
 
-    temp     = sin(end * M_PI / 180);
-    temp_val = (int)(temp * r1);
+    temp     = rtgui_sin_q15(end);
+    temp_val = _q15_mul(r1, temp);
     start_y  = y + temp_val;
-    temp_val = (int)(temp * r2);
+    temp_val = _q15_mul(r2, temp);
     end_y    = y + temp_val;
 
     rtgui_dc_draw_line(dc, start_x, start_y, end_x, end_y);
@@ -965,6 +1375,14 @@ void rtgui_dc_draw_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
         return;
     }
 
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc))
+    {
+        rtgui_dc_aa_draw_ellipse(dc, x, y, rx, ry, RT_NULL);
+        return;
+    }
+#endif
+
     /*
      * Init vars
      */
@@ -1083,15 +1501,14 @@ void rtgui_dc_draw_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
 }
 RTM_EXPORT(rtgui_dc_draw_ellipse);
 
+/* Midpoint ellipse algorithm: a row is added when the walk leaves it, with
+   its widest "x", so every pixel is in exactly one span. */
 void rtgui_dc_fill_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t rx, rt_int16_t ry)
 {
+    rt_int32_t rx2, ry2, px, py, p;
+    rt_uint32_t p2;
     int ix, iy;
-    int h, i, j, k;
-    int oh, oi, oj, ok;
-    int xmh, xph;
-    int xmi, xpi;
-    int xmj, xpj;
-    int xmk, xpk;
+    rtgui_span_batch_t batch;
 
     /*
      * Special case for rx=0 - draw a vline
@@ -1109,118 +1526,72 @@ void rtgui_dc_fill_ellipse(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_
         return;
     }
 
-    /*
-     * Init vars
-     */
-    oh = oi = oj = ok = 0xFFFF;
-
-    /*
-     * Draw
-     */
-    if (rx > ry)
+#ifdef RTGUI_USING_DC_AA
+    if (RTGUI_DC_IS_AA(dc))
     {
-        ix = 0;
-        iy = rx * 64;
+        rtgui_dc_aa_fill_ellipse(dc, x, y, rx, ry);
+        return;
+    }
+#endif
 
-        do
+    rx2 = rx * rx;
+    ry2 = ry * ry;
+    ix = 0;
+    iy = ry;
+    px = 0;
+    py = 2 * rx2 * iy;
+    rtgui_dc_span_batch_init(&batch, dc, RT_NULL);
+
+    /* region 1, slope above -1: step x */
+    p = ry2 - rx2 * ry + rx2 / 4;
+    while (px < py)
+    {
+        ix++;
+        px += 2 * ry2;
+        if (p < 0)
         {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * ry) / rx;
-            k = (i * ry) / rx;
-
-            if ((ok != k) && (oj != k))
-            {
-                xph = x + h;
-                xmh = x - h;
-                if (k > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmh, xph, y + k);
-                    rtgui_dc_draw_hline(dc, xmh, xph, y - k);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmh, xph, y);
-                }
-                ok = k;
-            }
-            if ((oj != j) && (ok != j) && (k != j))
-            {
-                xmi = x - i;
-                xpi = x + i;
-                if (j > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y + j);
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y - j);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmi, xpi, y);
-                }
-                oj = j;
-            }
-
-            ix = ix + iy / rx;
-            iy = iy - ix / rx;
-
+            p += ry2 + px;
+        }
+        else
+        {
+            _round_rows(&batch, x - ix + 1, x + ix, y - iy, y + iy);
+            iy--;
+            py -= 2 * rx2;
+            p += ry2 + px - py;
         }
-        while (i > h);
     }
-    else
-    {
-        ix = 0;
-        iy = ry * 64;
 
-        do
+    /* region 2: step y, the terms are too large for 32 bits but the sum is
+       not, so it is exact modulo 2^32 */
+    p2 = (rt_uint32_t)ry2 * (rt_uint32_t)(ix * ix + ix) + (rt_uint32_t)ry2 / 4 +
+        (rt_uint32_t)rx2 * (rt_uint32_t)((iy - 1) * (iy - 1)) -
+        (rt_uint32_t)rx2 * (rt_uint32_t)ry2;
+    p = (rt_int32_t)p2;
+    while (iy >= 0)
+    {
+        _round_rows(&batch, x - ix, x + ix + 1, y - iy, y + iy);
+        iy--;
+        py -= 2 * rx2;
+        if (p > 0)
         {
-            h = (ix + 32) >> 6;
-            i = (iy + 32) >> 6;
-            j = (h * rx) / ry;
-            k = (i * rx) / ry;
-
-            if ((oi != i) && (oh != i))
-            {
-                xmj = x - j;
-                xpj = x + j;
-                if (i > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y + i);
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y - i);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmj, xpj, y);
-                }
-                oi = i;
-            }
-            if ((oh != h) && (oi != h) && (i != h))
-            {
-                xmk = x - k;
-                xpk = x + k;
-                if (h > 0)
-                {
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y + h);
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y - h);
-                }
-                else
-                {
-                    rtgui_dc_draw_hline(dc, xmk, xpk, y);
-                }
-                oh = h;
-            }
-            ix = ix + iy / ry;
-            iy = iy - ix / ry;
+            p += rx2 - py;
+        }
+        else
+        {
+            ix++;
+            px += 2 * ry2;
+            p += rx2 - py + px;
         }
-        while (i > h);
     }
+    rtgui_dc_span_batch_flush(&batch);
 }
 RTM_EXPORT(rtgui_dc_fill_ellipse);
 
 void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t rad, rt_int16_t start, rt_int16_t end)
 {
-    double angle, start_angle, end_angle;
-    double deltaAngle;
-    double dr;
+    /* angles are in 1/256 degree */
+    int angle, start_angle, end_angle;
+    int deltaAngle;
     int numpoints, i;
     int *vx, *vy;
 
@@ -1243,26 +1614,22 @@ void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t ra
     }
 
     /*
-     * Variable setup
+     * Variable setup, step is about 3 pixels on the arc
      */
-    dr = (double) rad;
-    deltaAngle = 3.0 / dr;
-    start_angle = (double) start * (2.0 * M_PI / 360.0);
-    end_angle = (double) end * (2.0 * M_PI / 360.0);
+    deltaAngle = (3 * 180 * 256 * 7 / 22) / rad;
+    if (deltaAngle == 0) deltaAngle = 1;
+    start_angle = start * 256;
+    end_angle = end * 256;
     if (start > end)
     {
-        end_angle += (2.0 * M_PI);
+        end_angle += 360 * 256;
     }
 
     /* We will always have at least 2 points */
     numpoints = 2;
-
-    /* Count points (rather than calculating it) */
-    angle = start_angle;
-    while (angle < end_angle)
+    if (end_angle > start_angle)
     {
-        angle += deltaAngle;
-        numpoints++;
+        numpoints += (end_angle - start_angle + deltaAngle - 1) / deltaAngle;
     }
 
     /* Allocate combined vertex array */
@@ -1278,8 +1645,8 @@ void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t ra
 
     /* First vertex */
     angle = start_angle;
-    vx[1] = x + (int)(dr * cos(angle));
-    vy[1] = y + (int)(dr * sin(angle));
+    vx[1] = x + _q15_mul(rad, _sin_q15_frac(angle + 90 * 256));
+    vy[1] = y + _q15_mul(rad, _sin_q15_frac(angle));
 
     if (numpoints < 3)
     {
@@ -1288,18 +1655,15 @@ void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t ra
     else
     {
         /* Calculate other vertices */
-        i = 2;
-        angle = start_angle;
-        while (angle < end_angle)
+        for (i = 2; i < numpoints; i++)
         {
             angle += deltaAngle;
             if (angle > end_angle)
             {
                 angle = end_angle;
             }
-            vx[i] = x + (int)(dr * cos(angle));
-            vy[i] = y + (int)(dr * sin(angle));
-            i++;
+            vx[i] = x + _q15_mul(rad, _sin_q15_frac(angle + 90 * 256));
+            vy[i] = y + _q15_mul(rad, _sin_q15_frac(angle));
         }
 
         /* Draw */
@@ -1312,156 +1676,144 @@ void rtgui_dc_draw_pie(rtgui_dc_t *dc, rt_int16_t x, rt_int16_t y, rt_int16_t ra
 }
 RTM_EXPORT(rtgui_dc_draw_pie);
 
-/*
- * Octant labelling
- *
- *  \ 5 | 6 /
- *   \  |  /
- *  4 \ | / 7
- *     \|/
- *------+------ +x
- *     /|\
- *  3 / | \ 0
- *   /  |  \
- *  / 2 | 1 \
- *      +y
- */
-static void _draw_octant(rtgui_dc_t *dc,
-                         rt_int16_t ox, rt_int16_t oy,
-                         rt_int16_t y1, rt_int16_t y2, rt_int16_t x, int oct)
-{
-    switch (oct % 8)
-    {
-    case 0:
-        rtgui_dc_draw_line(dc, ox +  x, oy + y1, ox +  x, oy + y2);
-        break;
-    case 1:
-        /* Ugly hack to get the edge right. */
-        y2 += 1;
-        y1 += 1;
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox + y1, oy +  x, ox + y2, oy +  x);
-        break;
-    case 2:
-        y2 -= 1;
-        y1 -= 1;
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox - y2, oy +  x, ox - y1, oy +  x);
-        break;
-    case 3:
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox -  x, oy + y1, ox -  x, oy + y2);
-        break;
-    case 4:
-        x -= 1;
-        rtgui_dc_draw_line(dc, ox -  x, oy - y2, ox -  x, oy - y1);
-        break;
-    case 5:
-        y2 -= 1;
-        y1 -= 1;
-        rtgui_dc_draw_line(dc, ox - y2, oy -  x, ox - y1, oy -  x);
-        break;
-    case 6:
-        y2 += 1;
-        y1 += 1;
-        rtgui_dc_draw_line(dc, ox + y1, oy -  x, ox + y2, oy -  x);
-        break;
-    case 7:
-        rtgui_dc_draw_line(dc, ox +  x, oy - y2, ox +  x, oy - y1);
-        break;
-    };
+/* whether (x, y), relative to the center, is inside the sector */
+rt_bool_t rtgui_dc_sector_has(const rtgui_sector_t *sec, int x, int y) {
+    int cs = sec->sx * y - sec->sy * x;
+    int ce = x * sec->ey - y * sec->ex;
+
+    if (sec->wide)
+        return !((cs < 0) && (ce < 0));
+    return (cs >= 0) && (ce >= 0);
+}
+RTM_EXPORT(rtgui_dc_sector_has);
+
+/* pixel boundaries where a ray from the center crosses row "y" */
+static int _sector_cut(int dx, int dy, int y, int *cuts) {
+    int x;
+
+    if (!y || !dy || ((y > 0) != (dy > 0))) return 0;
+    /* floor of the crossing, the pixel on it (if any) gets its own piece */
+    x = y * dx / dy;
+    if (((y * dx) % dy) && ((y * dx < 0) != (dy < 0))) x--;
+    cuts[0] = x;
+    cuts[1] = x + 1;
+    return 2;
 }
 
-static void _fill_small_pie(rtgui_dc_t *dc,
-                            rt_int16_t ox, rt_int16_t oy,
-                            rt_int16_t rad, rt_int16_t start, rt_int16_t end,
-                            int oct)
-{
-    /* Midpoint circle algorithm. */
-    int dk, x, y;
-    /* Start X, end X, */
-    rt_int16_t sx, ex, ty = 0, my;
-    enum {ST_NONE, ST_ARC, ST_TRI} st;
+/* pixel "x1" to "x2" (inclusive) on row "oy + y" within the sector */
+static void _sector_span(rtgui_span_batch_t *batch, const rtgui_sector_t *sec,
+    int ox, int oy, int x1, int x2, int y) {
+    int cuts[6], num, i, j, t;
+    int from, to, begin;
 
-    RT_ASSERT(0 <= start && start <= 45);
-    RT_ASSERT(0 <= end && end <= 45);
-    if (start == end)
+    if (x1 > x2) return;
+    if (!sec) {
+        rtgui_dc_span_batch_add(batch, ox + x1, ox + x2 + 1, oy + y);
         return;
-    RT_ASSERT(start < end);
-    RT_ASSERT(rad > 0);
-
-    /* cos(90 - start) == sin(start) */
-    sx = rad * sin(start * M_PI / 180);
-    ex = rad * sin(end * M_PI / 180);
-
-    dk = 1 - rad;
-    x = 0;
-    y = rad;
-
-    st = ST_NONE;
-    my = ex;
-    while (x <= y)
-    {
-        rt_int16_t lx;
+    }
 
-        if (x < sx)
-        {
-        }
-        else if (x == sx)
-        {
-            /* Start point. */
-            st = ST_ARC;
-            ty = y;
-        }
-        else if (x <= ex)
-        {
-            /* Between the pie. */
-            RT_ASSERT(st == ST_ARC);
-        }
-        else /* x > ex */
-        {
-            /* End. */
-            st = ST_TRI;
-            my = y;
-            break;
-        }
+    num = _sector_cut(sec->sx, sec->sy, y, cuts);
+    num += _sector_cut(sec->ex, sec->ey, y, cuts + num);
+    if (!y) {
+        /* the row through the center */
+        cuts[num++] = 0;
+        cuts[num++] = 1;
+    }
+    for (i = 1; i < num; i++) {
+        t = cuts[i];
+        for (j = i; (j > 0) && (cuts[j - 1] > t); j--)
+            cuts[j] = cuts[j - 1];
+        cuts[j] = t;
+    }
 
-        /* Drawing. */
-        if (st == ST_ARC)
-        {
-            lx = y * sx / ty;
-            /* Change from math coordinate to plot coordinate. */
-            _draw_octant(dc, ox, oy, lx, x, y, oct);
+    /* the inside test is constant between two boundaries */
+    begin = x2 + 1;
+    from = x1;
+    for (i = 0; i <= num; i++) {
+        to = (i < num) ? cuts[i] : (x2 + 1);
+        if (to <= from) continue;
+        if (to > x2 + 1) to = x2 + 1;
+        if (rtgui_dc_sector_has(sec, from, y)) {
+            if (begin > x2) begin = from;
+        } else if (begin <= x2) {
+            rtgui_dc_span_batch_add(batch, ox + begin, ox + from, oy + y);
+            begin = x2 + 1;
         }
+        from = to;
+        if (from > x2) break;
+    }
+    if (begin <= x2)
+        rtgui_dc_span_batch_add(batch, ox + begin, ox + x2 + 1, oy + y);
+}
 
-        /* Midpoint increment. */
-        if (dk > 0)
-        {
-            y--;
-            dk += 2 * (x - y) + 5;
-        }
-        else
-        {
-            dk += 2 * x + 3;
+/* fill pixels with (r1 - 0.5) < distance < (r2 + 0.5), r1 = 0 for a disc */
+static void _fill_sector(rtgui_dc_t *dc, int ox, int oy, int r1, int r2,
+    const rtgui_sector_t *sec) {
+    rtgui_span_batch_t batch;
+    int y, wo, wi, lo, li;
+
+    lo = r2 * r2 + r2;
+    li = r1 * r1 - r1;
+    wo = r2;
+    wi = r1 - 1;
+    rtgui_dc_span_batch_init(&batch, dc, RT_NULL);
+
+    for (y = 0; y <= r2; y++) {
+        while ((wo >= 0) && (wo * wo + y * y > lo)) wo--;
+        while ((wi >= 0) && (wi * wi + y * y > li)) wi--;
+        if (r1 <= 0) wi = -1;
+
+        if (wi < 0) {
+            _sector_span(&batch, sec, ox, oy, -wo, wo, y);
+            if (y) _sector_span(&batch, sec, ox, oy, -wo, wo, -y);
+        } else {
+            _sector_span(&batch, sec, ox, oy, -wo, -wi - 1, y);
+            _sector_span(&batch, sec, ox, oy, wi + 1, wo, y);
+            if (y) {
+                _sector_span(&batch, sec, ox, oy, -wo, -wi - 1, -y);
+                _sector_span(&batch, sec, ox, oy, wi + 1, wo, -y);
+            }
         }
-        x++;
     }
-    /* Draw bottom part. */
-    for (; y >= 0; y--)
-    {
-        rt_int16_t lx, rx;
-
-        lx = y * sx / ty;
-        rx = y * ex / my;
+    rtgui_dc_span_batch_flush(&batch);
+}
 
-        _draw_octant(dc, ox, oy, lx, rx, y, oct);
+/* return RT_FALSE if nothing to draw, "*full" for the whole circle */
+rt_bool_t rtgui_dc_sector_init(rtgui_sector_t *sec, int start, int end,
+    rt_bool_t *full) {
+    *full = RT_FALSE;
+    if (end - start >= 360) {
+        *full = RT_TRUE;
+        return RT_TRUE;
     }
+    if (start == end) return RT_FALSE;
+
+    /*
+     * Fixup angles
+     */
+    start %= 360;
+    if (start < 0) start += 360;
+    end %= 360;
+    if (end < 0) end += 360;
+    if (end < start) end += 360;
+    if (end == start) return RT_FALSE;
+
+    sec->sx = rtgui_cos_q15(start);
+    sec->sy = rtgui_sin_q15(start);
+    sec->ex = rtgui_cos_q15(end);
+    sec->ey = rtgui_sin_q15(end);
+    sec->wide = (end - start) > 180;
+    return RT_TRUE;
 }
+RTM_EXPORT(rtgui_dc_sector_init);
 
 void rtgui_dc_fill_pie(rtgui_dc_t *dc,
                        rt_int16_t x, rt_int16_t y, rt_int16_t rad,
                        rt_int16_t start, rt_int16_t end)
 {
+    rtgui_sector_t sec;
+    rt_bool_t full;
+
     /* Sanity check radii */
     if (rad < 0)
         return;
@@ -1471,61 +1823,40 @@ void rtgui_dc_fill_pie(rtgui_dc_t *dc,
         return;
     }
 
-    if (end - start >= 360)
+    if (!rtgui_dc_sector_init(&sec, start, end, &full))
+        return;
+    if (full)
     {
         rtgui_dc_fill_circle(dc, x, y, rad);
         return;
     }
-    if (start == end)
-        return;
 
-    /*
-     * Fixup angles
-     */
-    while (start < 0)
-    {
-        start += 360;
-        end   += 360;
-    }
-    while (start >= 360)
-    {
-        start -= 360;
-        end   -= 360;
-    }
+    _fill_sector(dc, x, y, 0, rad, &sec);
+}
+RTM_EXPORT(rtgui_dc_fill_pie);
 
-    if (end < start)
-        end += 360;
+void rtgui_dc_fill_annulus(rtgui_dc_t *dc,
+                           rt_int16_t x, rt_int16_t y, rt_int16_t r1, rt_int16_t r2,
+                           rt_int16_t start, rt_int16_t end)
+{
+    rtgui_sector_t sec;
+    rt_bool_t full;
 
-    while (start / 45 != end / 45)
-    {
-        /* The start and end are not in the same piece. */
-        if ((start / 45) % 2)
-        {
-            _fill_small_pie(dc, x, y, rad,
-                            0, 45 - start % 45, start / 45);
-            start += 45 - start % 45;
-        }
-        else
-        {
-            _fill_small_pie(dc, x, y, rad,
-                            start % 45, 45, start / 45);
-            start += 45 - start % 45;
-        }
-    }
-    if ((start / 45) % 2)
-    {
-        _fill_small_pie(dc, x, y, rad,
-                        90 - end % 90, 90 - start % 90, start / 45);
-    }
-    else
+    /* Sanity check radii */
+    if ((r1 < 0) || (r2 < 0))
+        return;
+    if (r1 > r2)
     {
-        _fill_small_pie(dc, x, y, rad,
-                        start % 45, end % 45, start / 45);
+        rt_int16_t r = r1;
+        r1 = r2;
+        r2 = r;
     }
 
-    return;
+    if (!rtgui_dc_sector_init(&sec, start, end, &full))
+        return;
+    _fill_sector(dc, x, y, r1, r2, full ? RT_NULL : &sec);
 }
-RTM_EXPORT(rtgui_dc_fill_pie);
+RTM_EXPORT(rtgui_dc_fill_annulus);
 
 /*
  * set gc of dc
@@ -1540,6 +1871,7 @@ void rtgui_dc_set_gc(rtgui_dc_t *dc, rtgui_gc_t *gc) {
         /* get owner */
         owner = rt_container_of(dc, rtgui_widget_t, dc_type);
         owner->gc = *gc;
+        rtgui_gc_invalidate(&owner->gc);
         break;
     }
 
@@ -1550,9 +1882,17 @@ void rtgui_dc_set_gc(rtgui_dc_t *dc, rtgui_gc_t *gc) {
         dc_hw = (struct rtgui_dc_hw *) dc;
         RT_ASSERT(dc_hw->owner != RT_NULL);
         dc_hw->owner->gc = *gc;
+        rtgui_gc_invalidate(&dc_hw->owner->gc);
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        ((struct rtgui_dc_buffer *)dc)->gc = *gc;
+        rtgui_gc_invalidate(&((struct rtgui_dc_buffer *)dc)->gc);
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1587,6 +1927,12 @@ rtgui_gc_t *rtgui_dc_get_gc(rtgui_dc_t *dc) {
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        gc = &((struct rtgui_dc_buffer *)dc)->gc;
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1608,6 +1954,11 @@ rt_bool_t rtgui_dc_get_visible(rtgui_dc_t *dc) {
     case RTGUI_DC_HW:
         return IS_WIDGET_FLAG(((struct rtgui_dc_hw *)dc)->owner, DC_VISIBLE);
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        return RT_TRUE;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         return RT_TRUE;
@@ -1652,6 +2003,15 @@ void rtgui_dc_get_rect(rtgui_dc_t *dc, rtgui_rect_t *rect) {
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        rect->x1 = 0;
+        rect->y1 = 0;
+        rect->x2 = ((struct rtgui_dc_buffer *)dc)->width;
+        rect->y2 = ((struct rtgui_dc_buffer *)dc)->height;
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1676,6 +2036,12 @@ rt_uint8_t rtgui_dc_get_pixel_format(rtgui_dc_t *dc) {
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        pixel_fmt = ((struct rtgui_dc_buffer *)dc)->pixel_format;
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         RT_ASSERT(0);
@@ -1710,6 +2076,12 @@ void rtgui_dc_logic_to_device(rtgui_dc_t *dc, struct rtgui_point *point) {
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        /* already device */
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1740,6 +2112,12 @@ void rtgui_dc_rect_to_device(rtgui_dc_t *dc, rtgui_rect_t *rect) {
         break;
     }
 
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+        /* already device */
+        break;
+    #endif
+
     default:
         LOG_E("bad dc type %d", dc->type);
         break;
@@ -1747,6 +2125,142 @@ void rtgui_dc_rect_to_device(rtgui_dc_t *dc, rtgui_rect_t *rect) {
 }
 RTM_EXPORT(rtgui_dc_rect_to_device);
 
+/* copy a device rect of "dc" by (dx, dy), the two may overlap */
+static rt_bool_t _dc_move_rect(rtgui_dc_t *dc, rtgui_rect_t *rect, int dx,
+    int dy) {
+    #ifdef RTGUI_USING_DC_BUFFER
+        if (dc->type == RTGUI_DC_BUFFER) {
+            struct rtgui_dc_buffer *buf = (struct rtgui_dc_buffer *)dc;
+            rt_uint8_t bpp, *src;
+            rt_uint32_t len;
+            int y, step;
+
+            if (buf->bits_per_pixel < 8) return RT_FALSE;
+            bpp = _BIT2BYTE(buf->bits_per_pixel);
+            len = (rect->x2 - rect->x1) * bpp;
+            /* keep the source rows ahead of the destination */
+            if (dy > 0) {
+                y = rect->y2 - 1;
+                step = -buf->pitch;
+            } else {
+                y = rect->y1;
+                step = buf->pitch;
+            }
+            src = buf->pixel + y * buf->pitch + rect->x1 * bpp;
+            for (y = rect->y1; y < rect->y2; y++, src += step)
+                rt_memmove(src + dy * buf->pitch + dx * bpp, src, len);
+            return RT_TRUE;
+        }
+    #endif
+    return rtgui_gfx_move_rect(rect, dx, dy);
+}
+
+/* move the content of "rect" by (dx, dy). Only the visible part whose
+   source is visible too is copied, the rest of the destination is returned
+   in "exposed" (logic coordinate) for the caller to redraw. RT_FALSE if the
+   dc can't move pixels, then the whole visible "rect" is exposed. */
+rt_bool_t rtgui_dc_scroll_area(rtgui_dc_t *dc, rtgui_rect_t *rect, int dx,
+    int dy, rtgui_region_t *exposed) {
+    rtgui_region_t area, moved;
+    rtgui_rect_t r, bound, src, *rects;
+    struct rtgui_point org = { 0, 0 };
+    rt_uint32_t i, num, done, start, end;
+    rt_bool_t ret = RT_TRUE;
+
+    RT_ASSERT(dc != RT_NULL);
+    RT_ASSERT(rect != RT_NULL);
+
+    if (!rtgui_dc_get_visible(dc)) return RT_FALSE;
+
+    r = *rect;
+    rtgui_dc_rect_to_device(dc, &r);
+    rtgui_dc_logic_to_device(dc, &org);
+
+    /* visible part of "rect" */
+    rtgui_region_init_empty(&area);
+    switch (dc->type) {
+    case RTGUI_DC_CLIENT:
+    {
+        rtgui_widget_t *owner = rt_container_of(dc, rtgui_widget_t, dc_type);
+
+        rtgui_region_intersect_rect(&area, &owner->clip, &r);
+        break;
+    }
+
+    case RTGUI_DC_HW:
+        rtgui_gfx_get_rect(rtgui_get_gfx_device(), &bound);
+        rtgui_rect_intersect(&((struct rtgui_dc_hw *)dc)->owner->extent,
+            &bound);
+        if ((bound.x1 < bound.x2) && (bound.y1 < bound.y2))
+            rtgui_region_reset(&area, &bound);
+        rtgui_region_intersect_rect(&area, &area, &r);
+        break;
+
+    #ifdef RTGUI_USING_DC_BUFFER
+    case RTGUI_DC_BUFFER:
+    {
+        struct rtgui_dc_buffer *buf = (struct rtgui_dc_buffer *)dc;
+
+        rtgui_rect_set(&bound, 0, 0, buf->width, buf->height);
+        rtgui_region_reset(&area, &bound);
+        rtgui_region_intersect_rect(&area, &area, &r);
+        break;
+    }
+    #endif
+
+    default:
+        LOG_E("bad dc type %d", dc->type);
+        rtgui_region_uninit(&area);
+        return RT_FALSE;
+    }
+
+    /* destination whose source is visible */
+    rtgui_region_init_empty(&moved);
+    if (dx || dy) {
+        rtgui_region_copy(&moved, &area);
+        rtgui_region_translate(&moved, dx, dy);
+        rtgui_region_intersect(&moved, &moved, &area);
+    }
+
+    /* like memmove, visit the bands opposite to "dy" and the rects of a band
+       opposite to "dx", so no source is overwritten before copied */
+    num = rtgui_region_num_rects(&moved);
+    rects = rtgui_region_rects(&moved);
+    for (done = 0; ret && (done < num); done += end - start) {
+        if (dy > 0) {
+            end = num - done;
+            start = end - 1;
+            while (start && (rects[start - 1].y1 == rects[end - 1].y1))
+                start--;
+        } else {
+            start = done;
+            end = start + 1;
+            while ((end < num) && (rects[end].y1 == rects[start].y1))
+                end++;
+        }
+
+        for (i = 0; i < end - start; i++) {
+            src = rects[(dx > 0) ? (end - 1 - i) : (start + i)];
+            rtgui_rect_move(&src, -dx, -dy);
+            if (!_dc_move_rect(dc, &src, dx, dy)) {
+                ret = RT_FALSE;
+                rtgui_region_empty(&moved);
+                break;
+            }
+        }
+    }
+
+    if (exposed) {
+        rtgui_region_subtract(exposed, &area, &moved);
+        rtgui_region_translate(exposed, -org.x, -org.y);
+    }
+    rtgui_region_uninit(&moved);
+    rtgui_region_uninit(&area);
+
+    return ret;
+}
+RTM_EXPORT(rtgui_dc_scroll_area);
+
 #ifdef RTGUI_USING_CURSOR
     extern struct rt_mutex cursor_lock;
     extern void rtgui_cursor_show(void);
@@ -1812,6 +2326,9 @@ rtgui_dc_t *rtgui_dc_begin_drawing(rtgui_widget_t *owner) {
             if (!IS_TITLE(win)) {
                 rtgui_evt_generic_t *evt;
 
+                /* sent once by banded paint */
+                if (win->update) break;
+
                 /* send RTGUI_EVENT_UPDATE_BEGIN */
                 RTGUI_CREATE_EVENT(evt, UPDATE_BEGIN, RT_WAITING_FOREVER);
                 if (!evt) break;
@@ -1874,8 +2391,8 @@ void rtgui_dc_end_drawing(rtgui_dc_t *dc, rt_bool_t update) {
             #endif
 
             /* update screen */
-            rtgui_gfx_update_screen(rtgui_get_gfx_device(),
-                &(owner->extent));
+            rtgui_gfx_damage_add(rtgui_get_gfx_device(), &(owner->extent));
+            rtgui_gfx_damage_flush(rtgui_get_gfx_device(), RT_TRUE);
         }
     } while (0);
 
@@ -0,0 +1,494 @@
+/*
+ * File      : dc_aa.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-20     onelife      first version
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+
+#ifdef RTGUI_USING_DC_AA
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    " DC_AA "
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+typedef struct rtgui_aa {
+    rtgui_dc_t *dc;
+    rtgui_color_t fg;
+    rt_uint32_t alpha;          /* of foreground in 1/256 */
+} rtgui_aa_t;
+
+/* polygon edge, x in 1/16 pixel with 8 more fraction bits, y in sub-rows */
+typedef struct rtgui_aa_edge {
+    int x;
+    int dx;
+    int ymin;
+    int ymax;
+    int dir;
+} rtgui_aa_edge_t;
+
+/* Private define ------------------------------------------------------------*/
+/* Coverage is in 1/16 pixel. Polygons are sampled on 4 sub-rows per pixel row
+   and at 1/16 pixel along each sub-row, so a pixel holds up to 64 units. */
+#define AA_SHIFT                    (4)
+#define AA_ONE                      (1 << AA_SHIFT)
+#define AA_SUB_ROWS                 (4)
+#define AA_SUB_H                    (AA_ONE / AA_SUB_ROWS)
+#define AA_FULL                     (AA_ONE * AA_SUB_ROWS)
+#define _int_swap(x, y)             \
+    do {                            \
+        x ^= y;                     \
+        y ^= x;                     \
+        x ^= y;                     \
+    } while (0)
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* coverage (1/16) to alpha (1/256), (c / 16) ^ 0.8 lifts thin edges a bit */
+static const rt_uint16_t _cov_to_alpha[AA_ONE + 1] = {
+      0,  28,  49,  67,  84, 101, 117, 132,
+    147, 162, 176, 190, 203, 217, 230, 243,
+    256,
+};
+
+/* Private functions ---------------------------------------------------------*/
+static void _aa_init(rtgui_aa_t *aa, rtgui_dc_t *dc) {
+    rtgui_gc_t *gc = rtgui_dc_get_gc(dc);
+
+    aa->dc = dc;
+    aa->fg = gc->foreground;
+    aa->alpha = 256;
+    if (RTGUI_GC_IS_BLEND(gc, aa->fg))
+        aa->alpha = RTGUI_RGB_A(aa->fg) + (RTGUI_RGB_A(aa->fg) >> 7);
+}
+
+/* "a" is in 1/256, red and blue are blended together */
+rt_inline rtgui_color_t _blend(rtgui_color_t fg, rtgui_color_t bg,
+    rt_uint32_t a) {
+    rt_uint32_t rb, g;
+
+    rb = ((fg & 0xff00ff) * a + (bg & 0xff00ff) * (256 - a)) >> 8;
+    g = ((fg & 0x00ff00) * a + (bg & 0x00ff00) * (256 - a)) >> 8;
+    return 0xff000000 | (rb & 0xff00ff) | (g & 0x00ff00);
+}
+
+/* blend foreground over the point with coverage "cov" (1/16) */
+static void _aa_plot(rtgui_aa_t *aa, int x, int y, rt_uint32_t cov) {
+    rtgui_color_t dst;
+    rt_uint32_t a;
+
+    if (cov > AA_ONE) cov = AA_ONE;
+    a = (_cov_to_alpha[cov] * aa->alpha) >> 8;
+    if (!a) return;
+    if (a >= 256) {
+        rtgui_dc_draw_point(aa->dc, x, y);
+        return;
+    }
+    if (!rtgui_dc_get_color_point(aa->dc, x, y, &dst)) return;
+    rtgui_dc_draw_color_point(aa->dc, x, y, _blend(aa->fg, dst, a));
+}
+
+static rt_uint32_t _isqrt(rt_uint32_t n) {
+    rt_uint32_t root = 0;
+    rt_uint32_t bit = 1UL << 30;
+
+    while (bit > n) bit >>= 2;
+    while (bit) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/* plot (x, y) of the first quadrant and its mirrors */
+static void _aa_plot4(rtgui_aa_t *aa, int cx, int cy, int x, int y,
+    rt_uint32_t cov, const rtgui_sector_t *sec) {
+    if (!cov) return;
+    if (!sec || rtgui_dc_sector_has(sec, x, y))
+        _aa_plot(aa, cx + x, cy + y, cov);
+    if (x && (!sec || rtgui_dc_sector_has(sec, -x, y)))
+        _aa_plot(aa, cx - x, cy + y, cov);
+    if (y && (!sec || rtgui_dc_sector_has(sec, x, -y)))
+        _aa_plot(aa, cx + x, cy - y, cov);
+    if (x && y && (!sec || rtgui_dc_sector_has(sec, -x, -y)))
+        _aa_plot(aa, cx - x, cy - y, cov);
+}
+
+/* round a Q15 product to integer, half away from zero */
+rt_inline int _q15_round(int v) {
+    return (v >= 0) ? ((v + 16384) >> 15) : -((16384 - v) >> 15);
+}
+
+/* ceil(v / 4) for the sub-row of "v" (1/16 pixel) */
+rt_inline int _sub_row(int v) {
+    return -((-(v - AA_SUB_H / 2)) >> 2);
+}
+
+/* coverage of one pixel row into spans (full) and blended points */
+static void _aa_emit_row(rtgui_aa_t *aa, rtgui_span_batch_t *batch,
+    rt_int16_t *area, rt_int16_t *cover, int lo, int hi, int px0, int y) {
+    int p, run, c, full;
+
+    run = 0;
+    full = -1;
+    for (p = lo; p <= hi; p++) {
+        run += cover[p];
+        c = run + area[p];
+        cover[p] = area[p] = 0;
+        if (c >= AA_FULL) {
+            if (full < 0) full = p;
+            continue;
+        }
+        if (full >= 0) {
+            rtgui_dc_span_batch_add(batch, px0 + full, px0 + p, y);
+            full = -1;
+        }
+        if (c > 0) _aa_plot(aa, px0 + p, y, (c + 2) >> 2);
+    }
+    if (full >= 0)
+        rtgui_dc_span_batch_add(batch, px0 + full, px0 + hi + 1, y);
+}
+
+/* fill polygon, vertices in 1/16 pixel and pixel (0, 0) is [0, 16) */
+static void _aa_fill_polygon(rtgui_aa_t *aa, const int *vx, const int *vy,
+    int count, rtgui_fill_rule_t rule) {
+    rtgui_aa_edge_t *edges, **ael, *e;
+    rt_int16_t *area, *cover;
+    rtgui_span_batch_t batch;
+    rtgui_rect_t rect;
+    int i, j, num, next, active, wind;
+    int minx, maxx, px0, w, lo, hi;
+    int k, py, xa, xb;
+
+    if (count < 3) return;
+
+    /* cells are limited to the dc */
+    rtgui_dc_get_rect(aa->dc, &rect);
+    minx = maxx = vx[0];
+    for (i = 1; i < count; i++) {
+        if (vx[i] < minx) minx = vx[i];
+        else if (vx[i] > maxx) maxx = vx[i];
+    }
+    if (minx < rect.x1 * AA_ONE) minx = rect.x1 * AA_ONE;
+    if (maxx > rect.x2 * AA_ONE) maxx = rect.x2 * AA_ONE;
+    if (minx >= maxx) return;
+    px0 = minx >> AA_SHIFT;
+    w = ((maxx + AA_ONE - 1) >> AA_SHIFT) - px0;
+
+    /* active edge list, edge table and cells in one block */
+    ael = (rtgui_aa_edge_t **)rtgui_malloc(
+        (sizeof(rtgui_aa_edge_t *) + sizeof(rtgui_aa_edge_t)) * count +
+        sizeof(rt_int16_t) * (w + 1) * 2);
+    if (!ael) {
+        LOG_E("no mem for aa polygon");
+        return;
+    }
+    edges = (rtgui_aa_edge_t *)(ael + count);
+    area = (rt_int16_t *)(edges + count);
+    cover = area + w + 1;
+    rt_memset(area, 0x00, sizeof(rt_int16_t) * (w + 1) * 2);
+
+    /* edge table sorted by the first sub-row */
+    num = 0;
+    for (i = 0; i < count; i++) {
+        int x1 = vx[i ? i - 1 : count - 1], y1 = vy[i ? i - 1 : count - 1];
+        int x2 = vx[i], y2 = vy[i];
+        rtgui_aa_edge_t edge;
+
+        if (y1 == y2) continue;
+        edge.dir = 1;
+        if (y1 > y2) {
+            _int_swap(x1, x2);
+            _int_swap(y1, y2);
+            edge.dir = -1;
+        }
+        edge.ymin = _sub_row(y1);
+        edge.ymax = _sub_row(y2);
+        if (edge.ymin >= edge.ymax) continue;
+        edge.x = x1 * 256 + (edge.ymin * AA_SUB_H + AA_SUB_H / 2 - y1) *
+            (x2 - x1) * 256 / (y2 - y1);
+        edge.dx = AA_SUB_H * (x2 - x1) * 256 / (y2 - y1);
+
+        for (j = num; (j > 0) && (edges[j - 1].ymin > edge.ymin); j--)
+            edges[j] = edges[j - 1];
+        edges[j] = edge;
+        num++;
+    }
+
+    rtgui_dc_span_batch_init(&batch, aa->dc, RT_NULL);
+    next = 0;
+    active = 0;
+    lo = w;
+    hi = -1;
+    k = num ? edges[0].ymin : 0;
+    py = k >> 2;
+    while ((next < num) || active) {
+        /* skip the gap between two disjoint parts */
+        if (!active && (k < edges[next].ymin)) {
+            k = edges[next].ymin;
+            if ((k >> 2) != py) {
+                if (lo <= hi)
+                    _aa_emit_row(aa, &batch, area, cover, lo, hi, px0, py);
+                lo = w;
+                hi = -1;
+                py = k >> 2;
+            }
+        }
+        while ((next < num) && (edges[next].ymin == k))
+            ael[active++] = &edges[next++];
+        for (i = 0, j = 0; i < active; i++)
+            if (ael[i]->ymax > k) ael[j++] = ael[i];
+        active = j;
+        for (i = 1; i < active; i++) {
+            e = ael[i];
+            for (j = i; (j > 0) && (ael[j - 1]->x > e->x); j--)
+                ael[j] = ael[j - 1];
+            ael[j] = e;
+        }
+
+        /* accumulate the spans of this sub-row */
+        wind = 0;
+        for (i = 0; (i + 1 < active) && (py >= rect.y1) && (py < rect.y2);
+             i++) {
+            int pa, pb;
+
+            if (RTGUI_FILL_NON_ZERO == rule) {
+                wind += ael[i]->dir;
+                if (!wind) continue;
+            } else if (i & 1) {
+                continue;
+            }
+            xa = ((ael[i]->x + 128) >> 8) - (px0 << AA_SHIFT);
+            xb = ((ael[i + 1]->x + 128) >> 8) - (px0 << AA_SHIFT);
+            if (xa < 0) xa = 0;
+            if (xb > (w << AA_SHIFT)) xb = w << AA_SHIFT;
+            if (xa >= xb) continue;
+
+            pa = xa >> AA_SHIFT;
+            pb = xb >> AA_SHIFT;
+            if (pa == pb) {
+                area[pa] += xb - xa;
+            } else {
+                area[pa] += AA_ONE - (xa & (AA_ONE - 1));
+                cover[pa + 1] += AA_ONE;
+                cover[pb] -= AA_ONE;
+                area[pb] += xb & (AA_ONE - 1);
+            }
+            if (pa < lo) lo = pa;
+            if (pb > hi) hi = (pb < w) ? pb : (w - 1);
+        }
+
+        for (i = 0; i < active; i++)
+            ael[i]->x += ael[i]->dx;
+        k++;
+        if ((k >> 2) != py) {
+            if (lo <= hi)
+                _aa_emit_row(aa, &batch, area, cover, lo, hi, px0, py);
+            lo = w;
+            hi = -1;
+            py = k >> 2;
+        }
+    }
+    if (lo <= hi)
+        _aa_emit_row(aa, &batch, area, cover, lo, hi, px0, py);
+    rtgui_dc_span_batch_flush(&batch);
+
+    rtgui_free(ael);
+}
+
+/* Public functions ----------------------------------------------------------*/
+/* Wu's line, both end points are drawn */
+void rtgui_dc_aa_draw_line(rtgui_dc_t *dc, int x1, int y1, int x2, int y2) {
+    rtgui_aa_t aa;
+    rt_uint32_t acc, adj, cov;
+    int dx, dy, xdir, i;
+
+    if (dc == RT_NULL) return;
+
+    if (y1 > y2) {
+        _int_swap(x1, x2);
+        _int_swap(y1, y2);
+    }
+    dx = x2 - x1;
+    dy = y2 - y1;
+    xdir = (dx < 0) ? -1 : 1;
+    dx = _ABS(dx);
+
+    /* nothing to smooth */
+    if (!dy) {
+        rtgui_dc_draw_hline(dc, _MIN(x1, x2), _MAX(x1, x2) + 1, y1);
+        return;
+    }
+    if (!dx) {
+        rtgui_dc_draw_vline(dc, x1, y1, y2 + 1);
+        return;
+    }
+    if (dx == dy) {
+        for (i = 0; i <= dy; i++)
+            rtgui_dc_draw_point(dc, x1 + i * xdir, y1 + i);
+        return;
+    }
+
+    _aa_init(&aa, dc);
+    rtgui_dc_draw_point(dc, x1, y1);
+    rtgui_dc_draw_point(dc, x2, y2);
+
+    acc = 0;
+    if (dy > dx) {
+        /* x moves less than 1 pixel per row */
+        adj = ((rt_uint32_t)dx << 16) / dy;
+        for (i = 1; i < dy; i++) {
+            acc += adj;
+            if (acc >= 0x10000) {
+                acc -= 0x10000;
+                x1 += xdir;
+            }
+            y1++;
+            cov = (acc + 0x800) >> 12;
+            _aa_plot(&aa, x1, y1, AA_ONE - cov);
+            _aa_plot(&aa, x1 + xdir, y1, cov);
+        }
+    } else {
+        adj = ((rt_uint32_t)dy << 16) / dx;
+        for (i = 1; i < dx; i++) {
+            acc += adj;
+            if (acc >= 0x10000) {
+                acc -= 0x10000;
+                y1++;
+            }
+            x1 += xdir;
+            cov = (acc + 0x800) >> 12;
+            _aa_plot(&aa, x1, y1, AA_ONE - cov);
+            _aa_plot(&aa, x1, y1 + 1, cov);
+        }
+    }
+}
+RTM_EXPORT(rtgui_dc_aa_draw_line);
+
+/* ellipse outline, or an arc of it if "sec" is given */
+void rtgui_dc_aa_draw_ellipse(rtgui_dc_t *dc, int x, int y, int rx, int ry,
+    const rtgui_sector_t *sec) {
+    rtgui_aa_t aa;
+    rt_uint32_t rx2, ry2, q;
+    int i, lim, last;
+
+    if ((dc == RT_NULL) || (rx <= 0) || (ry <= 0)) return;
+    _aa_init(&aa, dc);
+    rx2 = rx * rx;
+    ry2 = ry * ry;
+
+    /* one step per column until the slope reaches 1 */
+    lim = rx2 / _isqrt(rx2 + ry2);
+    last = ry;
+    for (i = 0; i <= lim; i++) {
+        q = _isqrt((rx2 - i * i) << (2 * AA_SHIFT)) * ry / rx;
+        last = q >> AA_SHIFT;
+        _aa_plot4(&aa, x, y, i, last, AA_ONE - (q & (AA_ONE - 1)), sec);
+        _aa_plot4(&aa, x, y, i, last + 1, q & (AA_ONE - 1), sec);
+    }
+
+    /* then one step per row, below the rows done above */
+    for (i = 0; i < last; i++) {
+        q = _isqrt((ry2 - i * i) << (2 * AA_SHIFT)) * rx / ry;
+        _aa_plot4(&aa, x, y, q >> AA_SHIFT, i, AA_ONE - (q & (AA_ONE - 1)),
+            sec);
+        _aa_plot4(&aa, x, y, (q >> AA_SHIFT) + 1, i, q & (AA_ONE - 1), sec);
+    }
+}
+RTM_EXPORT(rtgui_dc_aa_draw_ellipse);
+
+/* filled ellipse, as a polygon with chords shorter than 1/16 pixel error */
+void rtgui_dc_aa_fill_ellipse(rtgui_dc_t *dc, int x, int y, int rx, int ry) {
+    static const rt_uint8_t steps[] = { 15, 12, 10, 9, 8, 6, 5, 4, 3, 2, 1 };
+    rtgui_aa_t aa;
+    int *vx, *vy;
+    int i, num, step, cx, cy;
+
+    if ((dc == RT_NULL) || (rx <= 0) || (ry <= 0)) return;
+
+    /* sagitta r * (1 - cos(a / 2)) below 1/16 needs 360 / a > 9 * sqrt(r) */
+    num = 9 * _isqrt(_MAX(rx, ry)) + 9;
+    for (i = 0; i < (int)sizeof(steps) - 1; i++)
+        if (360 / steps[i] >= num) break;
+    step = steps[i];
+    num = 360 / step;
+
+    vx = (int *)rtgui_malloc(sizeof(int) * num * 2);
+    if (!vx) {
+        LOG_E("no mem for aa ellipse");
+        return;
+    }
+    vy = vx + num;
+
+    /* the aliased ellipse covers the pixel centers within r + 0.5 */
+    cx = x * AA_ONE + AA_ONE / 2;
+    cy = y * AA_ONE + AA_ONE / 2;
+    rx = rx * AA_ONE + AA_ONE / 2;
+    ry = ry * AA_ONE + AA_ONE / 2;
+    for (i = 0; i < num; i++) {
+        vx[i] = cx + _q15_round(rx * rtgui_cos_q15(i * step));
+        vy[i] = cy + _q15_round(ry * rtgui_sin_q15(i * step));
+    }
+
+    _aa_init(&aa, dc);
+    _aa_fill_polygon(&aa, vx, vy, num, RTGUI_FILL_EVEN_ODD);
+    rtgui_free(vx);
+}
+RTM_EXPORT(rtgui_dc_aa_fill_ellipse);
+
+/* polygon with vertices on pixel centers */
+void rtgui_dc_aa_fill_polygon(rtgui_dc_t *dc, const int *vx, const int *vy,
+    int count, rtgui_fill_rule_t rule) {
+    rtgui_aa_t aa;
+    int *qx, *qy;
+    int i;
+
+    if ((dc == RT_NULL) || (count < 3)) return;
+
+    qx = (int *)rtgui_malloc(sizeof(int) * count * 2);
+    if (!qx) {
+        LOG_E("no mem for aa polygon");
+        return;
+    }
+    qy = qx + count;
+    for (i = 0; i < count; i++) {
+        qx[i] = vx[i] * AA_ONE + AA_ONE / 2;
+        qy[i] = vy[i] * AA_ONE + AA_ONE / 2;
+    }
+
+    _aa_init(&aa, dc);
+    _aa_fill_polygon(&aa, qx, qy, count, rule);
+    rtgui_free(qx);
+}
+RTM_EXPORT(rtgui_dc_aa_fill_polygon);
+
+#endif /* RTGUI_USING_DC_AA */
@@ -0,0 +1,621 @@
+/*
+ * File      : dc_buffer.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-20     onelife      first version
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+#include "include/font/font.h"
+#include "include/blit.h"
+
+#ifdef RTGUI_USING_DC_BUFFER
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    " DC_BUF"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define display()                   (rtgui_get_gfx_device())
+#define TO_BUFFER(dc)               ((struct rtgui_dc_buffer *)(dc))
+#define ROW(buf, y)                 ((buf)->pixel + (buf)->pitch * (y))
+#define _int_swap(x, y)             \
+    do {                            \
+        x ^= y;                     \
+        y ^= x;                     \
+        x ^= y;                     \
+    } while (0)
+
+/* Private function prototypes -----------------------------------------------*/
+static void _dc_buffer_draw_point(rtgui_dc_t *dc, int x, int y);
+static void _dc_buffer_draw_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t color);
+static rt_bool_t _dc_buffer_get_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t *color);
+static void _dc_buffer_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y);
+static void _dc_buffer_draw_vline(rtgui_dc_t *dc, int x, int y1, int y2);
+static void _dc_buffer_draw_hspans(rtgui_dc_t *dc, rtgui_color_t *color,
+    const rtgui_span_t *spans, rt_uint32_t num);
+static void _dc_buffer_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
+static void _dc_buffer_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data);
+static void _dc_buffer_blend_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rtgui_color_t color, const rtgui_color_t *argb);
+static void _dc_buffer_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect);
+static rt_bool_t _dc_buffer_fini(rtgui_dc_t *dc);
+
+/* Private variables ---------------------------------------------------------*/
+const rtgui_dc_engine_t dc_buffer_engine = {
+    _dc_buffer_draw_point,
+    _dc_buffer_draw_color_point,
+    _dc_buffer_get_color_point,
+    _dc_buffer_draw_vline,
+    _dc_buffer_draw_hline,
+    _dc_buffer_draw_hspans,
+    _dc_buffer_fill_rect,
+    _dc_buffer_blit_line,
+    _dc_buffer_blend_line,
+    _dc_buffer_blit,
+    _dc_buffer_fini,
+};
+
+/* Private functions ---------------------------------------------------------*/
+/* Pixels are stored in the same layout as "draw_raw_hline" takes, so a buffer
+   in the display format is blitted without conversion. MONO is 1 bit per
+   pixel, LSB first. */
+static rt_uint8_t _get_bits_per_pixel(rt_uint8_t fmt) {
+    switch (fmt) {
+
+    #if (CONFIG_USING_MONO)
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        return 1;
+    #endif
+
+    #if (CONFIG_USING_RGB565)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return 16;
+    #endif
+
+    #if (CONFIG_USING_RGB565P)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return 16;
+    #endif
+
+    #if (CONFIG_USING_RGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return RTGUI_RGB888_PIXEL_BITS;
+    #endif
+
+    #if (CONFIG_USING_ARGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return 32;
+    #endif
+
+    default:
+        return 0;
+    }
+}
+
+static rtgui_color_t _color_to_pixel(rt_uint8_t fmt, rtgui_color_t color) {
+    switch (fmt) {
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        return rtgui_color_to_mono(color);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return rtgui_color_to_565(color);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return rtgui_color_to_565p(color);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return rtgui_color_to_888(color);
+
+    default:
+        return color;
+    }
+}
+
+static rtgui_color_t _pixel_to_color(rt_uint8_t fmt, rtgui_color_t pixel) {
+    switch (fmt) {
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        return rtgui_color_from_mono(pixel);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        #ifdef RTGUI_BIG_ENDIAN_OUTPUT
+            /* see RGB565_FROM_RGB() */
+            pixel = ((pixel & 0x00ff) << 8) | ((pixel & 0xff00) >> 8);
+        #endif
+        return rtgui_color_from_565((rt_uint16_t)pixel);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return rtgui_color_from_565p((rt_uint16_t)pixel);
+
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return rtgui_color_from_888(pixel);
+
+    default:
+        return pixel;
+    }
+}
+
+rt_inline void _pixel_put(rt_uint8_t *row, rt_uint8_t bits, rt_base_t x,
+    rtgui_color_t pixel) {
+    switch (bits) {
+    case 1:
+        if (pixel)
+            row[x >> 3] |= 1 << (x & 0x07);
+        else
+            row[x >> 3] &= ~(1 << (x & 0x07));
+        break;
+
+    case 16:
+        ((rt_uint16_t *)row)[x] = (rt_uint16_t)pixel;
+        break;
+
+    case 24:
+        /* see RGB888_FROM_RGB() */
+        row += x * 3;
+        row[0] = (pixel >> 16) & 0xff;
+        row[1] = (pixel >> 8) & 0xff;
+        row[2] = pixel & 0xff;
+        break;
+
+    default:
+        ((rt_uint32_t *)row)[x] = pixel;
+        break;
+    }
+}
+
+rt_inline rtgui_color_t _pixel_get(const rt_uint8_t *row, rt_uint8_t bits,
+    rt_base_t x) {
+    switch (bits) {
+    case 1:
+        return (row[x >> 3] >> (x & 0x07)) & 0x01;
+
+    case 16:
+        return ((const rt_uint16_t *)row)[x];
+
+    case 24:
+        row += x * 3;
+        return (row[0] << 16) | (row[1] << 8) | row[2];
+
+    default:
+        return ((const rt_uint32_t *)row)[x];
+    }
+}
+
+/* native pixel of gc colors, same as rtgui_gc_native_fg() but in the buffer
+   format */
+rt_inline rtgui_color_t _buffer_native_fg(struct rtgui_dc_buffer *buf) {
+    if (buf->gc.fg_key != buf->gc.foreground) {
+        buf->gc.fg_native = _color_to_pixel(buf->pixel_format,
+            buf->gc.foreground);
+        buf->gc.fg_key = buf->gc.foreground;
+    }
+    return buf->gc.fg_native;
+}
+
+rt_inline rtgui_color_t _buffer_native_bg(struct rtgui_dc_buffer *buf) {
+    if (buf->gc.bg_key != buf->gc.background) {
+        buf->gc.bg_native = _color_to_pixel(buf->pixel_format,
+            buf->gc.background);
+        buf->gc.bg_key = buf->gc.background;
+    }
+    return buf->gc.bg_native;
+}
+
+/* x2 is exclusive and already clipped */
+static void _buffer_hline(struct rtgui_dc_buffer *buf, rtgui_color_t pixel,
+    rt_base_t x1, rt_base_t x2, rt_base_t y) {
+    rt_uint8_t *row = ROW(buf, y);
+
+    switch (buf->bits_per_pixel) {
+    case 16:
+    {
+        rt_uint16_t *ptr = (rt_uint16_t *)row + x1;
+        rt_uint16_t *end = (rt_uint16_t *)row + x2;
+
+        while (ptr < end) *ptr++ = (rt_uint16_t)pixel;
+        break;
+    }
+
+    case 32:
+    {
+        rt_uint32_t *ptr = (rt_uint32_t *)row + x1;
+        rt_uint32_t *end = (rt_uint32_t *)row + x2;
+
+        while (ptr < end) *ptr++ = pixel;
+        break;
+    }
+
+    default:
+        for (; x1 < x2; x1++)
+            _pixel_put(row, buf->bits_per_pixel, x1, pixel);
+        break;
+    }
+}
+
+/* source-over "argb" pixels (or "color" if RT_NULL), x2 is exclusive and
+   already clipped */
+static void _buffer_blend(struct rtgui_dc_buffer *buf, rt_base_t x1,
+    rt_base_t x2, rt_base_t y, rtgui_color_t color,
+    const rtgui_color_t *argb) {
+    rt_uint8_t *row = ROW(buf, y);
+    rtgui_blend_fill_func fill;
+    rtgui_blend_line_func line;
+
+    if (argb) {
+        line = rtgui_get_blend_line_func(buf->pixel_format);
+        if (line) {
+            line(row + ((x1 * buf->bits_per_pixel) >> 3), argb, x2 - x1);
+            return;
+        }
+    } else {
+        fill = rtgui_get_blend_fill_func(buf->pixel_format);
+        if (fill) {
+            fill(row + ((x1 * buf->bits_per_pixel) >> 3), color, x2 - x1);
+            return;
+        }
+    }
+
+    /* no kernel, draw the more opaque half */
+    for (; x1 < x2; x1++) {
+        if (argb) color = *argb++;
+        if (RTGUI_RGB_A(color) & 0x80)
+            _pixel_put(row, buf->bits_per_pixel, x1,
+                _color_to_pixel(buf->pixel_format, color));
+    }
+}
+
+/* return RT_FALSE if nothing left */
+static rt_bool_t _buffer_clip_hline(struct rtgui_dc_buffer *buf,
+    rt_base_t *x1, rt_base_t *x2, rt_base_t y) {
+    if ((y < 0) || (y >= buf->height)) return RT_FALSE;
+    if (*x1 > *x2) _int_swap(*x1, *x2);
+    if (*x1 < 0) *x1 = 0;
+    if (*x2 > buf->width) *x2 = buf->width;
+    return (*x1 < *x2) ? RT_TRUE : RT_FALSE;
+}
+
+static void _dc_buffer_draw_point(rtgui_dc_t *self, int x, int y) {
+    struct rtgui_dc_buffer *buf;
+
+    if (!self) return;
+    buf = TO_BUFFER(self);
+    if ((x < 0) || (y < 0) || (x >= buf->width) || (y >= buf->height))
+        return;
+
+    if (RTGUI_GC_IS_BLEND(&buf->gc, buf->gc.foreground))
+        _buffer_blend(buf, x, x + 1, y, buf->gc.foreground, RT_NULL);
+    else
+        _pixel_put(ROW(buf, y), buf->bits_per_pixel, x,
+            _buffer_native_fg(buf));
+}
+
+static void _dc_buffer_draw_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t color) {
+    struct rtgui_dc_buffer *buf;
+
+    if (!self) return;
+    buf = TO_BUFFER(self);
+    if ((x < 0) || (y < 0) || (x >= buf->width) || (y >= buf->height))
+        return;
+
+    if (RTGUI_GC_IS_BLEND(&buf->gc, color))
+        _buffer_blend(buf, x, x + 1, y, color, RT_NULL);
+    else
+        _pixel_put(ROW(buf, y), buf->bits_per_pixel, x,
+            _color_to_pixel(buf->pixel_format, color));
+}
+
+static rt_bool_t _dc_buffer_get_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t *color) {
+    struct rtgui_dc_buffer *buf;
+
+    if (!self) return RT_FALSE;
+    buf = TO_BUFFER(self);
+    if ((x < 0) || (y < 0) || (x >= buf->width) || (y >= buf->height))
+        return RT_FALSE;
+
+    *color = _pixel_to_color(buf->pixel_format,
+        _pixel_get(ROW(buf, y), buf->bits_per_pixel, x));
+    return RT_TRUE;
+}
+
+static void _dc_buffer_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
+    struct rtgui_dc_buffer *buf;
+    rtgui_color_t pixel;
+    rt_uint8_t *row;
+
+    if (!self) return;
+    buf = TO_BUFFER(self);
+    if ((x < 0) || (x >= buf->width)) return;
+
+    if (y1 > y2) _int_swap(y1, y2);
+    if (y1 < 0) y1 = 0;
+    if (y2 > buf->height) y2 = buf->height;
+
+    if (RTGUI_GC_IS_BLEND(&buf->gc, buf->gc.foreground)) {
+        for (; y1 < y2; y1++)
+            _buffer_blend(buf, x, x + 1, y1, buf->gc.foreground, RT_NULL);
+        return;
+    }
+
+    pixel = _buffer_native_fg(buf);
+    for (row = ROW(buf, y1); y1 < y2; y1++, row += buf->pitch)
+        _pixel_put(row, buf->bits_per_pixel, x, pixel);
+}
+
+static void _dc_buffer_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
+    struct rtgui_dc_buffer *buf;
+    rt_base_t _x1 = x1, _x2 = x2;
+
+    if (!self) return;
+    buf = TO_BUFFER(self);
+    if (!_buffer_clip_hline(buf, &_x1, &_x2, y)) return;
+
+    if (RTGUI_GC_IS_BLEND(&buf->gc, buf->gc.foreground))
+        _buffer_blend(buf, _x1, _x2, y, buf->gc.foreground, RT_NULL);
+    else
+        _buffer_hline(buf, _buffer_native_fg(buf), _x1, _x2, y);
+}
+
+static void _dc_buffer_draw_hspans(rtgui_dc_t *self, rtgui_color_t *color,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    struct rtgui_dc_buffer *buf;
+    rtgui_color_t pixel;
+    rt_base_t x1, x2;
+    rt_bool_t blend;
+
+    if (!self) return;
+    buf = TO_BUFFER(self);
+    blend = RTGUI_GC_IS_BLEND(&buf->gc, color ? *color : buf->gc.foreground);
+    if (blend)
+        pixel = color ? *color : buf->gc.foreground;
+    else if (color)
+        pixel = _color_to_pixel(buf->pixel_format, *color);
+    else
+        pixel = _buffer_native_fg(buf);
+
+    for (; num; num--, spans++) {
+        x1 = spans->x1;
+        x2 = spans->x2;
+        if (!_buffer_clip_hline(buf, &x1, &x2, spans->y)) continue;
+        if (blend)
+            _buffer_blend(buf, x1, x2, spans->y, pixel, RT_NULL);
+        else
+            _buffer_hline(buf, pixel, x1, x2, spans->y);
+    }
+}
+
+static void _dc_buffer_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
+    struct rtgui_dc_buffer *buf;
+    rt_base_t x1, y1, x2, y2;
+    rtgui_color_t pixel;
+
+    if (!self || !rect) return;
+    buf = TO_BUFFER(self);
+
+    x1 = _MAX(rect->x1, 0);
+    y1 = _MAX(rect->y1, 0);
+    x2 = _MIN(rect->x2, buf->width);
+    y2 = _MIN(rect->y2, buf->height);
+    if ((x1 >= x2) || (y1 >= y2)) return;
+
+    if (RTGUI_GC_IS_BLEND(&buf->gc, buf->gc.background)) {
+        for (; y1 < y2; y1++)
+            _buffer_blend(buf, x1, x2, y1, buf->gc.background, RT_NULL);
+        return;
+    }
+
+    pixel = _buffer_native_bg(buf);
+    _buffer_hline(buf, pixel, x1, x2, y1);
+
+    if (buf->bits_per_pixel >= 8) {
+        /* copy the first row */
+        rt_uint8_t *src = ROW(buf, y1) + ((x1 * buf->bits_per_pixel) >> 3);
+        rt_uint8_t *dst = src + buf->pitch;
+        rt_uint32_t len = ((x2 - x1) * buf->bits_per_pixel) >> 3;
+
+        for (y1++; y1 < y2; y1++, dst += buf->pitch)
+            rt_memcpy(dst, src, len);
+    } else {
+        for (y1++; y1 < y2; y1++)
+            _buffer_hline(buf, pixel, x1, x2, y1);
+    }
+}
+
+/* "line_data" is in the buffer format and starts at x1 */
+static void _dc_buffer_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rt_uint8_t *line_data) {
+    struct rtgui_dc_buffer *buf;
+    rt_base_t _x1, _x2;
+    rt_uint8_t *row;
+
+    if (!self || !line_data) return;
+    buf = TO_BUFFER(self);
+    if (x1 > x2) _int_swap(x1, x2);
+    _x1 = x1;
+    _x2 = x2;
+    if (!_buffer_clip_hline(buf, &_x1, &_x2, y)) return;
+
+    row = ROW(buf, y);
+    if (buf->bits_per_pixel >= 8) {
+        rt_memcpy(row + ((_x1 * buf->bits_per_pixel) >> 3),
+            line_data + (((_x1 - x1) * buf->bits_per_pixel) >> 3),
+            ((_x2 - _x1) * buf->bits_per_pixel) >> 3);
+    } else {
+        rt_base_t i;
+
+        for (i = _x1 - x1; _x1 < _x2; _x1++, i++)
+            _pixel_put(row, 1, _x1, _pixel_get(line_data, 1, i));
+    }
+}
+
+static void _dc_buffer_blend_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rtgui_color_t color, const rtgui_color_t *argb) {
+    struct rtgui_dc_buffer *buf;
+    rt_base_t _x1 = x1, _x2 = x2;
+
+    if (!self || (x1 >= x2)) return;
+    buf = TO_BUFFER(self);
+    if (!_buffer_clip_hline(buf, &_x1, &_x2, y)) return;
+
+    _buffer_blend(buf, _x1, _x2, y, color, argb ? argb + (_x1 - x1) : RT_NULL);
+}
+
+/* blit (dc_point.x, dc_point.y) of the buffer to "rect" of "dest", the
+   clipping of "dest" is done by its "blit_line" */
+static void _dc_buffer_blit(rtgui_dc_t *self, struct rtgui_point *dc_point,
+    rtgui_dc_t *dest, rtgui_rect_t *rect) {
+    struct rtgui_dc_buffer *buf;
+    rt_uint8_t *line = RT_NULL;
+    rt_uint8_t *src, *data;
+    rt_uint8_t dst_fmt, dst_bits;
+    rt_base_t sx, sy, w, h, x, y;
+    rt_bool_t direct;
+
+    if (!self || !dest || !rect) return;
+    buf = TO_BUFFER(self);
+
+    sx = dc_point ? _MAX(dc_point->x, 0) : 0;
+    sy = dc_point ? _MAX(dc_point->y, 0) : 0;
+    w = _MIN(rect->x2 - rect->x1, buf->width - sx);
+    h = _MIN(rect->y2 - rect->y1, buf->height - sy);
+    if ((w <= 0) || (h <= 0)) return;
+
+    dst_fmt = rtgui_dc_get_pixel_format(dest);
+    if (dest->type == RTGUI_DC_BUFFER)
+        dst_bits = TO_BUFFER(dest)->bits_per_pixel;
+    else
+        dst_bits = display()->bits_per_pixel;
+
+    /* same layout and byte aligned, blit the rows in place */
+    direct = (dst_fmt == buf->pixel_format) && \
+        (dst_bits == buf->bits_per_pixel) && \
+        ((buf->bits_per_pixel >= 8) || !(sx & 0x07));
+    if (!direct) {
+        line = rtgui_malloc(_BIT2BYTE(w * dst_bits));
+        if (!line) {
+            LOG_E("no mem for blit");
+            return;
+        }
+    }
+
+    src = ROW(buf, sy);
+    for (y = 0; y < h; y++, src += buf->pitch) {
+        if (direct) {
+            data = src + ((sx * buf->bits_per_pixel) >> 3);
+        } else {
+            for (x = 0; x < w; x++)
+                _pixel_put(line, dst_bits, x, _color_to_pixel(dst_fmt,
+                    _pixel_to_color(buf->pixel_format,
+                        _pixel_get(src, buf->bits_per_pixel, sx + x))));
+            data = line;
+        }
+        dest->engine->blit_line(dest, rect->x1, rect->x1 + w, rect->y1 + y,
+            data);
+    }
+
+    if (line) rtgui_free(line);
+}
+
+static rt_bool_t _dc_buffer_fini(rtgui_dc_t *dc) {
+    if (!dc || (dc->type != RTGUI_DC_BUFFER)) return RT_FALSE;
+
+    /* the dc itself is freed by rtgui_dc_destory() */
+    rtgui_free(TO_BUFFER(dc)->pixel);
+    TO_BUFFER(dc)->pixel = RT_NULL;
+    return RT_TRUE;
+}
+
+/* Public functions ----------------------------------------------------------*/
+rtgui_dc_t *rtgui_dc_buffer_create_pixformat(rt_uint8_t pixel_format,
+    int width, int height) {
+    struct rtgui_dc_buffer *dc = RT_NULL;
+
+    do {
+        rt_uint8_t bits = _get_bits_per_pixel(pixel_format);
+
+        if (!bits) {
+            LOG_E("bad format %d", pixel_format);
+            break;
+        }
+        if ((width <= 0) || (height <= 0)) {
+            LOG_E("bad size %dx%d", width, height);
+            break;
+        }
+
+        dc = (struct rtgui_dc_buffer *)rtgui_malloc(
+            sizeof(struct rtgui_dc_buffer));
+        if (!dc) {
+            LOG_E("no mem for dc");
+            break;
+        }
+        dc->pitch = _BIT2BYTE(width * bits);
+        dc->pixel = rtgui_malloc(dc->pitch * height);
+        if (!dc->pixel) {
+            rtgui_free(dc);
+            dc = RT_NULL;
+            LOG_E("no mem for pixel");
+            break;
+        }
+        rt_memset(dc->pixel, 0x00, dc->pitch * height);
+
+        dc->_super.type = RTGUI_DC_BUFFER;
+        dc->_super.engine = &dc_buffer_engine;
+        dc->pixel_format = pixel_format;
+        dc->bits_per_pixel = bits;
+        dc->width = width;
+        dc->height = height;
+        dc->gc.foreground = default_foreground;
+        dc->gc.background = default_background;
+        dc->gc.textstyle = RTGUI_TEXTSTYLE_NORMAL;
+        dc->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+        dc->gc.drawstyle = RTGUI_DRAWSTYLE_NORMAL;
+        dc->gc.font = rtgui_font_default();
+        rtgui_gc_invalidate(&dc->gc);
+        LOG_D("buffer dc %dx%d, fmt %d", width, height, pixel_format);
+    } while (0);
+
+    return dc ? &dc->_super : RT_NULL;
+}
+RTM_EXPORT(rtgui_dc_buffer_create_pixformat);
+
+rtgui_dc_t *rtgui_dc_buffer_create(int width, int height) {
+    return rtgui_dc_buffer_create_pixformat(display()->pixel_format, width,
+        height);
+}
+RTM_EXPORT(rtgui_dc_buffer_create);
+
+rt_uint8_t *rtgui_dc_buffer_get_pixel(rtgui_dc_t *dc) {
+    if (!dc || (dc->type != RTGUI_DC_BUFFER)) return RT_NULL;
+    return TO_BUFFER(dc)->pixel;
+}
+RTM_EXPORT(rtgui_dc_buffer_get_pixel);
+
+#endif /* RTGUI_USING_DC_BUFFER */
@@ -49,33 +49,96 @@
         y ^= x;                             \
         x ^= y;                             \
     } while (0)
+#define _span_add(ops, spans, cnt, color, _x1, _x2, _y) \
+    do {                                    \
+        spans[cnt].x1 = _x1;                \
+        spans[cnt].x2 = _x2;                \
+        spans[cnt].y = _y;                  \
+        if (++cnt >= RTGUI_SPAN_BATCH_SIZE) { \
+            ops->draw_hspans(color, spans, cnt); \
+            cnt = 0;                        \
+        }                                   \
+    } while (0)
+#ifdef RTGUI_USING_DC_STAT
+# define DC_STAT_INC(name)                  _stat.name++
+#else
+# define DC_STAT_INC(name)
+#endif
 
 /* Private function prototypes -----------------------------------------------*/
 static void _dc_client_draw_point(rtgui_dc_t *dc, int x, int y);
 static void _dc_client_draw_color_point(rtgui_dc_t *dc, int x, int y,
     rtgui_color_t color);
+static rt_bool_t _dc_client_get_color_point(rtgui_dc_t *dc, int x, int y,
+    rtgui_color_t *color);
 static void _dc_client_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y);
 static void _dc_client_draw_vline(rtgui_dc_t *dc, int x, int y1, int y2);
+static void _dc_client_draw_hspans(rtgui_dc_t *dc, rtgui_color_t *color,
+    const rtgui_span_t *spans, rt_uint32_t num);
 static void _dc_client_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 static void _dc_client_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
     rt_uint8_t *line_data);
+static void _dc_client_blend_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rtgui_color_t color, const rtgui_color_t *argb);
 static void _dc_client_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
     rtgui_dc_t *dest, rtgui_rect_t *rect);
 static rt_bool_t _dc_client_uninit(rtgui_dc_t *dc);
 
 /* Private variables ---------------------------------------------------------*/
+/* last clip band found, drawing is serialized by rtgui_screen_lock() */
+static rtgui_region_band_t _band;
+#ifdef RTGUI_USING_DC_STAT
+static rtgui_dc_stat_t _stat;
+#endif
+
 const rtgui_dc_engine_t dc_client_engine = {
     _dc_client_draw_point,
     _dc_client_draw_color_point,
+    _dc_client_get_color_point,
     _dc_client_draw_vline,
     _dc_client_draw_hline,
+    _dc_client_draw_hspans,
     _dc_client_fill_rect,
     _dc_client_blit_line,
+    _dc_client_blend_line,
     _dc_client_blit,
     _dc_client_uninit,
 };
 
 /* Private functions ---------------------------------------------------------*/
+/* clip rects of the band containing "y", the clip region is y-x banded */
+static rtgui_rect_t *_clip_band(rtgui_region_t *clip, int y,
+    rt_uint32_t *num) {
+    rtgui_rect_t *rect;
+
+    *num = rtgui_region_find_band(clip, y, &_band);
+    if (!*num) return RT_NULL;
+    rect = rtgui_region_rects(clip) + _band.idx;
+    if (rect->y1 > y) {
+        *num = 0;
+        return RT_NULL;
+    }
+    return rect;
+}
+
+/* blend on the visible part of device line (x1, y) - (x2, y) */
+static void _dc_client_blend_clipped(rtgui_widget_t *owner, int x1, int x2,
+    int y, rtgui_color_t color, const rtgui_color_t *argb) {
+    rtgui_rect_t *rect;
+    rt_base_t draw_x1;
+    rt_uint32_t num;
+
+    for (rect = _clip_band(&(owner->clip), y, &num); num; num--, rect++) {
+        DC_STAT_INC(clip_rects);
+        if (rect->x2 <= x1) continue;
+        if (rect->x1 >= x2) break;
+
+        draw_x1 = _MAX(rect->x1, x1);
+        rtgui_gfx_blend_hline(draw_x1, _MIN(rect->x2, x2), y, color,
+            argb ? argb + (draw_x1 - x1) : RT_NULL);
+    }
+}
+
 static void _dc_client_draw_point(rtgui_dc_t *self, int x, int y) {
     return _dc_client_draw_color_point(self, x, y, RT_NULL);
 }
@@ -83,25 +146,62 @@ static void _dc_client_draw_point(rtgui_dc_t *self, int x, int y) {
 static void _dc_client_draw_color_point(rtgui_dc_t *self, int x, int y,
     rtgui_color_t color) {
     rtgui_widget_t *owner;
-    rtgui_rect_t rect;
+    rtgui_rect_t *rect;
+    rt_uint32_t num;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
 
     x += owner->extent.x1;
     y += owner->extent.y1;
+    if (!color) color = owner->gc.foreground;
+    if (RTGUI_GC_IS_BLEND(&owner->gc, color)) {
+        _dc_client_blend_clipped(owner, x, x + 1, y, color, RT_NULL);
+        return;
+    }
 
-    if (rtgui_region_contains_point(&(owner->clip), x, y, &rect)) {
-        if (color)
+    for (rect = _clip_band(&(owner->clip), y, &num); num; num--, rect++) {
+        DC_STAT_INC(clip_rects);
+        if (rect->x2 <= x) continue;
+        if (rect->x1 > x) break;
+
+        if (color != owner->gc.foreground)
             display()->ops->set_pixel(&color, x, y);
         else
-            display()->ops->set_pixel(&(owner->gc.foreground), x, y);
+            display()->native_ops->set_pixel(rtgui_gc_native_fg(&owner->gc),
+                x, y);
+        break;
     }
 }
 
+static rt_bool_t _dc_client_get_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t *color) {
+    rtgui_widget_t *owner;
+    rtgui_rect_t *rect;
+    rt_uint32_t num;
+
+    if (!self || !rtgui_dc_get_visible(self)) return RT_FALSE;
+    owner = rt_container_of(self, rtgui_widget_t, dc_type);
+
+    x += owner->extent.x1;
+    y += owner->extent.y1;
+
+    for (rect = _clip_band(&(owner->clip), y, &num); num; num--, rect++) {
+        DC_STAT_INC(clip_rects);
+        if (rect->x2 <= x) continue;
+        if (rect->x1 > x) break;
+
+        display()->ops->get_pixel(color, x, y);
+        return RT_TRUE;
+    }
+    return RT_FALSE;
+}
+
 static void _dc_client_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     rtgui_widget_t *owner;
     rtgui_rect_t *rect;
+    rtgui_color_t *pixel;
+    rt_uint32_t num;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -110,28 +210,28 @@ static void _dc_client_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     y1 += owner->extent.y1;
     y2 += owner->extent.y1;
     if (y1 > y2) _int_swap(y1, y2);
+    if (RTGUI_GC_IS_BLEND(&owner->gc, owner->gc.foreground)) {
+        for (; y1 < y2; y1++)
+            _dc_client_blend_clipped(owner, x, x + 1, y1,
+                owner->gc.foreground, RT_NULL);
+        return;
+    }
 
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_VL_INTERSECT(rect, x, y1, y2)) return;
-
-        if (y1 < rect->y1) y1 = rect->y1;
-        if (y2 > rect->y2) y2 = rect->y2;
-        display()->ops->draw_vline(&(owner->gc.foreground), x, y1, y2);
-    } else {
-        register rt_uint32_t idx;
-        register rt_base_t draw_y1, draw_y2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_y1 = y1;
-            draw_y2 = y2;
-            if (!IS_VL_INTERSECT(rect, x, y1, y2)) continue;
-
-            if (rect->y1 > y1) draw_y1 = rect->y1;
-            if (rect->y2 < y2) draw_y2 = rect->y2;
-            display()->ops->draw_vline(&(owner->gc.foreground), x, draw_y1,
-                draw_y2);
+    pixel = rtgui_gc_native_fg(&owner->gc);
+    /* one rect at most in each band */
+    num = rtgui_region_find_band(&(owner->clip), y1, &_band);
+    for (; num; num = rtgui_region_next_band(&(owner->clip), &_band)) {
+        rect = rtgui_region_rects(&(owner->clip)) + _band.idx;
+        if (rect->y1 >= y2) break;
+
+        for (; num; num--, rect++) {
+            DC_STAT_INC(clip_rects);
+            if (rect->x2 <= x) continue;
+            if (rect->x1 > x) break;
+
+            display()->native_ops->draw_vline(pixel, x, _MAX(rect->y1, y1),
+                _MIN(rect->y2, y2));
+            break;
         }
     }
 }
@@ -139,6 +239,8 @@ static void _dc_client_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
 static void _dc_client_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     rtgui_widget_t *owner;
     rtgui_rect_t *rect;
+    rtgui_color_t *pixel;
+    rt_uint32_t num;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -147,55 +249,132 @@ static void _dc_client_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     x2 += owner->extent.x1;
     y  += owner->extent.y1;
     if (x1 > x2) _int_swap(x1, x2);
+    if (RTGUI_GC_IS_BLEND(&owner->gc, owner->gc.foreground)) {
+        _dc_client_blend_clipped(owner, x1, x2, y, owner->gc.foreground,
+            RT_NULL);
+        return;
+    }
+
+    pixel = rtgui_gc_native_fg(&owner->gc);
+    for (rect = _clip_band(&(owner->clip), y, &num); num; num--, rect++) {
+        DC_STAT_INC(clip_rects);
+        if (rect->x2 <= x1) continue;
+        if (rect->x1 >= x2) break;
+
+        display()->native_ops->draw_hline(pixel, _MAX(rect->x1, x1),
+            _MIN(rect->x2, x2), y);
+    }
+}
+
+static void _dc_client_draw_hspans(rtgui_dc_t *self, rtgui_color_t *color,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    rtgui_widget_t *owner;
+    rtgui_rect_t *rect;
+    const struct rtgui_graphic_driver_ops *ops;
+    rtgui_span_t clipped[RTGUI_SPAN_BATCH_SIZE];
+    register rt_uint32_t cnt;
+    register rt_base_t x1, x2, y;
+    rt_uint32_t rects;
+
+    if (!self || !rtgui_dc_get_visible(self)) return;
+    owner = rt_container_of(self, rtgui_widget_t, dc_type);
+
+    if (RTGUI_GC_IS_BLEND(&owner->gc, color ? *color : owner->gc.foreground)) {
+        rtgui_color_t c = color ? *color : owner->gc.foreground;
 
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_HL_INTERSECT(rect, x1, x2, y)) return;
+        for (; num; num--, spans++) {
+            x1 = spans->x1 + owner->extent.x1;
+            x2 = spans->x2 + owner->extent.x1;
+            if (x1 > x2) _int_swap(x1, x2);
+            _dc_client_blend_clipped(owner, x1, x2,
+                spans->y + owner->extent.y1, c, RT_NULL);
+        }
+        return;
+    }
 
-        if (rect->x1 > x1) x1 = rect->x1;
-        if (rect->x2 < x2) x2 = rect->x2;
-        display()->ops->draw_hline(&(owner->gc.foreground), x1, x2, y);
+    if (color) {
+        ops = display()->ops;
     } else {
-        register rt_uint32_t idx;
-        register rt_base_t draw_x1, draw_x2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_x1 = x1;
-            draw_x2 = x2;
-            if (!IS_HL_INTERSECT(rect, x1, x2, y)) continue;
-
-            if (rect->x1 > x1) draw_x1 = rect->x1;
-            if (rect->x2 < x2) draw_x2 = rect->x2;
-            display()->ops->draw_hline(&(owner->gc.foreground), draw_x1,
-                draw_x2, y);
+        ops = display()->native_ops;
+        color = rtgui_gc_native_fg(&owner->gc);
+    }
+
+    for (cnt = 0; num; num--, spans++) {
+        x1 = spans->x1 + owner->extent.x1;
+        x2 = spans->x2 + owner->extent.x1;
+        y  = spans->y  + owner->extent.y1;
+        if (x1 > x2) _int_swap(x1, x2);
+
+        /* consecutive scanlines hit the cached band */
+        for (rect = _clip_band(&(owner->clip), y, &rects); rects;
+            rects--, rect++) {
+            DC_STAT_INC(clip_rects);
+            if (rect->x2 <= x1) continue;
+            if (rect->x1 >= x2) break;
+
+            _span_add(ops, clipped, cnt, color, _MAX(rect->x1, x1),
+                _MIN(rect->x2, x2), y);
         }
     }
+
+    if (cnt)
+        ops->draw_hspans(color, clipped, cnt);
+}
+
+static void _dc_client_fill_clipped(rtgui_rect_t *clip, rtgui_rect_t *rect,
+    rtgui_color_t *pixel) {
+    rt_base_t x1, y1, x2, y2;
+
+    DC_STAT_INC(clip_rects);
+    x1 = _MAX(clip->x1, rect->x1);
+    y1 = _MAX(clip->y1, rect->y1);
+    x2 = _MIN(clip->x2, rect->x2);
+    y2 = _MIN(clip->y2, rect->y2);
+    if ((x1 >= x2) || (y1 >= y2)) return;
+
+    display()->native_ops->fill_rect(pixel, x1, y1, x2, y2);
 }
 
 static void _dc_client_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
-    register rt_base_t idx;
     rtgui_widget_t *owner;
-    rtgui_color_t fc;
+    rtgui_rect_t dev_rect, *clip;
+    rtgui_color_t *pixel;
+    rt_uint32_t num;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
 
-    fc = owner->gc.foreground;
-    owner->gc.foreground = owner->gc.background;
-
-    /* fill rect */
-    for (idx = rect->y1; idx < rect->y2; idx++)
-        _dc_client_draw_hline(self, rect->x1, rect->x2, idx);
+    /* convert logic to device */
+    dev_rect = *rect;
+    rtgui_rect_move(&dev_rect, owner->extent.x1, owner->extent.y1);
+    if (RTGUI_GC_IS_BLEND(&owner->gc, owner->gc.background)) {
+        for (; dev_rect.y1 < dev_rect.y2; dev_rect.y1++)
+            _dc_client_blend_clipped(owner, dev_rect.x1, dev_rect.x2,
+                dev_rect.y1, owner->gc.background, RT_NULL);
+        return;
+    }
 
-    owner->gc.foreground = fc;
+    /* one fill for each intersection of rect and clip region */
+    pixel = rtgui_gc_native_bg(&owner->gc);
+    num = rtgui_region_find_band(&(owner->clip), dev_rect.y1, &_band);
+    for (; num; num = rtgui_region_next_band(&(owner->clip), &_band)) {
+        clip = rtgui_region_rects(&(owner->clip)) + _band.idx;
+        if (clip->y1 >= dev_rect.y2) break;
+
+        for (; num; num--, clip++) {
+            if (clip->x2 <= dev_rect.x1) continue;
+            if (clip->x1 >= dev_rect.x2) break;
+            _dc_client_fill_clipped(clip, &dev_rect, pixel);
+        }
+    }
 }
 
 static void _dc_client_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
     rt_uint8_t *line_data) {
     rtgui_widget_t *owner;
     rtgui_rect_t *rect;
-    rt_base_t offset;
+    rt_base_t draw_x1, offset;
+    rt_uint32_t num;
 
     if (!self || !rtgui_dc_get_visible(self)) return;
     owner = rt_container_of(self, rtgui_widget_t, dc_type);
@@ -206,45 +385,38 @@ static void _dc_client_blit_line(rtgui_dc_t *self, int x1, int x2, int y,
     y  += owner->extent.y1;
     if (x1 > x2) _int_swap(x1, x2);
 
-    if (rtgui_region_is_flat(&(owner->clip))) {
-        rect = &(owner->clip.extents);
-        if (!IS_HL_INTERSECT(rect, x1, x2, y)) return;
-
-        if (rect->x1 > x1) x1 = rect->x1;
-        if (rect->x2 < x2) x2 = rect->x2;
-        /* patch note:
-         * We need to adjust the offset when update widget clip!
-         * Of course at ordinary times for 0. General */
-        offset = (owner->clip.extents.x1 - owner->extent.x1) * \
-            _BIT2BYTE(display()->bits_per_pixel);
-        /* draw hline */
-        display()->ops->draw_raw_hline(line_data + offset, x1, x2, y);
-    } else {
-        register rt_ubase_t idx;
-        register rt_base_t draw_x1, draw_x2;
-
-        for (idx = 1; idx <= rtgui_region_num_rects(&(owner->clip)); idx++) {
-            rect = ((rtgui_rect_t *)(owner->clip.data + idx));
-            draw_x1 = x1;
-            draw_x2 = x2;
-            if (!IS_HL_INTERSECT(rect, x1, x2, y)) continue;
-
-            if (rect->x1 > x1) draw_x1 = rect->x1;
-            if (rect->x2 < x2) draw_x2 = rect->x2;
-            offset = (draw_x1 - x1) * _BIT2BYTE(display()->bits_per_pixel);
-            display()->ops->draw_raw_hline(line_data + offset, draw_x1,
-                draw_x2, y);
-        }
+    for (rect = _clip_band(&(owner->clip), y, &num); num; num--, rect++) {
+        DC_STAT_INC(clip_rects);
+        if (rect->x2 <= x1) continue;
+        if (rect->x1 >= x2) break;
+
+        /* skip the clipped head of "line_data" */
+        draw_x1 = _MAX(rect->x1, x1);
+        offset = (draw_x1 - x1) * _BIT2BYTE(display()->bits_per_pixel);
+        display()->ops->draw_raw_hline(line_data + offset, draw_x1,
+            _MIN(rect->x2, x2), y);
     }
 }
 
+static void _dc_client_blend_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rtgui_color_t color, const rtgui_color_t *argb) {
+    rtgui_widget_t *owner;
+
+    if (!self || !rtgui_dc_get_visible(self) || (x1 >= x2)) return;
+    owner = rt_container_of(self, rtgui_widget_t, dc_type);
+
+    /* convert logic to device */
+    _dc_client_blend_clipped(owner, x1 + owner->extent.x1,
+        x2 + owner->extent.x1, y + owner->extent.y1, color, argb);
+}
+
 static void _dc_client_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
     rtgui_dc_t *dest, rtgui_rect_t *rect) {
     (void)dc;
     (void)dc_point;
     (void)dest;
     (void)rect;
-    /* no blit in hardware dc? */
+    /* client dc is not readable, use buffer dc as source */
     LOG_E("no client dc blit");
 }
 
@@ -268,3 +440,11 @@ rtgui_dc_t *rtgui_dc_client_create(rtgui_widget_t *owner) {
 
     return WIDGET_DC(owner);
 }
+
+#ifdef RTGUI_USING_DC_STAT
+void rtgui_dc_client_get_stat(rtgui_dc_stat_t *stat, rt_bool_t reset) {
+    if (stat) *stat = _stat;
+    if (reset) rt_memset(&_stat, 0x00, sizeof(_stat));
+}
+RTM_EXPORT(rtgui_dc_client_get_stat);
+#endif
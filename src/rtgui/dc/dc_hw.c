@@ -37,10 +37,13 @@
 
 static void rtgui_dc_hw_draw_point(rtgui_dc_t *dc, int x, int y);
 static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *dc, int x, int y, rtgui_color_t color);
+static rt_bool_t rtgui_dc_hw_get_color_point(rtgui_dc_t *dc, int x, int y, rtgui_color_t *color);
 static void rtgui_dc_hw_draw_hline(rtgui_dc_t *dc, int x1, int x2, int y);
 static void rtgui_dc_hw_draw_vline(rtgui_dc_t *dc, int x, int y1, int y2);
+static void rtgui_dc_hw_draw_hspans(rtgui_dc_t *dc, rtgui_color_t *color, const rtgui_span_t *spans, rt_uint32_t num);
 static void rtgui_dc_hw_fill_rect(rtgui_dc_t *dc, rtgui_rect_t *rect);
 static void rtgui_dc_hw_blit_line(rtgui_dc_t *self, int x1, int x2, int y, rt_uint8_t *line_data);
+static void rtgui_dc_hw_blend_line(rtgui_dc_t *self, int x1, int x2, int y, rtgui_color_t color, const rtgui_color_t *argb);
 static void rtgui_dc_hw_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point, rtgui_dc_t *dest, rtgui_rect_t *rect);
 static rt_bool_t rtgui_dc_hw_fini(rtgui_dc_t *dc);
 
@@ -48,15 +51,61 @@ const rtgui_dc_engine_t dc_hw_engine =
 {
     rtgui_dc_hw_draw_point,
     rtgui_dc_hw_draw_color_point,
+    rtgui_dc_hw_get_color_point,
     rtgui_dc_hw_draw_vline,
     rtgui_dc_hw_draw_hline,
+    rtgui_dc_hw_draw_hspans,
     rtgui_dc_hw_fill_rect,
     rtgui_dc_hw_blit_line,
+    rtgui_dc_hw_blend_line,
     rtgui_dc_hw_blit,
 
     rtgui_dc_hw_fini,
 };
 
+#if (RTGUI_DC_HW_POOL_SIZE > 32)
+# error "RTGUI_DC_HW_POOL_SIZE must not exceed 32"
+#endif
+
+#if (RTGUI_DC_HW_POOL_SIZE > 0)
+/* hardware dc pool, create and fini are serialized by rtgui_screen_lock() */
+static struct rtgui_dc_hw _dc_hw_pool[RTGUI_DC_HW_POOL_SIZE];
+static rt_uint32_t _dc_hw_pool_used;
+
+static struct rtgui_dc_hw *_dc_hw_pool_alloc(void)
+{
+    rt_uint32_t i;
+
+    for (i = 0; i < RTGUI_DC_HW_POOL_SIZE; i++)
+    {
+        if (_dc_hw_pool_used & (1UL << i)) continue;
+        _dc_hw_pool_used |= 1UL << i;
+        #ifdef RTGUI_MEM_TRACE
+            rtgui_mem_pool_alloc_hook(RT_TRUE);
+        #endif
+        return &_dc_hw_pool[i];
+    }
+
+    /* nested too deep */
+    #ifdef RTGUI_MEM_TRACE
+        rtgui_mem_pool_alloc_hook(RT_FALSE);
+    #endif
+    return RT_NULL;
+}
+
+static rt_bool_t _dc_hw_pool_free(struct rtgui_dc_hw *dc)
+{
+    if ((dc < _dc_hw_pool) || (dc >= &_dc_hw_pool[RTGUI_DC_HW_POOL_SIZE]))
+        return RT_FALSE;
+
+    _dc_hw_pool_used &= ~(1UL << (dc - _dc_hw_pool));
+    #ifdef RTGUI_MEM_TRACE
+        rtgui_mem_pool_free_hook();
+    #endif
+    return RT_TRUE;
+}
+#endif /* RTGUI_DC_HW_POOL_SIZE > 0 */
+
 rtgui_dc_t *rtgui_dc_hw_create(rtgui_widget_t *owner)
 {
     struct rtgui_dc_hw *dc;
@@ -64,8 +113,13 @@ rtgui_dc_t *rtgui_dc_hw_create(rtgui_widget_t *owner)
     /* adjudge owner */
     if (owner == RT_NULL || owner->toplevel == RT_NULL) return RT_NULL;
 
-    /* create DC */
-    dc = (struct rtgui_dc_hw *) rtgui_malloc(sizeof(struct rtgui_dc_hw));
+    /* create DC, from pool if available */
+    dc = RT_NULL;
+    #if (RTGUI_DC_HW_POOL_SIZE > 0)
+        dc = _dc_hw_pool_alloc();
+    #endif
+    if (!dc)
+        dc = (struct rtgui_dc_hw *) rtgui_malloc(sizeof(struct rtgui_dc_hw));
     if (dc)
     {
         dc->_super.type = RTGUI_DC_HW;
@@ -84,6 +138,9 @@ static rt_bool_t rtgui_dc_hw_fini(rtgui_dc_t *dc)
     if (dc == RT_NULL || dc->type != RTGUI_DC_HW) return RT_FALSE;
 
     /* release hardware dc */
+    #if (RTGUI_DC_HW_POOL_SIZE > 0)
+        if (_dc_hw_pool_free((struct rtgui_dc_hw *)dc)) return RT_TRUE;
+    #endif
     rtgui_free(dc);
 
     return RT_TRUE;
@@ -105,8 +162,14 @@ static void rtgui_dc_hw_draw_point(rtgui_dc_t *self, int x, int y) {
     y = y + dc->owner->extent.y1;
     if (y > dc->owner->extent.y2) return;
 
+    if (RTGUI_GC_IS_BLEND(&dc->owner->gc, dc->owner->gc.foreground)) {
+        rtgui_gfx_blend_hline(x, x + 1, y, dc->owner->gc.foreground, RT_NULL);
+        return;
+    }
+
     /* draw this point */
-    dc->hw_driver->ops->set_pixel(&(dc->owner->gc.foreground), x, y);
+    dc->hw_driver->native_ops->set_pixel(rtgui_gc_native_fg(&dc->owner->gc),
+        x, y);
 }
 
 static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *self, int x, int y,
@@ -123,10 +186,33 @@ static void rtgui_dc_hw_draw_color_point(rtgui_dc_t *self, int x, int y,
     y = y + dc->owner->extent.y1;
     if (y > dc->owner->extent.y2) return;
 
+    if (RTGUI_GC_IS_BLEND(&dc->owner->gc, color)) {
+        rtgui_gfx_blend_hline(x, x + 1, y, color, RT_NULL);
+        return;
+    }
+
     /* draw this point */
     dc->hw_driver->ops->set_pixel(&color, x, y);
 }
 
+static rt_bool_t rtgui_dc_hw_get_color_point(rtgui_dc_t *self, int x, int y,
+    rtgui_color_t *color) {
+    struct rtgui_dc_hw *dc;
+
+    RT_ASSERT(self != RT_NULL);
+    dc = (struct rtgui_dc_hw *) self;
+
+    if (x < 0 || y < 0) return RT_FALSE;
+
+    x = x + dc->owner->extent.x1;
+    if (x > dc->owner->extent.x2) return RT_FALSE;
+    y = y + dc->owner->extent.y1;
+    if (y > dc->owner->extent.y2) return RT_FALSE;
+
+    dc->hw_driver->ops->get_pixel(color, x, y);
+    return RT_TRUE;
+}
+
 /*
  * draw a logic vertical line on device
  */
@@ -150,8 +236,16 @@ static void rtgui_dc_hw_draw_vline(rtgui_dc_t *self, int x, int y1, int y2) {
     if (y1 < dc->owner->extent.y1) y1 = dc->owner->extent.y1;
     if (y2 > dc->owner->extent.y2) y2 = dc->owner->extent.y2;
 
+    if (RTGUI_GC_IS_BLEND(&dc->owner->gc, dc->owner->gc.foreground)) {
+        for (; y1 < y2; y1++)
+            rtgui_gfx_blend_hline(x, x + 1, y1, dc->owner->gc.foreground,
+                RT_NULL);
+        return;
+    }
+
     /* draw vline */
-    dc->hw_driver->ops->draw_vline(&(dc->owner->gc.foreground), x, y1, y2);
+    dc->hw_driver->native_ops->draw_vline(rtgui_gc_native_fg(&dc->owner->gc),
+        x, y1, y2);
 }
 
 /*
@@ -176,12 +270,75 @@ static void rtgui_dc_hw_draw_hline(rtgui_dc_t *self, int x1, int x2, int y) {
     if (x1 < dc->owner->extent.x1) x1 = dc->owner->extent.x1;
     if (x2 > dc->owner->extent.x2) x2 = dc->owner->extent.x2;
 
+    if (RTGUI_GC_IS_BLEND(&dc->owner->gc, dc->owner->gc.foreground)) {
+        rtgui_gfx_blend_hline(x1, x2, y, dc->owner->gc.foreground, RT_NULL);
+        return;
+    }
+
     /* draw hline */
-    dc->hw_driver->ops->draw_hline(&(dc->owner->gc.foreground), x1, x2, y);
+    dc->hw_driver->native_ops->draw_hline(rtgui_gc_native_fg(&dc->owner->gc),
+        x1, x2, y);
+}
+
+/*
+ * draw logic horizontal lines on device
+ */
+static void rtgui_dc_hw_draw_hspans(rtgui_dc_t *self, rtgui_color_t *color,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    const struct rtgui_graphic_driver_ops *ops;
+    rtgui_span_t clipped[RTGUI_SPAN_BATCH_SIZE];
+    register rt_uint32_t cnt;
+    register rt_base_t x1, x2, y;
+    struct rtgui_dc_hw *dc;
+    rtgui_rect_t *extent;
+    rtgui_color_t blend_color;
+    rt_bool_t blend;
+
+    RT_ASSERT(self != RT_NULL);
+    dc = (struct rtgui_dc_hw *)self;
+    extent = &(dc->owner->extent);
+    blend_color = color ? *color : dc->owner->gc.foreground;
+    blend = RTGUI_GC_IS_BLEND(&dc->owner->gc, blend_color);
+    if (color) {
+        ops = dc->hw_driver->ops;
+    } else {
+        ops = dc->hw_driver->native_ops;
+        color = rtgui_gc_native_fg(&dc->owner->gc);
+    }
+
+    for (cnt = 0; num; num--, spans++) {
+        if (spans->y < 0) continue;
+        y = spans->y + extent->y1;
+        if (y > extent->y2) continue;
+
+        /* convert logic to device */
+        x1 = spans->x1 + extent->x1;
+        x2 = spans->x2 + extent->x1;
+        if (x1 > x2) _int_swap(x1, x2);
+        if ((x1 > extent->x2) || (x2 < extent->x1)) continue;
+
+        if (x1 < extent->x1) x1 = extent->x1;
+        if (x2 > extent->x2) x2 = extent->x2;
+
+        if (blend) {
+            rtgui_gfx_blend_hline(x1, x2, y, blend_color, RT_NULL);
+            continue;
+        }
+        clipped[cnt].x1 = x1;
+        clipped[cnt].x2 = x2;
+        clipped[cnt].y = y;
+        if (++cnt >= RTGUI_SPAN_BATCH_SIZE) {
+            ops->draw_hspans(color, clipped, cnt);
+            cnt = 0;
+        }
+    }
+
+    if (cnt)
+        ops->draw_hspans(color, clipped, cnt);
 }
 
 static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
-    rtgui_color_t color;
+    rtgui_color_t *pixel;
     register rt_base_t y1, y2, x1, x2;
     struct rtgui_dc_hw *dc;
 
@@ -189,8 +346,8 @@ static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
     RT_ASSERT(rect);
     dc = (struct rtgui_dc_hw *)self;
 
-    /* get background color */
-    color = dc->owner->gc.background;
+    /* get background pixel */
+    pixel = rtgui_gc_native_bg(&dc->owner->gc);
 
     /* convert logic to device */
     x1 = rect->x1 + dc->owner->extent.x1;
@@ -207,14 +364,21 @@ static void rtgui_dc_hw_fill_rect(rtgui_dc_t *self, rtgui_rect_t *rect) {
     if (y2 < dc->owner->extent.y1) return;
     if (y2 > dc->owner->extent.y2) y2 = dc->owner->extent.y2;
 
+    if (RTGUI_GC_IS_BLEND(&dc->owner->gc, dc->owner->gc.background)) {
+        for (; y1 <= y2; y1++)
+            rtgui_gfx_blend_hline(x1, x2, y1, dc->owner->gc.background,
+                RT_NULL);
+        return;
+    }
+
     /* fill rect */
-    for (; y1 <= y2; y1++)
-        dc->hw_driver->ops->draw_hline(&color, x1, x2, y1);
+    dc->hw_driver->native_ops->fill_rect(pixel, x1, y1, x2, y2 + 1);
 }
 
 static void rtgui_dc_hw_blit_line(rtgui_dc_t *self, int x1, int x2, int y, rt_uint8_t *line_data)
 {
     struct rtgui_dc_hw *dc;
+    rt_base_t offset = 0;
 
     RT_ASSERT(self != RT_NULL);
     dc = (struct rtgui_dc_hw *) self;
@@ -233,12 +397,41 @@ static void rtgui_dc_hw_blit_line(rtgui_dc_t *self, int x1, int x2, int y, rt_ui
 
     if (x1 > dc->owner->extent.x2 || x2 < dc->owner->extent.x1)
         return;
-    if (x1 < dc->owner->extent.x1)
+    if (x1 < dc->owner->extent.x1) {
+        /* skip the clipped head of "line_data" */
+        offset = (dc->owner->extent.x1 - x1) * \
+            _BIT2BYTE(dc->hw_driver->bits_per_pixel);
         x1 = dc->owner->extent.x1;
+    }
     if (x2 > dc->owner->extent.x2)
         x2 = dc->owner->extent.x2;
 
-    dc->hw_driver->ops->draw_raw_hline(line_data, x1, x2, y);
+    dc->hw_driver->ops->draw_raw_hline(line_data + offset, x1, x2, y);
+}
+
+static void rtgui_dc_hw_blend_line(rtgui_dc_t *self, int x1, int x2, int y,
+    rtgui_color_t color, const rtgui_color_t *argb)
+{
+    struct rtgui_dc_hw *dc;
+
+    RT_ASSERT(self != RT_NULL);
+    dc = (struct rtgui_dc_hw *)self;
+
+    /* convert logic to device */
+    if (y < 0) return;
+    y = y + dc->owner->extent.y1;
+    if (y > dc->owner->extent.y2) return;
+
+    x1 = x1 + dc->owner->extent.x1;
+    x2 = x2 + dc->owner->extent.x1;
+    if (x1 < dc->owner->extent.x1) {
+        /* skip the clipped head of "argb" */
+        if (argb) argb += dc->owner->extent.x1 - x1;
+        x1 = dc->owner->extent.x1;
+    }
+    if (x2 > dc->owner->extent.x2) x2 = dc->owner->extent.x2;
+
+    rtgui_gfx_blend_hline(x1, x2, y, color, argb);
 }
 
 static void rtgui_dc_hw_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
@@ -248,7 +441,7 @@ static void rtgui_dc_hw_blit(rtgui_dc_t *dc, struct rtgui_point *dc_point,
     (void)dc_point;
     (void)dest;
     (void)rect;
-    /* no blit in hardware dc? */
+    /* hardware dc is not readable, use buffer dc as source */
     LOG_E("no hw dc blit");
 }
 
@@ -25,11 +25,20 @@
  */
 /* Includes ------------------------------------------------------------------*/
 #include "include/rtgui.h"
+#include "include/blit.h"
+#include "include/rthw.h" // rt_hw_interrupt_disable()
+#if defined(RTGUI_USING_CURSOR) && defined(RTGUI_USING_DOUBLE_BUFFER)
+# include "include/app/mouse.h"
+#endif
 
 #if defined(CONFIG_TOUCH_DEVICE_NAME) || defined(CONFIG_KEY_DEVICE_NAME)
 # include "components/arduino/drv_common.h"
 #endif
 
+#if defined(RTGUI_USING_STRIP) && defined(RTGUI_USING_FRAMEBUFFER)
+# error "RTGUI_USING_STRIP is for device without framebuffer"
+#endif
+
 #ifdef RT_USING_ULOG
 # define LOG_LVL                    RTGUI_LOG_LEVEL
 # define LOG_TAG                    "GUI_DRV"
@@ -40,10 +49,29 @@
 #endif /* RT_USING_ULOG */
 
 /* Private typedef -----------------------------------------------------------*/
+#ifdef RTGUI_USING_STRIP
+    typedef struct rtgui_strip {
+        const struct rtgui_graphic_driver_ops *ops;         /* saved ops */
+        const struct rtgui_graphic_driver_ops *native_ops;
+        const struct rtgui_graphic_driver_ops *frame_ops;
+        const struct rtgui_graphic_driver_ops *frame_native_ops;
+        rt_uint8_t *buffer;
+        rtgui_region_t clip;                                /* area to push */
+        int y1, y2;                                         /* current band */
+        rt_bool_t seed_bg;                                  /* or read back */
+        rtgui_color_t background;                           /* to seed band */
+    } rtgui_strip_t;
+#endif
+
 /* Private define ------------------------------------------------------------*/
 #define display()                   rtgui_get_gfx_device()
 #define graphic_ops()               ((struct rtgui_graphic_driver_ops *) \
                                     display()->device->user_data)
+#define _PIXEL2BYTE(drv, num)       (((num) * (drv)->bits_per_pixel) >> 3)
+#define _RECT_AREA(r)               ((rt_uint32_t)((r).x2 - (r).x1) * \
+                                    (rt_uint32_t)((r).y2 - (r).y1))
+#define BLEND_CHUNK                 (32)        /* pixels read back at once */
+#define _ALPHA_KIND(a)              (!(a) ? 0 : ((0xff == (a)) ? 2 : 1))
 
 /* Private function prototypes -----------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
@@ -57,6 +85,17 @@ static rtgui_gfx_driver_t _gfx_drv;
     static rt_device_t _key;
     RTGUI_GETTER(key_device, rt_device_t, _key);
 #endif
+static rtgui_damage_stat_t _damage_stat;
+#ifdef RTGUI_USING_STRIP
+    static rtgui_strip_t _strip;
+    static rtgui_strip_stat_t _strip_stat;
+#endif
+#ifdef RTGUI_USING_DAMAGE
+    static struct rt_mutex _damage_lock;
+    static rtgui_region_t _damage;
+    static rt_tick_t _damage_tick;
+    static struct rt_timer _damage_timer;
+#endif
 
 /* Private functions ---------------------------------------------------------*/
 static void _draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
@@ -66,6 +105,64 @@ static void _draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
         graphic_ops()->draw_raw_hline(pixels, x2, x2, y);
 }
 
+static void _draw_hspans(rtgui_color_t *pixel, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    void (*draw_hline)(rtgui_color_t *, int, int, int);
+
+    draw_hline = graphic_ops()->draw_hline;
+    for (; num; num--, spans++)
+        draw_hline(pixel, spans->x1, spans->x2, spans->y);
+}
+
+static void _fill_rect(rtgui_color_t *pixel, int x1, int y1, int x2, int y2) {
+    void (*draw_hline)(rtgui_color_t *, int, int, int);
+
+    if ((x1 >= x2) || (y1 >= y2)) return;
+    #ifdef RTGUI_USING_EXT_OPS
+        /* let device set the window once and burst write */
+        if (display()->ext_ops && display()->ext_ops->fill_rect) {
+            display()->ext_ops->fill_rect(pixel, x1, y1, x2, y2);
+            return;
+        }
+    #endif
+
+    draw_hline = graphic_ops()->draw_hline;
+    for (; y1 < y2; y1++)
+        draw_hline(pixel, x1, x2, y1);
+}
+
+/* native ops, "c" is the native pixel */
+static void _native_set_pixel(rtgui_color_t *c, int x, int y) {
+    graphic_ops()->set_pixel(c, x, y);
+}
+
+static void _native_get_pixel(rtgui_color_t *c, int x, int y) {
+    graphic_ops()->get_pixel(c, x, y);
+    #if (CONFIG_USING_RGB565)
+        /* RGB565 device returns the color, see _rgb565_get_pixel() */
+        if (RTGRAPHIC_PIXEL_FORMAT_RGB565 == display()->pixel_format)
+            *c = (rtgui_color_t)rtgui_color_to_565(*c);
+    #endif
+}
+
+static void _native_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    graphic_ops()->draw_hline(c, x1, x2, y);
+}
+
+static void _native_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    graphic_ops()->draw_vline(c, x, y1, y2);
+}
+
+static const struct rtgui_graphic_driver_ops _native_ops = {
+    _native_set_pixel,
+    _native_get_pixel,
+    _native_draw_hline,
+    _native_draw_vline,
+    _draw_raw_hline,
+    _draw_hspans,
+    _fill_rect,
+};
+
 #if (CONFIG_USING_MONO)
 static void _mono_set_pixel(rtgui_color_t *c, int x, int y) {
     rtgui_color_t pixel = rtgui_color_to_mono(*c);
@@ -89,12 +186,25 @@ static void _mono_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
     graphic_ops()->draw_vline(&pixel, x, y1, y2);
 }
 
+static void _mono_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    rtgui_color_t pixel = rtgui_color_to_mono(*c);
+    _draw_hspans(&pixel, spans, num);
+}
+
+static void _mono_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    rtgui_color_t pixel = rtgui_color_to_mono(*c);
+    _fill_rect(&pixel, x1, y1, x2, y2);
+}
+
 static const struct rtgui_graphic_driver_ops _mono_ops = {
     _mono_set_pixel,
     _mono_get_pixel,
     _mono_draw_hline,
     _mono_draw_vline,
     _draw_raw_hline,
+    _mono_draw_hspans,
+    _mono_fill_rect,
 };
 #endif /* CONFIG_USING_MONO */
 
@@ -119,12 +229,25 @@ static void _rgb565_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
     graphic_ops()->draw_vline(&pixel, x, y1, y2);
 }
 
+static void _rgb565_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565(*c);
+    _draw_hspans(&pixel, spans, num);
+}
+
+static void _rgb565_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565(*c);
+    _fill_rect(&pixel, x1, y1, x2, y2);
+}
+
 static const struct rtgui_graphic_driver_ops _rgb565_ops = {
     _rgb565_set_pixel,
     _rgb565_get_pixel,
     _rgb565_draw_hline,
     _rgb565_draw_vline,
     _draw_raw_hline,
+    _rgb565_draw_hspans,
+    _rgb565_fill_rect,
 };
 #endif /* CONFIG_USING_RGB565 */
 
@@ -151,12 +274,25 @@ static void _rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
     graphic_ops()->draw_vline(&pixel, x, y1, y2);
 }
 
+static void _rgb565p_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565p(*c);
+    _draw_hspans(&pixel, spans, num);
+}
+
+static void _rgb565p_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_565p(*c);
+    _fill_rect(&pixel, x1, y1, x2, y2);
+}
+
 static const struct rtgui_graphic_driver_ops _rgb565p_ops = {
     _rgb565p_set_pixel,
     _rgb565p_get_pixel,
     _rgb565p_draw_hline,
     _rgb565p_draw_vline,
     _draw_raw_hline,
+    _rgb565p_draw_hspans,
+    _rgb565p_fill_rect,
 };
 #endif /* CONFIG_USING_RGB565P */
 
@@ -183,12 +319,25 @@ static void _rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
     graphic_ops()->draw_vline(&pixel, x, y1, y2);
 }
 
+static void _rgb888_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_888(*c);
+    _draw_hspans(&pixel, spans, num);
+}
+
+static void _rgb888_fill_rect(rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    rtgui_color_t pixel = (rtgui_color_t)rtgui_color_to_888(*c);
+    _fill_rect(&pixel, x1, y1, x2, y2);
+}
+
 static const struct rtgui_graphic_driver_ops _rgb888_ops = {
     _rgb888_set_pixel,
     _rgb888_get_pixel,
     _rgb888_draw_hline,
     _rgb888_draw_vline,
     _draw_raw_hline,
+    _rgb888_draw_hspans,
+    _rgb888_fill_rect,
 };
 #endif /* CONFIG_USING_RGB888 */
 
@@ -221,7 +370,7 @@ static const struct rtgui_graphic_driver_ops *_get_pixel_ops(rt_uint32_t fmt) {
 }
 
 
-#ifdef RTGUI_USING_FRAMEBUFFER
+#if defined(RTGUI_USING_FRAMEBUFFER) || defined(RTGUI_USING_STRIP)
 
 #if (CONFIG_USING_MONO)
 #define BUFFER()                    (display()->framebuffer)
@@ -271,30 +420,22 @@ static void _frame_mono_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
 static void _frame_mono_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
     rt_uint8_t x1 = x & 0x000000ff;
     rt_uint8_t *ptr;
-    rt_uint8_t mask, y, len;
+    rt_uint8_t mask;
+    int end;
 
     y1 &= 0x000000ff;
     y2 &= 0x000000ff;
+    if (y1 >= y2) return;
     ptr = &BUFFER()[(y1 >> 3) * WIDTH() + x1];
-    len = 1;
-    if (*c != black) {
-        for (y = y1; y < y2; y++) {
-            mask = 1 << (y % 8);
+    /* one byte per page, mask covering [y1, end) in the page */
+    for (; y1 < y2; y1 = end, ptr += WIDTH()) {
+        end = (y1 & ~0x07) + 8;
+        if (end > y2) end = y2;
+        mask = (0xff << (y1 & 0x07)) & (0xff >> (8 - (end - (y1 & ~0x07))));
+        if (*c != black)
             *ptr |=  mask;
-            if (mask == 0x80) {
-                ptr++;
-                len++;
-            }
-        }
-    } else {
-        for (y = y1; y < y2; y++) {
-            mask = 1 << (y % 8);
+        else
             *ptr &= ~mask;
-            if (mask == 0x80) {
-                ptr++;
-                len++;
-            }
-        }
     }
 }
 
@@ -318,12 +459,26 @@ static void _frame_mono_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2,
 }
 
 
+static void _frame_mono_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    for (; num; num--, spans++)
+        _frame_mono_draw_hline(c, spans->x1, spans->x2, spans->y);
+}
+
+static void _frame_mono_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    for (; y1 < y2; y1++)
+        _frame_mono_draw_hline(c, x1, x2, y1);
+}
+
 const struct rtgui_graphic_driver_ops _frame_mono_ops = {
     _frame_mono_set_pixel,
     _frame_mono_get_pixel,
     _frame_mono_draw_hline,
     _frame_mono_draw_vline,
     _frame_mono_draw_raw_hline,
+    _frame_mono_draw_hspans,
+    _frame_mono_fill_rect,
 };
 
 #undef BUFFER
@@ -331,10 +486,23 @@ const struct rtgui_graphic_driver_ops _frame_mono_ops = {
 #endif /* CONFIG_USING_MONO */
 
 #define PIXEL(x, y)     (display()->framebuffer + \
-                         display()->pitch * y + \
-                         _BIT2BYTE(display()->bits_per_pixel) * x)
+                         display()->pitch * (y) + \
+                         _BIT2BYTE(display()->bits_per_pixel) * (x))
+
+#define FRAME_16BIT                 (CONFIG_USING_RGB565 || CONFIG_USING_RGB565P)
+#define FRAME_32BIT                 (CONFIG_USING_RGB888 || CONFIG_USING_ARGB888)
+
+#if (FRAME_16BIT || FRAME_32BIT)
+/* copy the first row of rect to the rest */
+static void _frame_copy_first_row(int x1, int y1, int x2, int y2) {
+    rt_uint8_t *src = (rt_uint8_t *)PIXEL(x1, y1);
+    rt_uint8_t *dst = src + display()->pitch;
+    rt_uint32_t len = (x2 - x1) * _BIT2BYTE(display()->bits_per_pixel);
+
+    for (y1++; y1 < y2; y1++, dst += display()->pitch)
+        rt_memcpy(dst, src, len);
+}
 
-#if !(CONFIG_USING_MONO)
 static void _frame_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
     rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x1, y);
 
@@ -343,32 +511,172 @@ static void _frame_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
 }
 #endif
 
+/* native ops, "c" is the native pixel */
+#if (FRAME_16BIT)
+/* fill kernel: replicate the pixel into 32-bit words, align the head and
+   store words (unrolled) for the middle part */
+rt_inline void _fill16(rt_uint16_t *ptr, rt_uint16_t pixel, rt_int32_t len) {
+    rt_uint32_t *ptr32;
+    rt_uint32_t pattern;
+
+    if (len <= 0) return;
+    if ((rt_ubase_t)ptr & 0x02) {
+        *ptr++ = pixel;
+        len--;
+    }
+    pattern = ((rt_uint32_t)pixel << 16) | pixel;
+    ptr32 = (rt_uint32_t *)ptr;
+    for (; len >= 8; len -= 8, ptr32 += 4) {
+        ptr32[0] = pattern;
+        ptr32[1] = pattern;
+        ptr32[2] = pattern;
+        ptr32[3] = pattern;
+    }
+    for (; len >= 2; len -= 2)
+        *ptr32++ = pattern;
+    if (len)
+        *(rt_uint16_t *)ptr32 = pixel;
+}
+
+static void _frame_16_set_pixel(rtgui_color_t *c, int x, int y) {
+    *(rt_uint16_t *)PIXEL(x, y) = (rt_uint16_t)*c;
+}
+
+static void _frame_16_get_pixel(rtgui_color_t *c, int x, int y) {
+    *c = *(rt_uint16_t *)PIXEL(x, y);
+}
+
+static void _frame_16_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _fill16((rt_uint16_t *)PIXEL(x1, y), (rt_uint16_t)*c, x2 - x1);
+}
+
+static void _frame_16_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
+    rt_uint16_t pixel = (rt_uint16_t)*c;
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += display()->pitch)
+        *(rt_uint16_t *)ptr = pixel;
+}
+
+static void _frame_16_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    rt_uint16_t pixel = (rt_uint16_t)*c;
+
+    for (; num; num--, spans++)
+        _fill16((rt_uint16_t *)PIXEL(spans->x1, spans->y), pixel,
+            spans->x2 - spans->x1);
+}
+
+static void _frame_16_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    if ((x1 >= x2) || (y1 >= y2)) return;
+    _frame_16_draw_hline(c, x1, x2, y1);
+    _frame_copy_first_row(x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops _frame_16_ops = {
+    _frame_16_set_pixel,
+    _frame_16_get_pixel,
+    _frame_16_draw_hline,
+    _frame_16_draw_vline,
+    _frame_draw_raw_hline,
+    _frame_16_draw_hspans,
+    _frame_16_fill_rect,
+};
+#endif /* FRAME_16BIT */
+
+#if (FRAME_32BIT)
+rt_inline void _fill32(rt_uint32_t *ptr, rt_uint32_t pixel, rt_int32_t len) {
+    for (; len >= 4; len -= 4, ptr += 4) {
+        ptr[0] = pixel;
+        ptr[1] = pixel;
+        ptr[2] = pixel;
+        ptr[3] = pixel;
+    }
+    for (; len > 0; len--)
+        *ptr++ = pixel;
+}
+
+static void _frame_32_set_pixel(rtgui_color_t *c, int x, int y) {
+    *(rt_uint32_t *)PIXEL(x, y) = *c;
+}
+
+static void _frame_32_get_pixel(rtgui_color_t *c, int x, int y) {
+    *c = *(rt_uint32_t *)PIXEL(x, y);
+}
+
+static void _frame_32_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _fill32((rt_uint32_t *)PIXEL(x1, y), *c, x2 - x1);
+}
+
+static void _frame_32_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    rt_uint8_t *ptr = (rt_uint8_t *)PIXEL(x, y1);
+    int y;
+
+    for (y = y1; y < y2; y++, ptr += display()->pitch)
+        *(rt_uint32_t *)ptr = *c;
+}
+
+static void _frame_32_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    for (; num; num--, spans++)
+        _fill32((rt_uint32_t *)PIXEL(spans->x1, spans->y), *c,
+            spans->x2 - spans->x1);
+}
+
+static void _frame_32_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    if ((x1 >= x2) || (y1 >= y2)) return;
+    _frame_32_draw_hline(c, x1, x2, y1);
+    _frame_copy_first_row(x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops _frame_32_ops = {
+    _frame_32_set_pixel,
+    _frame_32_get_pixel,
+    _frame_32_draw_hline,
+    _frame_32_draw_vline,
+    _frame_draw_raw_hline,
+    _frame_32_draw_hspans,
+    _frame_32_fill_rect,
+};
+#endif /* FRAME_32BIT */
+
+/* color ops, convert to native pixel once then call native ops */
 #if (CONFIG_USING_RGB565)
 static void _frame_rgb565_set_pixel(rtgui_color_t *c, int x, int y) {
-    *(rt_uint16_t *)PIXEL(x, y) = rtgui_color_to_565(*c);
+    rtgui_color_t pixel = rtgui_color_to_565(*c);
+    _frame_16_set_pixel(&pixel, x, y);
 }
 
 static void _frame_rgb565_get_pixel(rtgui_color_t *c, int x, int y) {
-    rt_uint16_t pixel = *(rt_uint16_t *)PIXEL(x, y);
-    *c = rtgui_color_from_565(pixel);
+    rtgui_color_t pixel;
+
+    _frame_16_get_pixel(&pixel, x, y);
+    *c = rtgui_color_from_565((rt_uint16_t)pixel);
 }
 
 static void _frame_rgb565_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rt_uint16_t pixel = rtgui_color_to_565(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x1, y);
-    int x;
-
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = pixel;
+    rtgui_color_t pixel = rtgui_color_to_565(*c);
+    _frame_16_draw_hline(&pixel, x1, x2, y);
 }
 
 static void _frame_rgb565_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
-    rt_uint16_t pixel = rtgui_color_to_565(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x, y1);
-    int y;
+    rtgui_color_t pixel = rtgui_color_to_565(*c);
+    _frame_16_draw_vline(&pixel, x, y1, y2);
+}
+
+static void _frame_rgb565_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    rtgui_color_t pixel = rtgui_color_to_565(*c);
+    _frame_16_draw_hspans(&pixel, spans, num);
+}
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = pixel;
+static void _frame_rgb565_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = rtgui_color_to_565(*c);
+    _frame_16_fill_rect(&pixel, x1, y1, x2, y2);
 }
 
 const struct rtgui_graphic_driver_ops _frame_rgb565_ops = {
@@ -377,35 +685,44 @@ const struct rtgui_graphic_driver_ops _frame_rgb565_ops = {
     _frame_rgb565_draw_hline,
     _frame_rgb565_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb565_draw_hspans,
+    _frame_rgb565_fill_rect,
 };
 #endif /* CONFIG_USING_RGB565 */
 
 #if (CONFIG_USING_RGB565P)
 static void _frame_rgb565p_set_pixel(rtgui_color_t *c, int x, int y) {
-    *(rt_uint16_t *)PIXEL(x, y) = rtgui_color_to_565p(*c);
+    rtgui_color_t pixel = rtgui_color_to_565p(*c);
+    _frame_16_set_pixel(&pixel, x, y);
 }
 
 static void _frame_rgb565p_get_pixel(rtgui_color_t *c, int x, int y) {
-    rt_uint16_t pixel = *(rt_uint16_t *)PIXEL(x, y);
-    *c = rtgui_color_from_565p(pixel);
+    rtgui_color_t pixel;
+
+    _frame_16_get_pixel(&pixel, x, y);
+    *c = rtgui_color_from_565p((rt_uint16_t)pixel);
 }
 
 static void _frame_rgb565p_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rt_uint16_t pixel = rtgui_color_to_565p(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x1, y);
-    int x;
-
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = pixel;
+    rtgui_color_t pixel = rtgui_color_to_565p(*c);
+    _frame_16_draw_hline(&pixel, x1, x2, y);
 }
 
 static void _frame_rgb565p_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rt_uint16_t pixel = rtgui_color_to_565p(*c);
-    rt_uint16_t *ptr = (rt_uint16_t *)PIXEL(x, y1);
-    int y;
+    rtgui_color_t pixel = rtgui_color_to_565p(*c);
+    _frame_16_draw_vline(&pixel, x, y1, y2);
+}
+
+static void _frame_rgb565p_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    rtgui_color_t pixel = rtgui_color_to_565p(*c);
+    _frame_16_draw_hspans(&pixel, spans, num);
+}
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = pixel;
+static void _frame_rgb565p_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = rtgui_color_to_565p(*c);
+    _frame_16_fill_rect(&pixel, x1, y1, x2, y2);
 }
 
 const struct rtgui_graphic_driver_ops _frame_rgb565p_ops = {
@@ -414,48 +731,48 @@ const struct rtgui_graphic_driver_ops _frame_rgb565p_ops = {
     _frame_rgb565p_draw_hline,
     _frame_rgb565p_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb565p_draw_hspans,
+    _frame_rgb565p_fill_rect,
 };
 #endif /* CONFIG_USING_RGB565P */
 
 #if (CONFIG_USING_RGB888)
+#ifdef RTGUI_USING_RGB888_AS_32BIT
+# define RGB888_PIXEL(c)            (c)
+#else
+# define RGB888_PIXEL(c)            ((c) & 0x00ffffff)
+#endif
+
 static void _frame_rgb888_set_pixel(rtgui_color_t *c, int x, int y) {
-    #ifdef RTGUI_USING_RGB888_AS_32BIT
-        *(rtgui_color_t *)PIXEL(x, y) = *c;
-    #else
-        *(rtgui_color_t *)PIXEL(x, y) = *c & 0x00ffffff;
-    #endif
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    _frame_32_set_pixel(&pixel, x, y);
 }
 
 static void _frame_rgb888_get_pixel(rtgui_color_t *c, int x, int y) {
-    #ifdef RTGUI_USING_RGB888_AS_32BIT
-        *c = *(rtgui_color_t *)PIXEL(x, y);
-    #else
-        *c = *(rtgui_color_t *)PIXEL(x, y) & 0x00ffffff;
-    #endif
+    _frame_32_get_pixel(c, x, y);
+    *c = RGB888_PIXEL(*c);
 }
 
 static void _frame_rgb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x1, y);
-    int x;
-
-    for (x = x1; x < x2; x++, ptr++)
-        #ifdef RTGUI_USING_RGB888_AS_32BIT
-            *ptr = *c;
-        #else
-            *ptr = *c & 0x00ffffff;
-        #endif
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    _frame_32_draw_hline(&pixel, x1, x2, y);
 }
 
 static void _frame_rgb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x, y1);
-    int y;
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    _frame_32_draw_vline(&pixel, x, y1, y2);
+}
 
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        #ifdef RTGUI_USING_RGB888_AS_32BIT
-            *ptr = *c;
-        #else
-            *ptr = *c & 0x00ffffff;
-        #endif
+static void _frame_rgb888_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    _frame_32_draw_hspans(&pixel, spans, num);
+}
+
+static void _frame_rgb888_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rtgui_color_t pixel = RGB888_PIXEL(*c);
+    _frame_32_fill_rect(&pixel, x1, y1, x2, y2);
 }
 
 const struct rtgui_graphic_driver_ops _frame_rgb888_ops = {
@@ -464,42 +781,12 @@ const struct rtgui_graphic_driver_ops _frame_rgb888_ops = {
     _frame_rgb888_draw_hline,
     _frame_rgb888_draw_vline,
     _frame_draw_raw_hline,
+    _frame_rgb888_draw_hspans,
+    _frame_rgb888_fill_rect,
 };
-#endif /* CONFIG_USING_RGB888 */
-
-#if (CONFIG_USING_ARGB888)
-static void _frame_argb888_set_pixel(rtgui_color_t *c, int x, int y) {
-    *(rtgui_color_t *)PIXEL(x, y) = *c;
-}
-
-static void _frame_argb888_get_pixel(rtgui_color_t *c, int x, int y) {
-    *(rtgui_color_t *)PIXEL(x, y) = *c;
-}
-
-static void _frame_argb888_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x1, y);
-    int x;
-
-    for (x = x1; x < x2; x++, ptr++)
-        *ptr = *c;
-}
-
-static void _frame_argb888_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
-    rtgui_color_t *ptr = (rtgui_color_t *)PIXEL(x, y1);
-    int y;
-
-    for (y = y1; y < y2; y++, ptr += display()->width)
-        *ptr = *c;
-}
 
-const struct rtgui_graphic_driver_ops _frame_argb888_ops = {
-    _frame_argb888_set_pixel,
-    _frame_argb888_get_pixel,
-    _frame_argb888_draw_hline,
-    _frame_argb888_draw_vline,
-    _frame_draw_raw_hline,
-};
-#endif /* CONFIG_USING_ARGB888 */
+#undef RGB888_PIXEL
+#endif /* CONFIG_USING_RGB888 */
 
 #undef PIXEL
 
@@ -532,7 +819,8 @@ static const struct rtgui_graphic_driver_ops *_get_frame_ops(rt_uint32_t fmt) {
 
     #if (CONFIG_USING_ARGB888)
     case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
-        return &_frame_argb888_ops;
+        /* already native */
+        return &_frame_32_ops;
     #endif
 
     default:
@@ -540,7 +828,359 @@ static const struct rtgui_graphic_driver_ops *_get_frame_ops(rt_uint32_t fmt) {
     }
 }
 
-#endif /* RTGUI_USING_FRAMEBUFFER */
+static const struct rtgui_graphic_driver_ops *_get_frame_native_ops(
+    rt_uint32_t fmt) {
+    switch (fmt) {
+
+    #if (CONFIG_USING_MONO)
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        /* native pixel is the color */
+        return &_frame_mono_ops;
+    #endif
+
+    #if (FRAME_16BIT)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return &_frame_16_ops;
+    #endif
+
+    #if (FRAME_32BIT)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+    case RTGRAPHIC_PIXEL_FORMAT_ARGB888:
+        return &_frame_32_ops;
+    #endif
+
+    default:
+        return RT_NULL;
+    }
+}
+
+#endif /* RTGUI_USING_FRAMEBUFFER || RTGUI_USING_STRIP */
+
+#ifdef RTGUI_USING_STRIP
+/* strip ops: draw the current band into strip buffer by framebuffer ops and
+   drop the rest */
+#define IN_BAND(y)                  ((y >= _strip.y1) && (y < _strip.y2))
+
+static void _band_set_pixel(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int x, int y) {
+    if (IN_BAND(y))
+        ops->set_pixel(c, x, y - _strip.y1);
+}
+
+static void _band_get_pixel(const struct rtgui_graphic_driver_ops *ops,
+    const struct rtgui_graphic_driver_ops *saved, rtgui_color_t *c, int x,
+    int y) {
+    if (IN_BAND(y))
+        ops->get_pixel(c, x, y - _strip.y1);
+    else
+        saved->get_pixel(c, x, y);
+}
+
+static void _band_draw_hline(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int x1, int x2, int y) {
+    if (IN_BAND(y))
+        ops->draw_hline(c, x1, x2, y - _strip.y1);
+}
+
+static void _band_draw_vline(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int x , int y1, int y2) {
+    y1 = _MAX(y1, _strip.y1);
+    y2 = _MIN(y2, _strip.y2);
+    if (y1 < y2)
+        ops->draw_vline(c, x, y1 - _strip.y1, y2 - _strip.y1);
+}
+
+static void _band_draw_hspans(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, const rtgui_span_t *spans, rt_uint32_t num) {
+    rtgui_span_t band[RTGUI_SPAN_BATCH_SIZE];
+    rt_uint32_t cnt = 0;
+
+    for (; num; num--, spans++) {
+        if (!IN_BAND(spans->y)) continue;
+        band[cnt] = *spans;
+        band[cnt++].y -= _strip.y1;
+        if (cnt == RTGUI_SPAN_BATCH_SIZE) {
+            ops->draw_hspans(c, band, cnt);
+            cnt = 0;
+        }
+    }
+    if (cnt)
+        ops->draw_hspans(c, band, cnt);
+}
+
+static void _band_fill_rect(const struct rtgui_graphic_driver_ops *ops,
+    rtgui_color_t *c, int x1, int y1, int x2, int y2) {
+    y1 = _MAX(y1, _strip.y1);
+    y2 = _MIN(y2, _strip.y2);
+    if (y1 < y2)
+        ops->fill_rect(c, x1, y1 - _strip.y1, x2, y2 - _strip.y1);
+}
+
+static void _strip_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2, int y) {
+    if (IN_BAND(y))
+        _strip.frame_ops->draw_raw_hline(pixels, x1, x2, y - _strip.y1);
+}
+
+/* color ops */
+static void _strip_set_pixel(rtgui_color_t *c, int x, int y) {
+    _band_set_pixel(_strip.frame_ops, c, x, y);
+}
+
+static void _strip_get_pixel(rtgui_color_t *c, int x, int y) {
+    _band_get_pixel(_strip.frame_ops, _strip.ops, c, x, y);
+}
+
+static void _strip_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _band_draw_hline(_strip.frame_ops, c, x1, x2, y);
+}
+
+static void _strip_draw_vline(rtgui_color_t *c, int x , int y1, int y2) {
+    _band_draw_vline(_strip.frame_ops, c, x, y1, y2);
+}
+
+static void _strip_draw_hspans(rtgui_color_t *c, const rtgui_span_t *spans,
+    rt_uint32_t num) {
+    _band_draw_hspans(_strip.frame_ops, c, spans, num);
+}
+
+static void _strip_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    _band_fill_rect(_strip.frame_ops, c, x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops _strip_ops = {
+    _strip_set_pixel,
+    _strip_get_pixel,
+    _strip_draw_hline,
+    _strip_draw_vline,
+    _strip_draw_raw_hline,
+    _strip_draw_hspans,
+    _strip_fill_rect,
+};
+
+/* native ops */
+static void _strip_native_set_pixel(rtgui_color_t *c, int x, int y) {
+    _band_set_pixel(_strip.frame_native_ops, c, x, y);
+}
+
+static void _strip_native_get_pixel(rtgui_color_t *c, int x, int y) {
+    _band_get_pixel(_strip.frame_native_ops, _strip.native_ops, c, x, y);
+}
+
+static void _strip_native_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    _band_draw_hline(_strip.frame_native_ops, c, x1, x2, y);
+}
+
+static void _strip_native_draw_vline(rtgui_color_t *c, int x , int y1,
+    int y2) {
+    _band_draw_vline(_strip.frame_native_ops, c, x, y1, y2);
+}
+
+static void _strip_native_draw_hspans(rtgui_color_t *c,
+    const rtgui_span_t *spans, rt_uint32_t num) {
+    _band_draw_hspans(_strip.frame_native_ops, c, spans, num);
+}
+
+static void _strip_native_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    _band_fill_rect(_strip.frame_native_ops, c, x1, y1, x2, y2);
+}
+
+static const struct rtgui_graphic_driver_ops _strip_native_ops = {
+    _strip_native_set_pixel,
+    _strip_native_get_pixel,
+    _strip_native_draw_hline,
+    _strip_native_draw_vline,
+    _strip_draw_raw_hline,
+    _strip_native_draw_hspans,
+    _strip_native_fill_rect,
+};
+
+#undef IN_BAND
+
+/* get the clipped part of current band, return RT_FALSE if out of band */
+static rt_bool_t _strip_band_rect(const rtgui_rect_t *src, rtgui_rect_t *rect) {
+    *rect = *src;
+    rect->y1 = _MAX(rect->y1, _strip.y1);
+    rect->y2 = _MIN(rect->y2, _strip.y2);
+    return rect->y1 < rect->y2;
+}
+
+/* fill the clipped part of current band with what is behind, by background
+   color or by reading back from the panel */
+static void _strip_seed(void) {
+    rtgui_rect_t *rects, rect;
+    rtgui_color_t pixel;
+    rt_uint32_t i, num;
+    int x, y;
+
+    num = rtgui_region_num_rects(&_strip.clip);
+    rects = rtgui_region_rects(&_strip.clip);
+    for (i = 0; i < num; i++) {
+        if (rects[i].y1 >= _strip.y2) break;
+        if (!_strip_band_rect(&rects[i], &rect)) continue;
+        if (_strip.seed_bg) {
+            _strip.frame_ops->fill_rect(&_strip.background, rect.x1,
+                rect.y1 - _strip.y1, rect.x2, rect.y2 - _strip.y1);
+            continue;
+        }
+        for (y = rect.y1; y < rect.y2; y++) {
+            for (x = rect.x1; x < rect.x2; x++) {
+                _strip.ops->get_pixel(&pixel, x, y);
+                _strip.frame_ops->set_pixel(&pixel, x, y - _strip.y1);
+            }
+        }
+        _strip_stat.read_pixels += _RECT_AREA(rect);
+    }
+}
+
+/* push the clipped part of current band, one window and burst per rect if
+   the panel supports "blit_rect" of ext_ops, or one burst per line */
+static void _strip_push(void) {
+    rt_uint8_t bpp = _BIT2BYTE(_gfx_drv.bits_per_pixel);
+    rtgui_rect_t *rects, rect;
+    rt_uint8_t *pixels;
+    rt_uint32_t i, num, area = 0;
+    int y;
+
+    num = rtgui_region_num_rects(&_strip.clip);
+    rects = rtgui_region_rects(&_strip.clip);
+    for (i = 0; i < num; i++) {
+        if (rects[i].y1 >= _strip.y2) break;
+        if (!_strip_band_rect(&rects[i], &rect)) continue;
+        pixels = _strip.buffer + (rect.y1 - _strip.y1) * _gfx_drv.pitch + \
+            rect.x1 * bpp;
+        area += _RECT_AREA(rect);
+        #ifdef RTGUI_USING_EXT_OPS
+            if (_gfx_drv.ext_ops && _gfx_drv.ext_ops->blit_rect) {
+                _gfx_drv.ext_ops->blit_rect(pixels, _gfx_drv.pitch, rect.x1,
+                    rect.y1, rect.x2, rect.y2);
+                _strip_stat.burst_count++;
+                continue;
+            }
+        #endif
+        for (y = rect.y1; y < rect.y2; y++, pixels += _gfx_drv.pitch)
+            graphic_ops()->draw_raw_hline(pixels, rect.x1, rect.x2, y);
+        _strip_stat.burst_count += rect.y2 - rect.y1;
+    }
+
+    _strip_stat.strip_count++;
+    _strip_stat.strip_pixels += (_strip.clip.extents.x2 - \
+        _strip.clip.extents.x1) * (_strip.y2 - _strip.y1);
+    _strip_stat.push_pixels += area;
+    _strip_stat.bus_bytes += _PIXEL2BYTE(&_gfx_drv, area);
+}
+#endif /* RTGUI_USING_STRIP */
+
+#ifdef RTGUI_USING_DOUBLE_BUFFER
+/* copy rect from back buffer to front buffer */
+static void _copy_to_front(const rtgui_gfx_driver_t *drv,
+    const struct rt_device_rect_info *info) {
+    rt_uint8_t *src, *dst;
+    rt_uint32_t offset, len, step;
+    int y, end;
+    #ifdef RTGUI_USING_CURSOR
+        rtgui_rect_t rect;
+    #endif
+
+    if (RTGRAPHIC_PIXEL_FORMAT_MONO == drv->pixel_format) {
+        /* one byte per column in each 8-line page */
+        y = info->y >> 3;
+        end = (info->y + info->height + 7) >> 3;
+        step = drv->width;
+        offset = y * step + info->x;
+        len = info->width;
+    } else {
+        y = info->y;
+        end = info->y + info->height;
+        step = drv->pitch;
+        offset = y * step + info->x * _BIT2BYTE(drv->bits_per_pixel);
+        len = info->width * _BIT2BYTE(drv->bits_per_pixel);
+    }
+
+    #ifdef RTGUI_USING_CURSOR
+        /* the copied lines */
+        rtgui_rect_init(&rect, info->x, y, info->width, end - y);
+        if (RTGRAPHIC_PIXEL_FORMAT_MONO == drv->pixel_format) {
+            rect.y1 <<= 3;
+            rect.y2 <<= 3;
+        }
+    #endif
+
+    src = drv->framebuffer + offset;
+    dst = drv->front_buffer + offset;
+    for (; y < end; y++, src += step, dst += step)
+        rt_memcpy(dst, src, len);
+
+    #ifdef RTGUI_USING_CURSOR
+        /* cursor is on front buffer only */
+        rtgui_cursor_compose(drv, &rect);
+    #endif
+}
+#endif /* RTGUI_USING_DOUBLE_BUFFER */
+
+static void _update_screen(const rtgui_gfx_driver_t *drv, rtgui_rect_t *rect) {
+    struct rt_device_rect_info info;
+
+    if ((rect->x1 >= drv->width) || (rect->y1 >= drv->height) || \
+        (rect->x2 <= 0) || (rect->y2 <= 0))
+        return;
+
+    info.x = rect->x1 > 0 ? rect->x1 : 0;
+    info.y = rect->y1 > 0 ? rect->y1 : 0;
+
+    info.width = rect->x2 > drv->width ? drv->width : rect->x2;
+    info.height = rect->y2 > drv->height ? drv->height : rect->y2;
+
+    info.width -= info.x;
+    info.height -= info.y;
+
+    #ifdef RTGUI_USING_DOUBLE_BUFFER
+        if (drv->front_buffer)
+            _copy_to_front(drv, &info);
+    #endif
+    rt_device_control(drv->device, RTGRAPHIC_CTRL_RECT_UPDATE, &info);
+    _damage_stat.update_count++;
+    _damage_stat.bytes_pushed += _PIXEL2BYTE(drv, info.width * info.height);
+}
+
+#ifdef RTGUI_USING_DAMAGE
+/* merge the pair adding the least area to keep "num - 1" rects */
+static void _damage_merge(rtgui_rect_t *set, rt_uint32_t num) {
+    rt_uint32_t i, j, bi = 0, bj = 1;
+    rt_uint32_t cost, best = (rt_uint32_t)-1;
+    rtgui_rect_t box;
+
+    for (i = 0; i < num - 1; i++) {
+        for (j = i + 1; j < num; j++) {
+            box = set[j];
+            rtgui_rect_union(&set[i], &box);
+            cost = _RECT_AREA(box) - _RECT_AREA(set[i]) - _RECT_AREA(set[j]);
+            /* overlapping pair may go "negative" */
+            if ((rt_int32_t)cost < 0) cost = 0;
+            if (cost < best) {
+                best = cost;
+                bi = i;
+                bj = j;
+            }
+        }
+    }
+    rtgui_rect_union(&set[bj], &set[bi]);
+    set[bj] = set[num - 1];
+}
+
+/* server flushes the damage at frame boundary, wake it up in case no more
+   event comes */
+static void _damage_timeout(void *param) {
+    rtgui_evt_generic_t *evt;
+    (void)param;
+
+    RTGUI_CREATE_EVENT(evt, UPDATE_FLUSH, RT_WAITING_NO);
+    if (!evt) return;
+    (void)rtgui_send_request(evt, RT_WAITING_NO);
+}
+#endif /* RTGUI_USING_DAMAGE */
 
 /* Public functions ----------------------------------------------------------*/
 rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
@@ -565,8 +1205,22 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
                 rtgui_rect_init(&rect, 0, 0, info.width, info.height);
                 rtgui_set_mainwin_rect(&rect);
             }
+            #ifdef RTGUI_USING_DAMAGE
+                ret = rt_mutex_init(&_damage_lock, "damage", RT_IPC_FLAG_FIFO);
+                if (RT_EOK != ret) break;
+                rtgui_region_init_empty(&_damage);
+                rt_timer_init(&_damage_timer, "damage", _damage_timeout,
+                    RT_NULL, RTGUI_DAMAGE_FLUSH_DELAY, RT_TIMER_FLAG_ONE_SHOT);
+            #endif
         }
 
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            if (_gfx_drv.front_buffer) {
+                rtgui_free(_gfx_drv.framebuffer);
+                _gfx_drv.front_buffer = RT_NULL;
+            }
+        #endif
+
         /* init gfx drv */
         _gfx_drv.device = dev;
         _gfx_drv.width = info.width;
@@ -584,21 +1238,37 @@ rt_err_t rtgui_set_gfx_device(rt_device_t dev) {
         }
 
         /* get ops */
-        if (!_gfx_drv.framebuffer) {
-            _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
-        } else {
-            #ifdef RTGUI_USING_FRAMEBUFFER
+        _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
+        _gfx_drv.native_ops = &_native_ops;
+        #ifdef RTGUI_USING_FRAMEBUFFER
+            if (_gfx_drv.framebuffer) {
                 _gfx_drv.ops = _get_frame_ops(_gfx_drv.pixel_format);
-            #else
-                _gfx_drv.ops = _get_pixel_ops(_gfx_drv.pixel_format);
-            #endif
-        }
-        if (!_gfx_drv.ops) {
+                _gfx_drv.native_ops = _get_frame_native_ops(
+                    _gfx_drv.pixel_format);
+            }
+        #endif
+        if (!_gfx_drv.ops || !_gfx_drv.native_ops) {
             LOG_E("no gfx ops");
             ret = -RT_ERROR;
             break;
         }
 
+        #ifdef RTGUI_USING_DOUBLE_BUFFER
+            /* render into back buffer, damage is copied to front buffer */
+            if (_gfx_drv.framebuffer) {
+                rt_uint32_t size = _gfx_drv.pitch * _gfx_drv.height;
+                rt_uint8_t *back = rtgui_malloc(size);
+
+                if (back) {
+                    rt_memcpy(back, _gfx_drv.framebuffer, size);
+                    _gfx_drv.front_buffer = _gfx_drv.framebuffer;
+                    _gfx_drv.framebuffer = back;
+                } else {
+                    LOG_E("no back buffer");
+                }
+            }
+        #endif
+
         #ifdef RTGUI_USING_HW_CURSOR
             rtgui_cursor_set_image(RTGUI_CURSOR_ARROW);
         #endif
@@ -624,26 +1294,196 @@ RTM_EXPORT(rtgui_gfx_get_rect);
 
 void rtgui_gfx_update_screen(const rtgui_gfx_driver_t *drv,
     rtgui_rect_t *rect) {
-    if (drv->device)  {
-        struct rt_device_rect_info info;
+    if (drv->device)
+        _update_screen(drv, rect);
+}
+RTM_EXPORT(rtgui_gfx_update_screen);
 
-        if ((rect->x1 >= drv->width) || (rect->y1 >= drv->height) || \
-            (rect->x2 <= 0) || (rect->y2 <= 0))
-            return;
+void rtgui_gfx_damage_add(const rtgui_gfx_driver_t *drv, rtgui_rect_t *rect) {
+    if (!drv)
+        drv = &_gfx_drv;
+    if (!drv->device) return;
 
-        info.x = rect->x1 > 0 ? rect->x1 : 0;
-        info.y = rect->y1 > 0 ? rect->y1 : 0;
+    #ifdef RTGUI_USING_DAMAGE
+    {
+        rtgui_rect_t screen, dmg = *rect;
 
-        info.width = rect->x2 > drv->width ? drv->width : rect->x2;
-        info.height = rect->y2 > drv->height ? drv->height : rect->y2;
+        rtgui_rect_init(&screen, 0, 0, drv->width, drv->height);
+        rtgui_rect_intersect(&screen, &dmg);
+        if ((dmg.x1 >= dmg.x2) || (dmg.y1 >= dmg.y2)) return;
 
-        info.width -= info.x;
-        info.height -= info.y;
+        rt_mutex_take(&_damage_lock, RT_WAITING_FOREVER);
+        if (!rtgui_region_not_empty(&_damage)) {
+            _damage_tick = rt_tick_get();
+            rt_timer_start(&_damage_timer);
+        }
+        if (PASS != rtgui_region_union_rect(&_damage, &_damage, &dmg)) {
+            /* no memory, push it now */
+            LOG_E("damage add err");
+            _update_screen(drv, &dmg);
+        }
+        _damage_stat.add_count++;
+        _damage_stat.bytes_requested += _PIXEL2BYTE(drv, _RECT_AREA(dmg));
+        rt_mutex_release(&_damage_lock);
+    }
+    #else
+        _update_screen(drv, rect);
+    #endif
+}
+RTM_EXPORT(rtgui_gfx_damage_add);
 
-        rt_device_control(drv->device, RTGRAPHIC_CTRL_RECT_UPDATE, &info);
+void rtgui_gfx_damage_flush(const rtgui_gfx_driver_t *drv, rt_bool_t force) {
+    if (!drv)
+        drv = &_gfx_drv;
+    if (!drv->device) return;
+
+    #ifdef RTGUI_USING_DAMAGE
+    {
+        rtgui_rect_t set[RTGUI_DAMAGE_MAX_RECTS + 1];
+        rtgui_rect_t *rects;
+        rt_uint32_t i, num, cnt, pixels;
+
+        rt_mutex_take(&_damage_lock, RT_WAITING_FOREVER);
+        do {
+            if (!rtgui_region_not_empty(&_damage)) break;
+            if (!force && \
+                ((rt_tick_get() - _damage_tick) < RTGUI_DAMAGE_FLUSH_DELAY))
+                break;
+
+            /* reduce to a bounded set */
+            num = rtgui_region_num_rects(&_damage);
+            rects = rtgui_region_rects(&_damage);
+            for (i = 0, cnt = 0, pixels = 0; i < num; i++) {
+                pixels += _RECT_AREA(rects[i]);
+                set[cnt++] = rects[i];
+                if (cnt > RTGUI_DAMAGE_MAX_RECTS)
+                    _damage_merge(set, cnt--);
+            }
+
+            for (i = 0; i < cnt; i++)
+                _update_screen(drv, &set[i]);
+            _damage_stat.flush_count++;
+            _damage_stat.bytes_damaged += _PIXEL2BYTE(drv, pixels);
+            rtgui_region_empty(&_damage);
+            rt_timer_stop(&_damage_timer);
+        } while (0);
+        rt_mutex_release(&_damage_lock);
     }
+    #else
+        (void)force;
+    #endif
 }
-RTM_EXPORT(rtgui_gfx_update_screen);
+RTM_EXPORT(rtgui_gfx_damage_flush);
+
+void rtgui_gfx_damage_get_stat(rtgui_damage_stat_t *stat, rt_bool_t reset) {
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (stat) *stat = _damage_stat;
+    if (reset) rt_memset(&_damage_stat, 0x00, sizeof(_damage_stat));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rtgui_gfx_damage_get_stat);
+
+#ifdef RTGUI_USING_STRIP
+rt_err_t rtgui_gfx_strip_begin(rtgui_region_t *clip,
+    const rtgui_color_t *background) {
+    rtgui_rect_t screen;
+    rt_err_t ret = RT_EOK;
+
+    rtgui_screen_lock(RT_WAITING_FOREVER);
+    do {
+        if (_strip.buffer) {
+            ret = -RT_EBUSY;
+            break;
+        }
+        /* for panel without framebuffer */
+        if (!_gfx_drv.device || _gfx_drv.framebuffer || \
+            (RTGRAPHIC_PIXEL_FORMAT_MONO == _gfx_drv.pixel_format)) {
+            ret = -RT_ENOSYS;
+            break;
+        }
+        _strip.frame_ops = _get_frame_ops(_gfx_drv.pixel_format);
+        _strip.frame_native_ops = _get_frame_native_ops(_gfx_drv.pixel_format);
+        if (!_strip.frame_ops || !_strip.frame_native_ops) {
+            ret = -RT_ENOSYS;
+            break;
+        }
+
+        rtgui_region_init_empty(&_strip.clip);
+        rtgui_rect_init(&screen, 0, 0, _gfx_drv.width, _gfx_drv.height);
+        if (PASS != rtgui_region_intersect_rect(&_strip.clip, clip, &screen)) {
+            ret = -RT_ENOMEM;
+            break;
+        }
+        if (!rtgui_region_not_empty(&_strip.clip)) {
+            rtgui_region_uninit(&_strip.clip);
+            ret = -RT_EEMPTY;
+            break;
+        }
+
+        _strip.buffer = rtgui_malloc(_gfx_drv.pitch * RTGUI_STRIP_LINES);
+        if (!_strip.buffer) {
+            rtgui_region_uninit(&_strip.clip);
+            LOG_E("no strip buffer");
+            ret = -RT_ENOMEM;
+            break;
+        }
+        /* translucent background still needs what is on screen */
+        _strip.seed_bg = background && (0xff == RTGUI_RGB_A(*background));
+        if (_strip.seed_bg)
+            _strip.background = *background;
+        _strip.y1 = _strip.clip.extents.y1;
+        _strip.y2 = _MIN(_strip.y1 + RTGUI_STRIP_LINES,
+            _strip.clip.extents.y2);
+
+        /* redirect drawing */
+        _strip.ops = _gfx_drv.ops;
+        _strip.native_ops = _gfx_drv.native_ops;
+        _gfx_drv.ops = &_strip_ops;
+        _gfx_drv.native_ops = &_strip_native_ops;
+        _gfx_drv.framebuffer = _strip.buffer;
+        _strip_seed();
+    } while (0);
+    if (RT_EOK != ret)
+        rtgui_screen_unlock();
+
+    return ret;
+}
+RTM_EXPORT(rtgui_gfx_strip_begin);
+
+rt_bool_t rtgui_gfx_strip_next(void) {
+    if (!_strip.buffer) return RT_FALSE;
+
+    _strip_push();
+    if (_strip.y2 < _strip.clip.extents.y2) {
+        _strip.y1 = _strip.y2;
+        _strip.y2 = _MIN(_strip.y1 + RTGUI_STRIP_LINES,
+            _strip.clip.extents.y2);
+        _strip_seed();
+        return RT_TRUE;
+    }
+
+    /* done */
+    _gfx_drv.ops = _strip.ops;
+    _gfx_drv.native_ops = _strip.native_ops;
+    _gfx_drv.framebuffer = RT_NULL;
+    rtgui_free(_strip.buffer);
+    _strip.buffer = RT_NULL;
+    rtgui_region_uninit(&_strip.clip);
+    rtgui_screen_unlock();
+    return RT_FALSE;
+}
+RTM_EXPORT(rtgui_gfx_strip_next);
+
+void rtgui_gfx_strip_get_stat(rtgui_strip_stat_t *stat, rt_bool_t reset) {
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (stat) *stat = _strip_stat;
+    if (reset) rt_memset(&_strip_stat, 0x00, sizeof(_strip_stat));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rtgui_gfx_strip_get_stat);
+#endif /* RTGUI_USING_STRIP */
 
 rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *drv) {
     if (!drv)
@@ -652,6 +1492,180 @@ rt_uint8_t *rtgui_gfx_get_framebuffer(const rtgui_gfx_driver_t *drv) {
 }
 RTM_EXPORT(rtgui_gfx_get_framebuffer);
 
+rtgui_color_t rtgui_gfx_color_to_native(rtgui_color_t color) {
+    switch (_gfx_drv.pixel_format) {
+
+    #if (CONFIG_USING_MONO)
+    case RTGRAPHIC_PIXEL_FORMAT_MONO:
+        #ifdef RTGUI_USING_FRAMEBUFFER
+            /* framebuffer ops take the color */
+            if (_gfx_drv.framebuffer) return color;
+        #endif
+        return rtgui_color_to_mono(color);
+    #endif
+
+    #if (CONFIG_USING_RGB565)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565:
+        return rtgui_color_to_565(color);
+    #endif
+
+    #if (CONFIG_USING_RGB565P)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB565P:
+        return rtgui_color_to_565p(color);
+    #endif
+
+    #if (CONFIG_USING_RGB888)
+    case RTGRAPHIC_PIXEL_FORMAT_RGB888:
+        return rtgui_color_to_888(color);
+    #endif
+
+    default:
+        return color;
+    }
+}
+RTM_EXPORT(rtgui_gfx_color_to_native);
+
+/* store native "pixel" as the "i"th pixel of "buf" */
+static void _blend_set_native(rt_uint8_t *buf, int i, rt_uint8_t bpp,
+    rtgui_color_t pixel) {
+    switch (bpp) {
+    case 2:
+        ((rt_uint16_t *)buf)[i] = (rt_uint16_t)pixel;
+        break;
+    case 3:
+        /* see RGB888_FROM_RGB() */
+        buf[i * 3] = (pixel >> 16) & 0xff;
+        buf[i * 3 + 1] = (pixel >> 8) & 0xff;
+        buf[i * 3 + 2] = pixel & 0xff;
+        break;
+    default:
+        ((rt_uint32_t *)buf)[i] = pixel;
+        break;
+    }
+}
+
+/* source-over "argb" pixels (or "color" if RT_NULL) on the screen, x2 is
+   exclusive. The line is blended in place if the framebuffer is addressable,
+   otherwise the translucent runs are read back by chunks, the opaque runs
+   are written without reading and the transparent runs are skipped. */
+void rtgui_gfx_blend_hline(int x1, int x2, int y, rtgui_color_t color,
+    const rtgui_color_t *argb) {
+    rtgui_blend_fill_func fill = RT_NULL;
+    rtgui_blend_line_func line = RT_NULL;
+    rt_uint32_t chunk[BLEND_CHUNK];
+    rt_uint8_t bpp = _BIT2BYTE(_gfx_drv.bits_per_pixel);
+    rtgui_color_t pixel;
+    rt_uint8_t alpha;
+    int i, num;
+
+    if (x1 >= x2) return;
+    if (!argb) {
+        /* fast path */
+        if (!RTGUI_RGB_A(color)) return;
+        if (0xff == RTGUI_RGB_A(color)) {
+            _gfx_drv.ops->draw_hline(&color, x1, x2, y);
+            return;
+        }
+        fill = rtgui_get_blend_fill_func(_gfx_drv.pixel_format);
+    } else {
+        line = rtgui_get_blend_line_func(_gfx_drv.pixel_format);
+    }
+
+    if (!fill && !line) {
+        /* no kernel, draw the more opaque half */
+        for (; x1 < x2; x1++) {
+            pixel = argb ? *argb++ : color;
+            if (RTGUI_RGB_A(pixel) & 0x80)
+                _gfx_drv.ops->set_pixel(&pixel, x1, y);
+        }
+        return;
+    }
+
+    #ifdef RTGUI_USING_FRAMEBUFFER
+        if (_gfx_drv.framebuffer) {
+            rt_uint8_t *ptr = _gfx_drv.framebuffer + _gfx_drv.pitch * y + \
+                bpp * x1;
+
+            if (fill)
+                fill(ptr, color, x2 - x1);
+            else
+                line(ptr, argb, x2 - x1);
+            return;
+        }
+    #endif
+
+    for (; x1 < x2; x1 += num) {
+        alpha = RTGUI_RGB_A(argb ? *argb : color);
+        /* run of the same kind: transparent, opaque or translucent */
+        for (num = 1; (num < BLEND_CHUNK) && (x1 + num < x2); num++) {
+            if (argb && \
+                (_ALPHA_KIND(RTGUI_RGB_A(argb[num])) != _ALPHA_KIND(alpha)))
+                break;
+        }
+
+        if (!alpha) {
+            /* skip */
+        } else if (0xff == alpha) {
+            for (i = 0; i < num; i++)
+                _blend_set_native((rt_uint8_t *)chunk, i, bpp,
+                    rtgui_gfx_color_to_native(argb[i]));
+            _gfx_drv.native_ops->draw_raw_hline((rt_uint8_t *)chunk, x1,
+                x1 + num, y);
+        } else {
+            for (i = 0; i < num; i++) {
+                _gfx_drv.native_ops->get_pixel(&pixel, x1 + i, y);
+                _blend_set_native((rt_uint8_t *)chunk, i, bpp, pixel);
+            }
+            if (fill)
+                fill((rt_uint8_t *)chunk, color, num);
+            else
+                line((rt_uint8_t *)chunk, argb, num);
+            _gfx_drv.native_ops->draw_raw_hline((rt_uint8_t *)chunk, x1,
+                x1 + num, y);
+        }
+        if (argb) argb += num;
+    }
+}
+RTM_EXPORT(rtgui_gfx_blend_hline);
+
+/* copy device "rect" to "rect" moved by (dx, dy), the two may overlap and
+   both are on screen. RT_FALSE if neither the framebuffer nor the device
+   ("move_rect" of ext_ops) can do it. */
+rt_bool_t rtgui_gfx_move_rect(rtgui_rect_t *rect, int dx, int dy) {
+    if ((rect->x1 >= rect->x2) || (rect->y1 >= rect->y2)) return RT_TRUE;
+
+    #ifdef RTGUI_USING_FRAMEBUFFER
+        if (_gfx_drv.framebuffer && (_gfx_drv.bits_per_pixel >= 8)) {
+            rt_uint8_t bpp = _BIT2BYTE(_gfx_drv.bits_per_pixel);
+            rt_uint32_t len = (rect->x2 - rect->x1) * bpp;
+            rt_uint8_t *src = _gfx_drv.framebuffer + \
+                _gfx_drv.pitch * rect->y1 + bpp * rect->x1;
+            rt_int32_t offset = (rt_int32_t)_gfx_drv.pitch * dy + bpp * dx;
+            rt_int32_t pitch = _gfx_drv.pitch;
+            int y;
+
+            /* keep the source rows ahead of the destination */
+            if (dy > 0) {
+                src += _gfx_drv.pitch * (rect->y2 - rect->y1 - 1);
+                pitch = -pitch;
+            }
+            for (y = rect->y1; y < rect->y2; y++, src += pitch)
+                rt_memmove(src + offset, src, len);
+            return RT_TRUE;
+        }
+    #endif
+
+    #ifdef RTGUI_USING_EXT_OPS
+        if (_gfx_drv.ext_ops && _gfx_drv.ext_ops->move_rect) {
+            _gfx_drv.ext_ops->move_rect(rect->x1, rect->y1, rect->x2,
+                rect->y2, dx, dy);
+            return RT_TRUE;
+        }
+    #endif
+    return RT_FALSE;
+}
+RTM_EXPORT(rtgui_gfx_move_rect);
+
 
 #ifdef CONFIG_TOUCH_DEVICE_NAME
 static void touch_available(void) {
@@ -753,3 +1767,31 @@ void rtgui_cursor_set_image(enum rtgui_cursor_type type) {
     }
 }
 #endif /* RTGUI_USING_HW_CURSOR */
+
+#ifdef RT_USING_FINSH
+# include "components/finsh/finsh.h"
+
+void list_damage(void) {
+    rtgui_damage_stat_t stat;
+
+    rtgui_gfx_damage_get_stat(&stat, RT_FALSE);
+    rt_kprintf("Adds: %d, Flushes: %d, Updates: %d\n",
+        stat.add_count, stat.flush_count, stat.update_count);
+    rt_kprintf("Bytes requested: %d, damaged: %d, pushed: %d\n",
+        stat.bytes_requested, stat.bytes_damaged, stat.bytes_pushed);
+}
+FINSH_FUNCTION_EXPORT(list_damage, display screen update statistics);
+
+# ifdef RTGUI_USING_STRIP
+void list_strip(void) {
+    rtgui_strip_stat_t stat;
+
+    rtgui_gfx_strip_get_stat(&stat, RT_FALSE);
+    rt_kprintf("Strips: %d, Fill rate: %d%%, Bus bytes: %d\n",
+        stat.strip_count,
+        stat.strip_pixels ? (stat.push_pixels * 100 / stat.strip_pixels) : 0,
+        stat.bus_bytes);
+}
+FINSH_FUNCTION_EXPORT(list_strip, display strip render statistics);
+# endif
+#endif /* RT_USING_FINSH */
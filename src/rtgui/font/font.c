@@ -39,13 +39,111 @@
 
 /* Private function prototype ------------------------------------------------*/
 /* Private typedef -----------------------------------------------------------*/
+#ifdef RTGUI_USING_GLYPH_CACHE
+    typedef struct rtgui_glyph {
+        rt_list_t lru;                  /* most recently used first */
+        struct rtgui_glyph *next;       /* hash chain */
+        rtgui_font_t *font;
+        rt_uint16_t code;
+        rt_uint8_t width;               /* glyph width */
+        rt_uint8_t mask[];              /* "font->width" bits per row */
+    } rtgui_glyph_t;
+#endif
+
 /* Private define ------------------------------------------------------------*/
+#ifdef RTGUI_USING_GLYPH_CACHE
+# if ((RTGUI_GLYPH_CACHE_HASH <= 0) || \
+      (RTGUI_GLYPH_CACHE_HASH & (RTGUI_GLYPH_CACHE_HASH - 1)))
+#  error "RTGUI_GLYPH_CACHE_HASH must be power of 2"
+# endif
+# define GLYPH_MASK_SIZE(font)      \
+    (((font)->width * (font)->height + 7) >> 3)
+/* the mask is copied to stack to draw, larger glyph is not cached */
+# define GLYPH_MASK_MAX             (32 * 32 / 8)
+# define GLYPH_HASH(font, code)     \
+    ((((rt_ubase_t)(font) >> 4) + (code)) & (RTGUI_GLYPH_CACHE_HASH - 1))
+#endif
+
 /* Private variables ---------------------------------------------------------*/
 static rt_slist_t _font_list;
 static rtgui_font_t *_default_font;
+#ifdef RTGUI_USING_GLYPH_CACHE
+    static struct rt_mutex _cache_lock;
+    static rt_list_t _cache_lru;
+    static rtgui_glyph_t *_cache_hash[RTGUI_GLYPH_CACHE_HASH];
+    static rtgui_glyph_cache_stat_t _cache_stat;
+#endif
 
 /* Imported variables --------------------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
+#ifdef RTGUI_USING_GLYPH_CACHE
+static void _glyph_cache_drop(rtgui_glyph_t *glyph) {
+    rtgui_glyph_t **prev;
+
+    prev = &_cache_hash[GLYPH_HASH(glyph->font, glyph->code)];
+    while (*prev != glyph)
+        prev = &(*prev)->next;
+    *prev = glyph->next;
+    rt_list_remove(&glyph->lru);
+
+    _cache_stat.glyphs--;
+    _cache_stat.bytes -= sizeof(rtgui_glyph_t) + GLYPH_MASK_SIZE(glyph->font);
+    rtgui_free(glyph);
+}
+
+/* find or render a glyph, RT_NULL if it can't be cached */
+static rtgui_glyph_t *_glyph_cache_get(rtgui_font_t *font, rt_uint16_t code) {
+    rtgui_glyph_t *glyph;
+    rt_uint32_t idx, size;
+
+    idx = GLYPH_HASH(font, code);
+    for (glyph = _cache_hash[idx]; glyph; glyph = glyph->next) {
+        if ((glyph->font != font) || (glyph->code != code)) continue;
+        _cache_stat.hit_count++;
+        rt_list_remove(&glyph->lru);
+        rt_list_insert_after(&_cache_lru, &glyph->lru);
+        return glyph;
+    }
+
+    _cache_stat.miss_count++;
+    if (GLYPH_MASK_SIZE(font) > GLYPH_MASK_MAX) return RT_NULL;
+    size = sizeof(rtgui_glyph_t) + GLYPH_MASK_SIZE(font);
+    if (size > RTGUI_GLYPH_CACHE_SIZE) return RT_NULL;
+    /* make room from the least recently used */
+    while ((_cache_stat.bytes + size) > RTGUI_GLYPH_CACHE_SIZE) {
+        _glyph_cache_drop(rt_list_entry(_cache_lru.prev, rtgui_glyph_t, lru));
+        _cache_stat.evict_count++;
+    }
+
+    glyph = rtgui_malloc(size);
+    if (!glyph) return RT_NULL;
+    rt_memset(glyph->mask, 0x00, GLYPH_MASK_SIZE(font));
+    glyph->font = font;
+    glyph->code = code;
+    glyph->width = font->engine->font_get_mask(font, code, glyph->mask);
+
+    glyph->next = _cache_hash[idx];
+    _cache_hash[idx] = glyph;
+    rt_list_insert_after(&_cache_lru, &glyph->lru);
+    _cache_stat.glyphs++;
+    _cache_stat.bytes += size;
+
+    return glyph;
+}
+#endif /* RTGUI_USING_GLYPH_CACHE */
+
+/* refer the companion font: "hz" for "asc" and "asc" for others */
+static rtgui_font_t *_font_refer_alt(rtgui_font_t *font) {
+    if (!rt_strcasecmp(font->family, "asc")) {
+        #if (CONFIG_USING_FONT_HZ)
+            return rtgui_font_refer("hz", font->height);
+        #else
+            return RT_NULL;
+        #endif
+    }
+    return rtgui_font_refer("asc", font->height);
+}
+
 /* Public functions ----------------------------------------------------------*/
 rt_err_t rtgui_font_system_init(void) {
     rt_err_t ret;
@@ -55,6 +153,12 @@ rt_err_t rtgui_font_system_init(void) {
     ret = RT_EOK;
 
     do {
+        #ifdef RTGUI_USING_GLYPH_CACHE
+            ret = rt_mutex_init(&_cache_lock, "glyph", RT_IPC_FLAG_FIFO);
+            if (RT_EOK != ret) break;
+            rt_list_init(&_cache_lru);
+        #endif
+
         #if (CONFIG_USING_FONT_12)
             ret = rtgui_font_system_add_font(&rtgui_font_asc12);
             if (RT_EOK != ret) break;
@@ -121,9 +225,15 @@ rt_err_t rtgui_font_system_add_font(rtgui_font_t *font) {
 RTM_EXPORT(rtgui_font_system_add_font);
 
 void rtgui_font_system_remove_font(rtgui_font_t *font) {
+    #ifdef RTGUI_USING_GLYPH_CACHE
+        rtgui_font_cache_flush(font);
+    #endif
     if (font->engine->font_close) {
         font->engine->font_close(font);
     }
+    if (font->engine->font_uninit) {
+        font->engine->font_uninit(font);
+    }
     rt_slist_remove(&_font_list, &(font->list));
 }
 RTM_EXPORT(rtgui_font_system_remove_font);
@@ -238,6 +348,28 @@ rt_uint8_t rtgui_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect) {
     RT_ASSERT(font != RT_NULL);
 
+    #ifdef RTGUI_USING_GLYPH_CACHE
+        if (font->engine && font->engine->font_get_mask) {
+            rtgui_glyph_t *glyph;
+            rt_uint8_t mask[GLYPH_MASK_MAX];
+            rt_uint8_t w = 0;
+
+            /* copy out, not to draw with the cache locked */
+            rt_mutex_take(&_cache_lock, RT_WAITING_FOREVER);
+            glyph = _glyph_cache_get(font, code);
+            if (glyph) {
+                w = _MIN(RECT_W(*rect), glyph->width);
+                rt_memcpy(mask, glyph->mask, GLYPH_MASK_SIZE(font));
+            }
+            rt_mutex_release(&_cache_lock);
+            if (glyph) {
+                rtgui_dc_draw_mono_mask(dc, rect->x1, rect->y1, w,
+                    _MIN(RECT_H(*rect), font->height), mask, font->width);
+                return w;
+            }
+        }
+    #endif
+
     if (font->engine && font->engine->font_draw_char)
         return font->engine->font_draw_char(font, dc, code, rect);
     return 0;
@@ -304,3 +436,152 @@ void rtgui_font_get_metrics(rtgui_font_t *font, const char *text,
     rect->y2 = font->height;
 }
 RTM_EXPORT(rtgui_font_get_metrics);
+
+/* decode "text" once, the layout is valid until "text" or "font" changed */
+rt_err_t rtgui_text_layout_build(rtgui_text_layout_t *layout,
+    rtgui_font_t *font, const char *text) {
+    rt_uint8_t *utf8;
+    #if (CONFIG_USING_FONT_HZ)
+        rtgui_font_t *ascii, *non_ascii;
+    #endif
+    rtgui_text_glyph_t *glyph;
+    rt_uint32_t count, w;
+    rt_uint8_t sz;
+
+    RT_ASSERT(font != RT_NULL);
+
+    rtgui_text_layout_free(layout);
+
+    /* count glyphs */
+    count = 0;
+    for (utf8 = (rt_uint8_t *)text; utf8 && *utf8; utf8 += UTF8_SIZE(*utf8))
+        count++;
+    if (count > 0xFFFF) return -RT_ERROR;
+    if (count) {
+        layout->glyphs = rtgui_malloc(count * sizeof(rtgui_text_glyph_t));
+        if (!layout->glyphs) return -RT_ENOMEM;
+    }
+
+    layout->alt = _font_refer_alt(font);
+    #if (CONFIG_USING_FONT_HZ)
+        if (!rt_strcasecmp(font->family, "asc")) {
+            ascii = font;
+            non_ascii = layout->alt;
+        } else {
+            ascii = layout->alt;
+            non_ascii = font;
+        }
+    #endif
+
+    w = 0;
+    glyph = layout->glyphs;
+    for (utf8 = (rt_uint8_t *)text; count && *utf8; utf8 += sz, glyph++) {
+        sz = UTF8_SIZE(*utf8);
+        #if (CONFIG_USING_FONT_HZ)
+            if (IS_ASCII(utf8, sz) && ascii) {
+                glyph->code = UTF8_TO_UNICODE(utf8, sz);
+                glyph->alt = (ascii != font);
+            } else if (non_ascii) {
+                glyph->code = UnicodeToGB2312(UTF8_TO_UNICODE(utf8, sz));
+                glyph->alt = (non_ascii != font);
+            } else
+        #endif
+        {
+            glyph->code = UTF8_TO_UNICODE(utf8, sz);
+            glyph->alt = RT_FALSE;
+        }
+        glyph->width = rtgui_font_get_width(
+            glyph->alt ? layout->alt : font, (const char *)utf8);
+        w += glyph->width;
+    }
+
+    layout->font = font;
+    layout->count = count;
+    layout->width = _MIN(w, 0xFFFF);
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_text_layout_build);
+
+void rtgui_text_layout_free(rtgui_text_layout_t *layout) {
+    if (layout->glyphs) rtgui_free(layout->glyphs);
+    if (layout->alt) rtgui_font_derefer(layout->alt);
+    rt_memset(layout, 0x00, sizeof(rtgui_text_layout_t));
+}
+RTM_EXPORT(rtgui_text_layout_free);
+
+void rtgui_text_layout_get_metrics(rtgui_text_layout_t *layout,
+    rtgui_rect_t *rect) {
+    rect->x1 = 0;
+    rect->x2 = layout->width;
+    rect->y1 = 0;
+    rect->y2 = layout->font ? layout->font->height : 0;
+}
+RTM_EXPORT(rtgui_text_layout_get_metrics);
+
+void rtgui_text_layout_draw(rtgui_text_layout_t *layout, rtgui_dc_t *dc,
+    rtgui_rect_t *rect) {
+    rtgui_font_t *font = layout->font;
+    rtgui_font_t *alt = layout->alt;
+    rtgui_rect_t text_rect;
+    rt_uint32_t i;
+
+    if (!font || !layout->count) return;
+
+    rtgui_text_layout_get_metrics(layout, &text_rect);
+    rtgui_rect_move_align(rect, &text_rect, RTGUI_DC_TEXTALIGN(dc));
+
+    do {
+        if (font->engine->font_open) {
+            if (RT_EOK != font->engine->font_open(font)) break;
+        }
+        if (alt && alt->engine->font_open) {
+            if (RT_EOK != alt->engine->font_open(alt)) {
+                if (font->engine->font_close) font->engine->font_close(font);
+                break;
+            }
+        }
+
+        for (i = 0; (text_rect.x1 < text_rect.x2) && (i < layout->count);
+            i++) {
+            text_rect.x1 += rtgui_font_draw_char(
+                layout->glyphs[i].alt ? alt : font, dc,
+                layout->glyphs[i].code, &text_rect);
+        }
+
+        if (font->engine->font_close) font->engine->font_close(font);
+        if (alt && alt->engine->font_close) alt->engine->font_close(alt);
+    } while (0);
+}
+RTM_EXPORT(rtgui_text_layout_draw);
+
+#ifdef RTGUI_USING_GLYPH_CACHE
+/* drop the cached glyphs of "font", or all if RT_NULL */
+void rtgui_font_cache_flush(rtgui_font_t *font) {
+    rt_list_t *node, *next;
+    rtgui_glyph_t *glyph;
+
+    rt_mutex_take(&_cache_lock, RT_WAITING_FOREVER);
+    for (node = _cache_lru.next; node != &_cache_lru; node = next) {
+        next = node->next;
+        glyph = rt_list_entry(node, rtgui_glyph_t, lru);
+        if (!font || (glyph->font == font))
+            _glyph_cache_drop(glyph);
+    }
+    rt_mutex_release(&_cache_lock);
+}
+RTM_EXPORT(rtgui_font_cache_flush);
+
+void rtgui_font_cache_get_stat(rtgui_glyph_cache_stat_t *stat,
+    rt_bool_t reset) {
+    rt_mutex_take(&_cache_lock, RT_WAITING_FOREVER);
+    if (stat) *stat = _cache_stat;
+    if (reset) {
+        /* counters only, the content stays */
+        _cache_stat.hit_count = 0;
+        _cache_stat.miss_count = 0;
+        _cache_stat.evict_count = 0;
+    }
+    rt_mutex_release(&_cache_lock);
+}
+RTM_EXPORT(rtgui_font_cache_get_stat);
+#endif /* RTGUI_USING_GLYPH_CACHE */
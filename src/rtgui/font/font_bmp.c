@@ -24,13 +24,7 @@
  */
 /* Includes ------------------------------------------------------------------*/
 #include "include/rtgui.h"
-
-#if (CONFIG_USING_FONT_FILE)
-# ifndef RT_USING_DFS
-#  error "Please enable RT_USING_DFS for CONFIG_USING_FONT_FILE"
-# endif
-# include "components/dfs/include/dfs_posix.h"
-#endif
+#include "include/font/font.h"
 
 #ifdef RT_USING_ULOG
 # define LOG_LVL                    RTGUI_LOG_LEVEL
@@ -45,10 +39,13 @@
 #if (CONFIG_USING_FONT_FILE)
 static rt_err_t bmp_font_open(rtgui_font_t *font);
 static void bmp_font_close(rtgui_font_t *font);
+static void bmp_font_uninit(rtgui_font_t *font);
 #endif
 static rt_uint8_t bmp_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect);
 static rt_uint8_t bmp_font_get_width(rtgui_font_t *font, const char *utf8);
+static rt_uint8_t bmp_font_get_mask(rtgui_font_t *font, rt_uint16_t code,
+    rt_uint8_t *mask);
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
@@ -58,14 +55,17 @@ static rt_uint8_t bmp_font_get_width(rtgui_font_t *font, const char *utf8);
 const rtgui_font_engine_t bmp_font_engine = {
     .font_init = RT_NULL,
     #if (CONFIG_USING_FONT_FILE)
+        .font_uninit = bmp_font_uninit,
         .font_open = bmp_font_open,
         .font_close = bmp_font_close,
     #else
+        .font_uninit = RT_NULL,
         .font_open = RT_NULL,
         .font_close = RT_NULL,
     #endif
     .font_draw_char = bmp_font_draw_char,
     .font_get_width = bmp_font_get_width,
+    .font_get_mask = bmp_font_get_mask,
 };
 
 #if (CONFIG_USING_FONT_12)
@@ -73,8 +73,10 @@ const rtgui_font_engine_t bmp_font_engine = {
 #  if (CONFIG_USING_FONT_FILE)
     static rtgui_bmp_font_t _hz12 = {
         .data = RT_NULL,
-        .fname = "/font/hz12.fnt",
-        .fd = -1,
+        .file = {
+            .fname = "/font/hz12.fnt", .fd = -1,
+            .map = (const rt_uint8_t *)CONFIG_FONT_HZ12_MAP,
+        },
     };
 #  else
 #   include "include/font/hz12font.h"
@@ -103,8 +105,10 @@ const rtgui_font_engine_t bmp_font_engine = {
 # if (CONFIG_USING_FONT_FILE)
     static rtgui_bmp_font_t _asc16 = {
         .data = RT_NULL,
-        .fname = "/font/asc16.fnt",
-        .fd = -1,
+        .file = {
+            .fname = "/font/asc16.fnt", .fd = -1,
+            .map = (const rt_uint8_t *)CONFIG_FONT_ASC16_MAP,
+        },
     };
 # else
 #   include "include/font/asc16font.h"
@@ -131,8 +135,10 @@ const rtgui_font_engine_t bmp_font_engine = {
 #  if (CONFIG_USING_FONT_FILE)
     static rtgui_bmp_font_t _hz16 = {
         .data = RT_NULL,
-        .fname = "/font/hz16.fnt",
-        .fd = -1,
+        .file = {
+            .fname = "/font/hz16.fnt", .fd = -1,
+            .map = (const rt_uint8_t *)CONFIG_FONT_HZ16_MAP,
+        },
     };
 #  else
 #   include "include/font/hz16font.h"
@@ -167,29 +173,29 @@ static rt_err_t bmp_font_open(rtgui_font_t *font) {
     ret = RT_EOK;
 
     do {
-        if (!bmp_fnt->fname) {
+        if (!bmp_fnt->file.fname) {
             if (!bmp_fnt->data) {
                 /* no in file and no in ROM */
                 ret = -RT_ERROR;
             }
             break;
         }
-        bmp_fnt->fd = open(bmp_fnt->fname, O_RDONLY);
-        if (bmp_fnt->fd < 0) {
-            ret = -RT_EIO;
-            break;
-        }
-        bmp_fnt->data = rtgui_malloc(font->size);
-        if (!bmp_fnt->data) {
-            ret = -RT_ENOMEM;
-            break;
+        ret = rtgui_font_file_open(&bmp_fnt->file);
+        if (RT_EOK != ret) break;
+        /* glyph buffer, not needed if the whole file is in memory */
+        if (!bmp_fnt->file.base && !bmp_fnt->data) {
+            bmp_fnt->data = rtgui_malloc(font->size);
+            if (!bmp_fnt->data) {
+                ret = -RT_ENOMEM;
+                break;
+            }
         }
     } while (0);
 
     if (RT_EOK != ret) {
-        LOG_E("open %s err [%d]", bmp_fnt->fname, ret);
-    } else if (bmp_fnt->fname) {
-        // LOG_D("open %s", bmp_fnt->fname);
+        LOG_E("open %s err [%d]", bmp_fnt->file.fname, ret);
+    } else if (bmp_fnt->file.fname) {
+        // LOG_D("open %s", bmp_fnt->file.fname);
     }
     return ret;
 }
@@ -199,16 +205,25 @@ static void bmp_font_close(rtgui_font_t *font) {
 
     bmp_fnt = font->data;
 
-    if (bmp_fnt->fd >= 0) {
-        close(bmp_fnt->fd);
-        bmp_fnt->fd = -1;
+    if (bmp_fnt->file.fname) {
+        rtgui_font_file_close(&bmp_fnt->file);
         if (bmp_fnt->data) {
             rtgui_free(bmp_fnt->data);
             bmp_fnt->data = RT_NULL;
         }
-        // LOG_D("closed %s", bmp_fnt->fname);
+        // LOG_D("closed %s", bmp_fnt->file.fname);
     }
 }
+
+static void bmp_font_uninit(rtgui_font_t *font) {
+    rtgui_bmp_font_t *bmp_fnt;
+
+    bmp_fnt = font->data;
+
+    /* release the loaded or cached file */
+    if (bmp_fnt->file.fname)
+        rtgui_font_file_unload(&bmp_fnt->file);
+}
 #endif /* CONFIG_USING_FONT_FILE */
 
 static const rt_uint8_t *_bmp_font_get_data(rtgui_font_t *font,
@@ -225,43 +240,18 @@ static const rt_uint8_t *_bmp_font_get_data(rtgui_font_t *font,
     }
 
     #if (CONFIG_USING_FONT_FILE)
-        if (bmp_fnt->fname) {
-            do {
-                if (bmp_fnt->fd < 0) {
-                    LOG_E("no fd %s", bmp_fnt->fname);
-                    break;
-                }
-                if (lseek(bmp_fnt->fd, offset, SEEK_SET) < 0) {
-                    LOG_E("seek %s err", bmp_fnt->fname);
-                    break;
-                }
-                if (font->size != (rt_uint16_t)read(
-                    bmp_fnt->fd, bmp_fnt->data, font->size)) {
-                    LOG_E("read %s err", bmp_fnt->fname);
-                    break;
-                }
-            } while (0);
-            return bmp_fnt->data;
-        } else {
+        if (bmp_fnt->file.fname)
+            return rtgui_font_file_read(&bmp_fnt->file, offset, font->size,
+                bmp_fnt->data);
     #endif
 
-        return bmp_fnt->data + offset;
-
-    #if (CONFIG_USING_FONT_FILE)
-        }
-    #endif
+    return bmp_fnt->data + offset;
 }
 
 static rt_uint8_t bmp_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect) {
-    rtgui_color_t bc;
-    rt_uint16_t style;
     const rt_uint8_t *data;
-    rt_int8_t oft;
-    rt_uint8_t w, h, sft, lst_sft, bit, line;
-
-    bc = RTGUI_DC_BC(dc);
-    style = rtgui_dc_get_gc(dc)->textstyle;
+    rt_uint8_t w, h;
 
     if ((code < font->start) || (code > font->end)) {
         code = font->dft;
@@ -271,24 +261,8 @@ static rt_uint8_t bmp_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
 
     w = _MIN(RECT_W(*rect), font->width);
     h = _MIN(RECT_H(*rect), font->height);
-    oft = -1;
-    sft = 0;
-    lst_sft = 0;
-
-    for (line = 0; line < h; line++) {
-        /* draw a line */
-        for (bit = 0; bit < w; bit++) {
-            sft = (bit + lst_sft) % 8;
-            if (!sft) oft++;
-            if (data[oft] & (1 << (7 - sft))) {
-                rtgui_dc_draw_point(dc, rect->x1 + bit, rect->y1 + line);
-            } else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND) {
-                rtgui_dc_draw_color_point(
-                    dc, rect->x1 + bit, rect->y1 + line, bc);
-            }
-        }
-        lst_sft = sft + 1;
-    }
+    /* rows are packed, "font->width" bits each */
+    rtgui_dc_draw_mono_mask(dc, rect->x1, rect->y1, w, h, data, font->width);
 
     return w;
 }
@@ -299,4 +273,16 @@ static rt_uint8_t bmp_font_get_width(rtgui_font_t *font, const char *utf8) {
     return font->width;
 }
 
+static rt_uint8_t bmp_font_get_mask(rtgui_font_t *font, rt_uint16_t code,
+    rt_uint8_t *mask) {
+    if ((code < font->start) || (code > font->end)) {
+        code = font->dft;
+        LOG_D("used dft code %x", code);
+    }
+    /* already a mask */
+    rt_memcpy(mask, _bmp_font_get_data(font, code), font->size);
+
+    return font->width;
+}
+
 /* Public functions ----------------------------------------------------------*/
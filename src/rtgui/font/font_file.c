@@ -0,0 +1,253 @@
+/*
+ * File      : font_file.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-20     onelife      first version
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+#include "include/font/font.h"
+#include "include/rthw.h" // rt_hw_interrupt_disable()
+
+#if (CONFIG_USING_FONT_FILE)
+#ifndef RT_USING_DFS
+# error "Please enable RT_USING_DFS for CONFIG_USING_FONT_FILE"
+#endif
+#include "components/dfs/include/dfs_posix.h"
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    "FNT_FIL"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private function prototype ------------------------------------------------*/
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#define PAGE_INVALID                (0xFFFFFFFF)
+#define PAGE_DATA(file, i)          ((file)->pages + (i) * CONFIG_FONT_PAGE_SIZE)
+
+/* Private variables ---------------------------------------------------------*/
+static rtgui_font_file_stat_t _file_stat;
+
+/* Private functions ---------------------------------------------------------*/
+/* pick the storage at the first open: load or cache */
+static void _font_file_setup(rtgui_font_file_t *file) {
+    rt_uint8_t *buf;
+    long size;
+    rt_uint32_t i;
+
+    do {
+        size = lseek(file->fd, 0, SEEK_END);
+        if ((size > 0) && (size <= CONFIG_FONT_LOAD_MAX)) {
+            buf = rtgui_malloc(size);
+            if (buf) {
+                if (!lseek(file->fd, 0, SEEK_SET) && \
+                    (size == read(file->fd, buf, size))) {
+                    _file_stat.read_count++;
+                    _file_stat.read_bytes += size;
+                    file->base = buf;
+                    file->storage = RTGUI_FONT_STORAGE_RAM;
+                    break;
+                }
+                rtgui_free(buf);
+            }
+        }
+
+        file->pages = rtgui_malloc(CONFIG_FONT_PAGE_NUM * CONFIG_FONT_PAGE_SIZE);
+        if (file->pages) {
+            for (i = 0; i < CONFIG_FONT_PAGE_NUM; i++) {
+                file->page_off[i] = PAGE_INVALID;
+                file->page_use[i] = 0;
+            }
+            file->use = 0;
+            file->storage = RTGUI_FONT_STORAGE_CACHE;
+            break;
+        }
+
+        file->storage = RTGUI_FONT_STORAGE_READ;
+    } while (0);
+
+    /* no more file access if in memory */
+    if (file->base) {
+        close(file->fd);
+        file->fd = -1;
+    }
+    LOG_D("%s storage %d", file->fname, file->storage);
+}
+
+static rt_int32_t _font_file_find_page(rtgui_font_file_t *file,
+    rt_uint32_t offset) {
+    rt_uint32_t i;
+
+    for (i = 0; i < CONFIG_FONT_PAGE_NUM; i++) {
+        if (file->page_off[i] == offset) return i;
+    }
+    return -1;
+}
+
+/* get the page at "offset", on miss also read the following pages as the
+   neighbor codes (e.g. the same GB2312 row) are likely to be used next */
+static const rt_uint8_t *_font_file_get_page(rtgui_font_file_t *file,
+    rt_uint32_t offset) {
+    const rt_uint8_t *page = RT_NULL;
+    rt_int32_t idx;
+    rt_uint32_t i, ahead;
+    int len;
+
+    file->use++;
+    idx = _font_file_find_page(file, offset);
+    if (idx >= 0) {
+        _file_stat.page_hit++;
+        file->page_use[idx] = file->use;
+        return PAGE_DATA(file, idx);
+    }
+
+    _file_stat.page_miss++;
+    if ((file->fd < 0) || (lseek(file->fd, offset, SEEK_SET) < 0))
+        return RT_NULL;
+
+    for (ahead = 0; ahead < _MIN(CONFIG_FONT_READ_AHEAD, CONFIG_FONT_PAGE_NUM);
+        ahead++, offset += CONFIG_FONT_PAGE_SIZE) {
+        /* stop at a cached page to keep reading in sequence */
+        if (ahead && (_font_file_find_page(file, offset) >= 0)) break;
+
+        /* least recently used, the pages just read are the most recent */
+        for (idx = 0, i = 1; i < CONFIG_FONT_PAGE_NUM; i++) {
+            if (file->page_use[i] < file->page_use[idx]) idx = i;
+        }
+        file->page_off[idx] = PAGE_INVALID;
+        len = read(file->fd, PAGE_DATA(file, idx), CONFIG_FONT_PAGE_SIZE);
+        if (len <= 0) break;
+
+        _file_stat.read_count++;
+        _file_stat.read_bytes += len;
+        file->page_off[idx] = offset;
+        file->page_use[idx] = file->use;
+        if (!ahead) page = PAGE_DATA(file, idx);
+        /* end of file */
+        if (len < CONFIG_FONT_PAGE_SIZE) break;
+    }
+
+    return page;
+}
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t rtgui_font_file_open(rtgui_font_file_t *file) {
+    /* mapped or loaded */
+    if (file->base) return RT_EOK;
+
+    /* DFS has no call to get the address of a file, so it is configured */
+    if (file->map) {
+        file->base = file->map;
+        file->storage = RTGUI_FONT_STORAGE_MAP;
+        return RT_EOK;
+    }
+
+    if (file->fd < 0) {
+        file->fd = open(file->fname, O_RDONLY);
+        if (file->fd < 0) return -RT_EIO;
+    }
+    if (RTGUI_FONT_STORAGE_NONE == file->storage)
+        _font_file_setup(file);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rtgui_font_file_open);
+
+void rtgui_font_file_close(rtgui_font_file_t *file) {
+    /* the storage is kept */
+    if (file->fd >= 0) {
+        close(file->fd);
+        file->fd = -1;
+    }
+}
+RTM_EXPORT(rtgui_font_file_close);
+
+void rtgui_font_file_unload(rtgui_font_file_t *file) {
+    rtgui_font_file_close(file);
+    if (RTGUI_FONT_STORAGE_RAM == file->storage)
+        rtgui_free((void *)file->base);
+    if (file->pages)
+        rtgui_free(file->pages);
+    file->base = RT_NULL;
+    file->pages = RT_NULL;
+    file->storage = RTGUI_FONT_STORAGE_NONE;
+}
+RTM_EXPORT(rtgui_font_file_unload);
+
+/* get "size" bytes at "offset", "buf" is used only if the data is not in
+   memory or crosses pages */
+const rt_uint8_t *rtgui_font_file_read(rtgui_font_file_t *file,
+    rt_uint32_t offset, rt_uint32_t size, rt_uint8_t *buf) {
+    const rt_uint8_t *page;
+    rt_uint32_t done, pos, len;
+
+    _file_stat.glyph_count++;
+    if (file->base) return file->base + offset;
+
+    if (RTGUI_FONT_STORAGE_CACHE == file->storage) {
+        for (done = 0; done < size; done += len) {
+            pos = (offset + done) % CONFIG_FONT_PAGE_SIZE;
+            len = _MIN(size - done, CONFIG_FONT_PAGE_SIZE - pos);
+            page = _font_file_get_page(file, offset + done - pos);
+            if (!page) break;
+            /* in one page */
+            if (len == size) return page + pos;
+            rt_memcpy(buf + done, page + pos, len);
+        }
+        if (done >= size) return buf;
+    }
+
+    do {
+        if (file->fd < 0) {
+            LOG_E("no fd %s", file->fname);
+            break;
+        }
+        if (lseek(file->fd, offset, SEEK_SET) < 0) {
+            LOG_E("seek %s err", file->fname);
+            break;
+        }
+        if (size != (rt_uint32_t)read(file->fd, buf, size)) {
+            LOG_E("read %s err", file->fname);
+            break;
+        }
+        _file_stat.read_count++;
+        _file_stat.read_bytes += size;
+    } while (0);
+
+    return buf;
+}
+RTM_EXPORT(rtgui_font_file_read);
+
+void rtgui_font_file_get_stat(rtgui_font_file_stat_t *stat,
+    rt_bool_t reset) {
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (stat) *stat = _file_stat;
+    if (reset) rt_memset(&_file_stat, 0x00, sizeof(_file_stat));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rtgui_font_file_get_stat);
+
+#endif /* CONFIG_USING_FONT_FILE */
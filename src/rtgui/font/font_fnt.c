@@ -26,13 +26,6 @@
 #include "include/rtgui.h"
 #include "include/font/font.h"
 
-#if (CONFIG_USING_FONT_FILE)
-# ifndef RT_USING_DFS
-#  error "Please enable RT_USING_DFS for CONFIG_USING_FONT_FILE"
-# endif
-# include "components/dfs/include/dfs_posix.h"
-#endif
-
 #ifdef RT_USING_ULOG
 # define LOG_LVL                    RTGUI_LOG_LEVEL
 # define LOG_TAG                    "FNT_FNT"
@@ -46,27 +39,34 @@
 #if (CONFIG_USING_FONT_FILE)
 static rt_err_t fnt_font_open(rtgui_font_t *font);
 static void fnt_font_close(rtgui_font_t *font);
+static void fnt_font_uninit(rtgui_font_t *font);
 #endif
 static rt_uint8_t fnt_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect);
 static rt_uint8_t fnt_font_get_width(rtgui_font_t *font, const char *utf8);
+static rt_uint8_t fnt_font_get_mask(rtgui_font_t *font, rt_uint16_t code,
+    rt_uint8_t *mask);
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+#define FNT_MASK_SIZE               (16)    /* max font width and height */
 /* Private variables ---------------------------------------------------------*/
 /* Imported variables --------------------------------------------------------*/
 /* Exported constants --------------------------------------------------------*/
 const rtgui_font_engine_t fnt_font_engine = {
     .font_init = RT_NULL,
     #if (CONFIG_USING_FONT_FILE)
+        .font_uninit = fnt_font_uninit,
         .font_open = fnt_font_open,
         .font_close = fnt_font_close,
     #else
+        .font_uninit = RT_NULL,
         .font_open = RT_NULL,
         .font_close = RT_NULL,
     #endif
     .font_draw_char = fnt_font_draw_char,
     .font_get_width = fnt_font_get_width,
+    .font_get_mask = fnt_font_get_mask,
 };
 
 #if (CONFIG_USING_FONT_12)
@@ -77,8 +77,10 @@ const rtgui_font_engine_t fnt_font_engine = {
         .data = RT_NULL,
         .offset = _sysfont_offset,
         .width = _sysfont_width,
-        .fname = "/font/asc12.fnt",
-        .fd = -1,
+        .file = {
+            .fname = "/font/asc12.fnt", .fd = -1,
+            .map = (const rt_uint8_t *)CONFIG_FONT_ASC12_MAP,
+        },
     };
 # else
     static rtgui_fnt_font_t _asc12 = {
@@ -113,29 +115,29 @@ static rt_err_t fnt_font_open(rtgui_font_t *font) {
     ret = RT_EOK;
 
     do {
-        if (!fnt_font->fname) {
+        if (!fnt_font->file.fname) {
             if (!fnt_font->data) {
                 /* no in file and no in ROM */
                 ret = -RT_ERROR;
             }
             break;
         }
-        fnt_font->fd = open(fnt_font->fname, O_RDONLY);
-        if (fnt_font->fd < 0) {
-            ret = -RT_EIO;
-            break;
-        }
-        fnt_font->data = rtgui_malloc(font->size);
-        if (!fnt_font->data) {
-            ret = -RT_ENOMEM;
-            break;
+        ret = rtgui_font_file_open(&fnt_font->file);
+        if (RT_EOK != ret) break;
+        /* glyph buffer, not needed if the whole file is in memory */
+        if (!fnt_font->file.base && !fnt_font->data) {
+            fnt_font->data = rtgui_malloc(font->size);
+            if (!fnt_font->data) {
+                ret = -RT_ENOMEM;
+                break;
+            }
         }
     } while (0);
 
     if (RT_EOK != ret) {
-        LOG_E("open %s err [%d]", fnt_font->fname, ret);
-    } else if (fnt_font->fname) {
-        LOG_D("open %s", fnt_font->fname);
+        LOG_E("open %s err [%d]", fnt_font->file.fname, ret);
+    } else if (fnt_font->file.fname) {
+        LOG_D("open %s", fnt_font->file.fname);
     }
     return ret;
 }
@@ -145,97 +147,54 @@ static void fnt_font_close(rtgui_font_t *font) {
 
     fnt_font = font->data;
 
-    if (fnt_font->fd >= 0) {
-        close(fnt_font->fd);
-        fnt_font->fd = -1;
+    if (fnt_font->file.fname) {
+        rtgui_font_file_close(&fnt_font->file);
         if (fnt_font->data) {
             rtgui_free(fnt_font->data);
             fnt_font->data = RT_NULL;
         }
-        LOG_D("closed %s", fnt_font->fname);
+        LOG_D("closed %s", fnt_font->file.fname);
     }
 }
+
+static void fnt_font_uninit(rtgui_font_t *font) {
+    rtgui_fnt_font_t *fnt_font;
+
+    fnt_font = font->data;
+
+    /* release the loaded or cached file */
+    if (fnt_font->file.fname)
+        rtgui_font_file_unload(&fnt_font->file);
+}
 #endif /* CONFIG_USING_FONT_FILE */
 
 static const rt_uint8_t *_fnt_font_get_data(rtgui_font_t *font,
     rt_uint16_t code) {
     rtgui_fnt_font_t *fnt_font;
-    rt_uint32_t offset, size;
+    rt_uint32_t offset;
 
     fnt_font = font->data;
     offset = fnt_font->offset[code - font->start];
-    size = fnt_font->width[code - font->start] * 2;
 
     #if (CONFIG_USING_FONT_FILE)
-        if (fnt_font->fname) {
-            do {
-                if (fnt_font->fd < 0) {
-                    LOG_E("no fd %s", fnt_font->fname);
-                    break;
-                }
-                if (lseek(fnt_font->fd, offset, SEEK_SET) < 0) {
-                    LOG_E("seek %s err", fnt_font->fname);
-                    break;
-                }
-                if (size != (rt_uint32_t)read(
-                    fnt_font->fd, fnt_font->data, size)) {
-                    LOG_E("read %s err", fnt_font->fname);
-                    break;
-                }
-            } while (0);
-            return fnt_font->data;
-        } else {
+        if (fnt_font->file.fname)
+            return rtgui_font_file_read(&fnt_font->file, offset,
+                fnt_font->width[code - font->start] * 2, fnt_font->data);
     #endif
 
-        return fnt_font->data + offset;
-
-    #if (CONFIG_USING_FONT_FILE)
-        }
-    #endif
+    return fnt_font->data + offset;
 }
 
 static rt_uint8_t fnt_font_draw_char(rtgui_font_t *font, rtgui_dc_t *dc,
     rt_uint16_t code, rtgui_rect_t *rect) {
-    rtgui_fnt_font_t *fnt_font;
-    rtgui_color_t bc;
-    rt_uint16_t style;
-    const rt_uint8_t *data;
-    rt_uint8_t fnt_w, w, h, oft, sft, col;
-
-    fnt_font = font->data;
-    bc = RTGUI_DC_BC(dc);
-    style = rtgui_dc_get_gc(dc)->textstyle;
-
-    if ((code < font->start) || (code > font->end)) {
-        code = font->dft;
-        LOG_D("used dft code %x", code);
-    }
-    data = _fnt_font_get_data(font, code);
+    rt_uint8_t mask[FNT_MASK_SIZE * FNT_MASK_SIZE / 8];
+    rt_uint8_t w, h;
 
-    fnt_w = fnt_font->width[code - font->start];
-    w = _MIN(RECT_W(*rect), fnt_w);
+    rt_memset(mask, 0x00, sizeof(mask));
+    w = fnt_font_get_mask(font, code, mask);
+    w = _MIN(RECT_W(*rect), w);
     h = _MIN(RECT_H(*rect), font->height);
-
-    for (col = 0, oft = 0; col < (w << 1); col++) {
-        /* draw half column */
-        for (sft = 0; sft < ((col > w) ? 4 : 8); sft++) {
-            rt_uint16_t y_off = ((col > w) ? (8 + sft) : sft);
-
-            if (y_off >= h) continue;
-            if (data[oft] & (1 << sft)) {
-                rtgui_dc_draw_point(dc, rect->x1 + (col % w), rect->y1 + y_off);
-            } else if (style & RTGUI_TEXTSTYLE_DRAW_BACKGROUND) {
-                rtgui_dc_draw_color_point(
-                    dc, rect->x1 + (col % w), rect->y1 + y_off, bc);
-            }
-        }
-
-        if ((w < fnt_w) && ((w - 1) == col)) {
-            oft += fnt_w - w + 1;
-        } else {
-            oft++;
-        }
-    }
+    rtgui_dc_draw_mono_mask(dc, rect->x1, rect->y1, w, h, mask, font->width);
 
     return w;
 }
@@ -256,4 +215,38 @@ static rt_uint8_t fnt_font_get_width(rtgui_font_t *font, const char *utf8) {
     return fnt_font->width[code - font->start];
 }
 
+static rt_uint8_t fnt_font_get_mask(rtgui_font_t *font, rt_uint16_t code,
+    rt_uint8_t *mask) {
+    rtgui_fnt_font_t *fnt_font;
+    const rt_uint8_t *data;
+    rt_uint16_t bits;
+    rt_uint32_t pos;
+    rt_uint8_t fnt_w, w, h, line, col;
+
+    fnt_font = font->data;
+
+    if ((code < font->start) || (code > font->end)) {
+        code = font->dft;
+        LOG_D("used dft code %x", code);
+    }
+    data = _fnt_font_get_data(font, code);
+
+    fnt_w = fnt_font->width[code - font->start];
+    w = _MIN(fnt_w, font->width);
+    h = _MIN(font->height, FNT_MASK_SIZE);
+
+    /* the upper 8 lines are in the first "fnt_w" bytes, one byte per column,
+       and the lower lines are in the next "fnt_w" bytes. Turn the columns into
+       rows of "font->width" bits. */
+    for (col = 0; col < w; col++) {
+        bits = data[col] | (data[fnt_w + col] << 8);
+        for (line = 0, pos = col; line < h; line++, pos += font->width) {
+            if (bits & (1 << line))
+                mask[pos >> 3] |= 0x80 >> (pos & 0x07);
+        }
+    }
+
+    return w;
+}
+
 /* Public functions ----------------------------------------------------------*/
@@ -56,6 +56,7 @@ struct rtgui_image_png {
     rt_uint8_t *pixels;
     rt_uint8_t pixel_format;
     rt_uint32_t pitch;
+    rt_bool_t has_alpha;        /* pixels are rtgui_color_t */
 };
 
 /* Private define ------------------------------------------------------------*/
@@ -122,6 +123,7 @@ static rt_bool_t png_load(rtgui_image_t *img, rtgui_filerw_t *file,
         png->file = file;
         png->in_size = 0;
         png->pixels = RT_NULL;
+        png->has_alpha = RT_FALSE;
 
         if (rtgui_filerw_seek(png->file, 0, SEEK_END) < 0) {
             err = -RT_EIO;
@@ -189,6 +191,16 @@ static rt_bool_t png_load(rtgui_image_t *img, rtgui_filerw_t *file,
                 err = -RT_EIO;
                 break;
             }
+            if (LCT_RGB == png->colorType) {
+                LodePNGState state;
+
+                /* keep alpha channel for blending */
+                lodepng_state_init(&state);
+                if (!lodepng_inspect(&w, &h, &state, buf, png->in_size) && \
+                    lodepng_is_alpha_type(&state.info_png.color))
+                    png->colorType = LCT_RGBA;
+                lodepng_state_cleanup(&state);
+            }
             ret = lodepng_decode_memory(&png->pixels, &w, &h, buf, png->in_size,
                 png->colorType, png->bitDepth);
             if (ret) {
@@ -233,6 +245,19 @@ static rt_bool_t png_load(rtgui_image_t *img, rtgui_filerw_t *file,
             }
             if (RT_EOK != err) break;
 
+            if (LCT_RGBA == png->colorType) {
+                rt_uint8_t *src = png->pixels;
+                rtgui_color_t *dst = (rtgui_color_t *)png->pixels;
+                rt_uint32_t i;
+
+                /* R, G, B, A bytes to rtgui_color_t in place */
+                for (i = 0; i < w * h; i++, src += 4)
+                    *dst++ = RTGUI_ARGB(src[3], src[0], src[1], src[2]);
+                png->pixel_format = RTGRAPHIC_PIXEL_FORMAT_ARGB888;
+                png->pitch = w << 2;
+                png->has_alpha = RT_TRUE;
+            }
+
             img->w = (rt_uint16_t)w;
             img->h = (rt_uint16_t)h;
             png->is_loaded = RT_TRUE;
@@ -287,6 +312,12 @@ static void png_blit(rtgui_image_t *img, rtgui_dc_t *dc, rtgui_rect_t *rect) {
         if (!png->is_loaded) {
             LOG_W("PNG is not loaded!");
             break;
+        } else if (png->has_alpha) {
+            rt_uint16_t y;
+
+            for (y = 0; y < h; y++)
+                rtgui_dc_blend_line(dc, rect->x1, rect->x1 + w, rect->y1 + y,
+                    (rtgui_color_t *)(png->pixels + y * png->pitch));
         } else {
             rt_uint16_t y;
             rt_uint8_t *ptr;
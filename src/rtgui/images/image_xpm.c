@@ -287,10 +287,10 @@ static rt_bool_t xpm_load(rtgui_image_t *img, rtgui_filerw_t *file,
 
             i += 2;
             if (xpm[idx][i] == '#')
-                c = RTGUI_ARGB(0, _hex2int(&xpm[idx][i + 1]),
+                c = RTGUI_RGB(_hex2int(&xpm[idx][i + 1]),
                     _hex2int(&xpm[idx][i + 3]), _hex2int(&xpm[idx][i + 5]));
             else /*if (!rt_strcasecmp(&xpm[idx][i], "None"))*/
-                c = RTGUI_RGB(0, 0, 0);
+                c = TRANSPARENT;
 
             /* add to palette */
             add_color_hash(palette, xpm[idx], name_sz, &c);
@@ -329,8 +329,7 @@ static void xpm_unload(rtgui_image_t *img) {
 }
 
 static void xpm_blit(rtgui_image_t *img, rtgui_dc_t *dc, rtgui_rect_t *rect) {
-    rt_uint16_t x, y, w, h;
-    rtgui_color_t *ptr;
+    rt_uint16_t y, w, h;
 
     if (!img || !dc || !rect || !img->data) return;
 
@@ -338,14 +337,10 @@ static void xpm_blit(rtgui_image_t *img, rtgui_dc_t *dc, rtgui_rect_t *rect) {
     w = _MIN(img->w, RECT_W(*rect));
     h = _MIN(img->h, RECT_H(*rect));
 
-    /* draw each point within dc */
-    for (y = 0; y < h; y ++) {
-        ptr = (rtgui_color_t *)img->data + img->w * y;
-        for (x = 0; x < w; x++, ptr++) {
-            if (RTGUI_RGB_A(*ptr) != 0xff)
-                rtgui_dc_draw_color_point(dc, rect->x1 + x, rect->y1 + y, *ptr);
-        }
-    }
+    /* "None" is transparent and skipped */
+    for (y = 0; y < h; y ++)
+        rtgui_dc_blend_line(dc, rect->x1, rect->x1 + w, rect->y1 + y,
+            (rtgui_color_t *)img->data + img->w * y);
 }
 
 /* Public functions ----------------------------------------------------------*/
@@ -0,0 +1,385 @@
+/*
+ * File      : memfb.c
+ * This file is part of RT-Thread GUI Engine
+ * COPYRIGHT (C) 2006 - 2017, RT-Thread Development Team
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2019-07-08     onelife      first version
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "include/rtgui.h"
+
+#if (CONFIG_USING_MEM_FB)
+
+#include "include/rthw.h" // rt_hw_interrupt_disable()
+
+#ifdef RT_USING_ULOG
+# define LOG_LVL                    RTGUI_LOG_LEVEL
+# define LOG_TAG                    "GUI_MFB"
+# include "components/utilities/ulog/ulog.h"
+#else /* RT_USING_ULOG */
+# define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_D                      LOG_E
+#endif /* RT_USING_ULOG */
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+#if (CONFIG_MEM_FB_BITS_PER_PIXEL == 1)
+# define MEM_FB_FORMAT              RTGRAPHIC_PIXEL_FORMAT_MONO
+# define MEM_FB_BITS                (1)
+# define MEM_FB_SIZE                \
+    (CONFIG_MEM_FB_WIDTH * ((CONFIG_MEM_FB_HEIGHT + 7) >> 3))
+#elif (CONFIG_MEM_FB_BITS_PER_PIXEL == 16)
+# define MEM_FB_FORMAT              RTGRAPHIC_PIXEL_FORMAT_RGB565
+# define MEM_FB_BITS                (16)
+#elif (CONFIG_MEM_FB_BITS_PER_PIXEL == 24)
+# define MEM_FB_FORMAT              RTGRAPHIC_PIXEL_FORMAT_RGB888
+# define MEM_FB_BITS                (RTGUI_RGB888_PIXEL_BITS)
+#else
+# error "Unsupported CONFIG_MEM_FB_BITS_PER_PIXEL"
+#endif
+#define MEM_FB_PITCH                (CONFIG_MEM_FB_WIDTH * _BIT2BYTE(MEM_FB_BITS))
+#ifndef MEM_FB_SIZE
+# define MEM_FB_SIZE                (MEM_FB_PITCH * CONFIG_MEM_FB_HEIGHT)
+#endif
+
+#define PIXEL(x, y)                 (_fb.buffer + MEM_FB_PITCH * (y) + \
+                                     _BIT2BYTE(MEM_FB_BITS) * (x))
+#define CLIP_X(x)                   \
+    (((x) < 0) ? 0 : (((x) > CONFIG_MEM_FB_WIDTH) ? CONFIG_MEM_FB_WIDTH : (x)))
+#define CLIP_Y(y)                   \
+    (((y) < 0) ? 0 : (((y) > CONFIG_MEM_FB_HEIGHT) ? CONFIG_MEM_FB_HEIGHT : (y)))
+#define IS_OUTSIDE(x, y)            (((x) < 0) || ((y) < 0) || \
+                                     ((x) >= CONFIG_MEM_FB_WIDTH) || \
+                                     ((y) >= CONFIG_MEM_FB_HEIGHT))
+
+/* Private function prototypes -----------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+static struct rtgui_mem_fb {
+    struct rt_device parent;
+    rt_uint8_t *buffer;
+    rtgui_mem_fb_stat_t stat;
+} _fb;
+
+/* Private functions ---------------------------------------------------------*/
+/* All the pixel operations below take native pixel values (already converted
+   by driver.c) and treat x2 / y2 as exclusive, the same as the framebuffer
+   operations in driver.c. */
+
+#if (MEM_FB_BITS == 1)
+/* same page layout as "_frame_mono_ops" */
+#define PAGE(x, y)                  (&_fb.buffer[((y) >> 3) * \
+                                     CONFIG_MEM_FB_WIDTH + (x)])
+
+static void _mem_fb_set_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) return;
+    if (*c)
+        *PAGE(x, y) |=  (1 << (y & 0x07));
+    else
+        *PAGE(x, y) &= ~(1 << (y & 0x07));
+}
+
+static void _mem_fb_get_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) {
+        *c = 0;
+        return;
+    }
+    *c = (*PAGE(x, y) & (1 << (y & 0x07))) ? 1 : 0;
+}
+
+static void _mem_fb_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    int x;
+
+    if ((y < 0) || (y >= CONFIG_MEM_FB_HEIGHT)) return;
+    x2 = CLIP_X(x2);
+    for (x = CLIP_X(x1); x < x2; x++)
+        _mem_fb_set_pixel(c, x, y);
+}
+
+static void _mem_fb_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    int y;
+
+    if ((x < 0) || (x >= CONFIG_MEM_FB_WIDTH)) return;
+    y2 = CLIP_Y(y2);
+    for (y = CLIP_Y(y1); y < y2; y++)
+        _mem_fb_set_pixel(c, x, y);
+}
+
+static void _mem_fb_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2,
+    int y) {
+    rtgui_color_t pixel;
+    int i;
+
+    for (i = 0; i < (x2 - x1); i++) {
+        pixel = (pixels[i >> 3] & (1 << (i & 0x07))) ? 1 : 0;
+        _mem_fb_set_pixel(&pixel, x1 + i, y);
+    }
+}
+
+static void _mem_fb_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    y2 = CLIP_Y(y2);
+    for (y1 = CLIP_Y(y1); y1 < y2; y1++)
+        _mem_fb_draw_hline(c, x1, x2, y1);
+}
+
+#undef PAGE
+
+#else /* MEM_FB_BITS == 1 */
+
+rt_inline void _mem_fb_put(rt_uint8_t *ptr, rtgui_color_t pixel) {
+    #if (MEM_FB_BITS == 16)
+        *(rt_uint16_t *)ptr = (rt_uint16_t)pixel;
+    #elif (MEM_FB_BITS == 32)
+        *(rtgui_color_t *)ptr = pixel;
+    #else
+        ptr[0] = (pixel >> 16) & 0xff;
+        ptr[1] = (pixel >> 8) & 0xff;
+        ptr[2] = pixel & 0xff;
+    #endif
+}
+
+static void _mem_fb_set_pixel(rtgui_color_t *c, int x, int y) {
+    if (IS_OUTSIDE(x, y)) return;
+    _mem_fb_put(PIXEL(x, y), *c);
+}
+
+static void _mem_fb_get_pixel(rtgui_color_t *c, int x, int y) {
+    rt_uint8_t *ptr;
+
+    if (IS_OUTSIDE(x, y)) {
+        *c = 0;
+        return;
+    }
+    ptr = PIXEL(x, y);
+
+    #if (MEM_FB_BITS == 16)
+        /* "_rgb565_get_pixel()" expects rtgui color */
+        {
+            rt_uint16_t pixel = *(rt_uint16_t *)ptr;
+
+            #ifdef RTGUI_BIG_ENDIAN_OUTPUT
+                pixel = (pixel << 8) | (pixel >> 8);
+            #endif
+            *c = rtgui_color_from_565(pixel);
+        }
+    #elif (MEM_FB_BITS == 32)
+        *c = *(rtgui_color_t *)ptr;
+    #else
+        *c = (ptr[0] << 16) | (ptr[1] << 8) | ptr[2];
+    #endif
+}
+
+static void _mem_fb_draw_hline(rtgui_color_t *c, int x1, int x2, int y) {
+    rt_uint8_t *ptr;
+    int x;
+
+    if ((y < 0) || (y >= CONFIG_MEM_FB_HEIGHT)) return;
+    x1 = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    ptr = PIXEL(x1, y);
+    for (x = x1; x < x2; x++, ptr += _BIT2BYTE(MEM_FB_BITS))
+        _mem_fb_put(ptr, *c);
+}
+
+static void _mem_fb_draw_vline(rtgui_color_t *c, int x, int y1, int y2) {
+    rt_uint8_t *ptr;
+    int y;
+
+    if ((x < 0) || (x >= CONFIG_MEM_FB_WIDTH)) return;
+    y1 = CLIP_Y(y1);
+    y2 = CLIP_Y(y2);
+    ptr = PIXEL(x, y1);
+    for (y = y1; y < y2; y++, ptr += MEM_FB_PITCH)
+        _mem_fb_put(ptr, *c);
+}
+
+static void _mem_fb_draw_raw_hline(rt_uint8_t *pixels, int x1, int x2,
+    int y) {
+    int x;
+
+    if ((y < 0) || (y >= CONFIG_MEM_FB_HEIGHT)) return;
+    x = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    if (x2 <= x) return;
+    rt_memcpy(PIXEL(x, y), pixels + (x - x1) * _BIT2BYTE(MEM_FB_BITS),
+        (x2 - x) * _BIT2BYTE(MEM_FB_BITS));
+}
+
+static void _mem_fb_fill_rect(rtgui_color_t *c, int x1, int y1, int x2,
+    int y2) {
+    rt_uint8_t *src;
+    int y;
+
+    x1 = CLIP_X(x1);
+    x2 = CLIP_X(x2);
+    y1 = CLIP_Y(y1);
+    y2 = CLIP_Y(y2);
+    if ((x1 >= x2) || (y1 >= y2)) return;
+
+    /* fill the first row then copy it, like a panel burst write */
+    _mem_fb_draw_hline(c, x1, x2, y1);
+    src = PIXEL(x1, y1);
+    for (y = y1 + 1; y < y2; y++)
+        rt_memcpy(PIXEL(x1, y), src, (x2 - x1) * _BIT2BYTE(MEM_FB_BITS));
+}
+
+#endif /* MEM_FB_BITS == 1 */
+
+static const struct rtgui_graphic_driver_ops _mem_fb_ops = {
+    _mem_fb_set_pixel,
+    _mem_fb_get_pixel,
+    _mem_fb_draw_hline,
+    _mem_fb_draw_vline,
+    _mem_fb_draw_raw_hline,
+};
+
+static const struct rtgui_graphic_ext_ops _mem_fb_ext_ops = {
+    RT_NULL,
+    RT_NULL,
+    _mem_fb_fill_rect,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+};
+
+static rt_err_t _mem_fb_open(rt_device_t dev, rt_uint16_t oflag) {
+    (void)oflag;
+    if (!_fb.buffer) {
+        _fb.buffer = rtgui_malloc(MEM_FB_SIZE);
+        if (!_fb.buffer) {
+            LOG_E("no mem");
+            return -RT_ENOMEM;
+        }
+        rt_memset(_fb.buffer, 0x00, MEM_FB_SIZE);
+    }
+    return RT_EOK;
+}
+
+static rt_err_t _mem_fb_close(rt_device_t dev) {
+    /* keep the buffer until unregister for inspection */
+    (void)dev;
+    return RT_EOK;
+}
+
+static rt_err_t _mem_fb_control(rt_device_t dev, int cmd, void *args) {
+    rt_err_t ret = RT_EOK;
+
+    switch (cmd) {
+    case RTGRAPHIC_CTRL_GET_INFO:
+    {
+        struct rt_device_graphic_info *info = args;
+
+        info->pixel_format = MEM_FB_FORMAT;
+        info->bits_per_pixel = MEM_FB_BITS;
+        info->width = CONFIG_MEM_FB_WIDTH;
+        info->height = CONFIG_MEM_FB_HEIGHT;
+        info->framebuffer = _fb.buffer;
+        break;
+    }
+
+    case RTGRAPHIC_CTRL_RECT_UPDATE:
+    {
+        struct rt_device_rect_info *rect = args;
+
+        _fb.stat.update_count++;
+        _fb.stat.update_pixels += rect->width * rect->height;
+        break;
+    }
+
+    case RTGRAPHIC_CTRL_GET_EXT:
+        *(const struct rtgui_graphic_ext_ops **)args = &_mem_fb_ext_ops;
+        break;
+
+    case RTGRAPHIC_CTRL_POWERON:
+    case RTGRAPHIC_CTRL_POWEROFF:
+        break;
+
+    default:
+        ret = -RT_ERROR;
+        break;
+    }
+
+    return ret;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops _mem_fb_dev_ops = {
+    RT_NULL,
+    _mem_fb_open,
+    _mem_fb_close,
+    RT_NULL,
+    RT_NULL,
+    _mem_fb_control,
+};
+#endif
+
+/* Public functions ----------------------------------------------------------*/
+rt_err_t rtgui_mem_fb_init(void) {
+    rt_device_t dev = &_fb.parent;
+
+    if (rt_device_find(RTGUI_MEM_FB_NAME)) return RT_EOK;
+
+    rt_memset(&_fb, 0x00, sizeof(_fb));
+    dev->type = RT_Device_Class_Graphic;
+    #ifdef RT_USING_DEVICE_OPS
+        dev->ops = &_mem_fb_dev_ops;
+    #else
+        dev->init = RT_NULL;
+        dev->open = _mem_fb_open;
+        dev->close = _mem_fb_close;
+        dev->read = RT_NULL;
+        dev->write = RT_NULL;
+        dev->control = _mem_fb_control;
+    #endif
+    dev->user_data = (void *)&_mem_fb_ops;
+
+    return rt_device_register(dev, RTGUI_MEM_FB_NAME, RT_DEVICE_FLAG_RDWR);
+}
+RTM_EXPORT(rtgui_mem_fb_init);
+
+rt_uint8_t *rtgui_mem_fb_get_buffer(void) {
+    return _fb.buffer;
+}
+RTM_EXPORT(rtgui_mem_fb_get_buffer);
+
+void rtgui_mem_fb_get_stat(rtgui_mem_fb_stat_t *stat, rt_bool_t reset) {
+    rt_base_t level = rt_hw_interrupt_disable();
+
+    if (stat) *stat = _fb.stat;
+    if (reset) rt_memset(&_fb.stat, 0x00, sizeof(_fb.stat));
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rtgui_mem_fb_get_stat);
+
+#ifdef RT_USING_FINSH
+# include "components/finsh/finsh.h"
+
+void list_memfb(void) {
+    rtgui_mem_fb_stat_t stat;
+
+    rtgui_mem_fb_get_stat(&stat, RT_FALSE);
+    rt_kprintf("%dx%d @%dbpp, Updates: %d, Pixels: %d\n",
+        CONFIG_MEM_FB_WIDTH, CONFIG_MEM_FB_HEIGHT, MEM_FB_BITS,
+        stat.update_count, stat.update_pixels);
+}
+FINSH_FUNCTION_EXPORT(list_memfb, display memory framebuffer information);
+#endif /* RT_USING_FINSH */
+
+#endif /* CONFIG_USING_MEM_FB */
@@ -31,6 +31,7 @@
 # include "components/utilities/ulog/ulog.h"
 #else /* RT_USING_ULOG */
 # define LOG_E(format, args...)     rt_kprintf(format "\n", ##args)
+# define LOG_W                      LOG_E
 # define LOG_D                      LOG_E
 #endif /* RT_USING_ULOG */
 
@@ -681,16 +682,16 @@ static r_op_status_t region_op(
         _find_next(r1, r1_stop, end1, r1_start_y1);
 
         /* get space top */
-        top = _MAX(r1_start_y1, top_y + 1);
+        top = _MAX(r1_start_y1, top_y);
         // LOG_D("op b1 %d %d", top, r1->y2);
         if (top < r1->y2) {
             /* has space */
             curStart = dstRgn->data->numRects;
             _expend_verticaly(dstRgn, r1, r1_stop, top, r1->y2);
             coalesce(dstRgn, prvStart, curStart);
-            /* append the rest */
-            _append_rects(dstRgn, r1_stop, end1);
         }
+        /* append the rest */
+        _append_rects(dstRgn, r1_stop, end1);
     } else if ((r2 != end2) && merge_b2) {
         rt_int16_t top;
 
@@ -702,9 +703,9 @@ static r_op_status_t region_op(
             curStart = dstRgn->data->numRects;
             _expend_verticaly(dstRgn, r2, r2_stop, top, r2->y2);
             coalesce(dstRgn, prvStart, curStart);
-            /* append the rest */
-            _append_rects(dstRgn, r2_stop, end2);
         }
+        /* append the rest */
+        _append_rects(dstRgn, r2_stop, end2);
     }
 
     if (backup)
@@ -1196,15 +1197,15 @@ static void _quick_sort_rects(rtgui_rect_t rects[], rt_uint32_t num) {
         do {
             do {
                 i++;
-                if (!((rects[i].y1 < y1) || \
-                      ((rects[i].y1 == y1) && (rects[i].x1 < x1))))
+                if ((i == num) || !((rects[i].y1 < y1) || \
+                    ((rects[i].y1 == y1) && (rects[i].x1 < x1))))
                     break;
-            } while (i < num);
+            } while (1);
 
             do {
                 j--;
-                if (!((rects[i].y1 > y1) || \
-                      ((rects[i].y1 == y1) && (rects[i].x1 > x1))))
+                if (!((rects[j].y1 > y1) || \
+                      ((rects[j].y1 == y1) && (rects[j].x1 > x1))))
                     break;
             } while (1);
 
@@ -1481,7 +1482,7 @@ static r_op_status_t _subtract_func(
     x = r1->x1;
 
     do {
-        if (r2->x2 < x) {
+        if (r2->x2 <= x) {
             /*
              * Subtrahend entirely to left of minuend: go to next subtrahend.
              */
@@ -1490,7 +1491,7 @@ static r_op_status_t _subtract_func(
             /*
              * Subtrahend preceeds minuend: nuke left edge of minuend.
              */
-            x = r2->x2 + 1;
+            x = r2->x2;
             if (x >= r1->x2) {
                 /*
                  * Minuend completely covered: advance to next minuend and
@@ -1506,15 +1507,15 @@ static r_op_status_t _subtract_func(
                  */
                 r2++;
             }
-        } else if (r2->x1 <= r1->x2) {
+        } else if (r2->x1 < r1->x2) {
             /*
              * Left part of subtrahend covers part of minuend: add uncovered
              * part of minuend to region and skip to next subtrahend.
              */
             RT_ASSERT(r2->x1 > x);
-            _append_new_rect(rgn, end, x, y1, r2->x1 - 1, y2);
+            _append_new_rect(rgn, end, x, y1, r2->x1, y2);
 
-            x = r2->x2 + 1;
+            x = r2->x2;
             if (x >= r1->x2) {
                 /*
                  * Minuend used up: advance to new...
@@ -1612,9 +1613,10 @@ r_op_status_t rtgui_region_subtract(rtgui_region_t *regD, rtgui_region_t *regM,
        do yucky substraction for overlaps, and
        just throw away rectangles in region 2 that aren't in region 1 */
     if (PASS != region_op(regD, regM, regS, _subtract_func, RT_TRUE,
-        RT_FALSE, &notUsed))
+        RT_FALSE, &notUsed)) {
         LOG_W("_subtract_func err");
         return FAIL;
+    }
 
     /*
      * Can't alter RegD's extents before we call region_op because
@@ -2017,6 +2019,73 @@ rt_bool_t rtgui_region_is_flat(rtgui_region_t *rgn) {
 }
 RTM_EXPORT(rtgui_region_is_flat);
 
+static rt_uint32_t _band_size(rtgui_rect_t *rects, rt_uint32_t idx,
+    rt_uint32_t num) {
+    rt_uint32_t end;
+
+    for (end = idx + 1; end < num; end++)
+        if (rects[end].y1 != rects[idx].y1) break;
+    return end - idx;
+}
+
+/* find the first band below "y" (band.y2 > y), return rects in the band or 0
+   if none. The band contains "y" only if its y1 <= y. */
+rt_uint32_t rtgui_region_find_band(rtgui_region_t *rgn, int y,
+    rtgui_region_band_t *band) {
+    rtgui_rect_t *rects;
+    rt_uint32_t num, lo, hi, mid;
+
+    GOOD(rgn);
+    num = REGION_DATA_NUM_RECTS(rgn);
+    rects = REGION_GET_RECTS(rgn);
+
+    /* try the hint and the band after it, if the hint is still a band */
+    if (band->num && ((band->idx + band->num) <= num)) {
+        rtgui_rect_t *first = &rects[band->idx];
+        rt_uint32_t end = band->idx + band->num;
+
+        if ((rects[end - 1].y1 == first->y1) && \
+            (!band->idx || ((first - 1)->y1 != first->y1)) && \
+            ((end == num) || (rects[end].y1 != first->y1))) {
+            if (y < first->y2) {
+                if (!band->idx || (y >= (first - 1)->y2))
+                    return band->num;
+            } else if ((end < num) && (y < rects[end].y2)) {
+                band->idx = end;
+                band->num = _band_size(rects, end, num);
+                return band->num;
+            }
+        }
+    }
+
+    /* y2 is non-decreasing, search the first rect with y2 > y */
+    for (lo = 0, hi = num; lo < hi; ) {
+        mid = (lo + hi) >> 1;
+        if (rects[mid].y2 <= y)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    band->idx = lo;
+    band->num = (lo < num) ? _band_size(rects, lo, num) : 0;
+    return band->num;
+}
+RTM_EXPORT(rtgui_region_find_band);
+
+/* move to the next band, return rects in the band or 0 if none */
+rt_uint32_t rtgui_region_next_band(rtgui_region_t *rgn,
+    rtgui_region_band_t *band) {
+    rt_uint32_t num;
+
+    GOOD(rgn);
+    num = REGION_DATA_NUM_RECTS(rgn);
+    band->idx += band->num;
+    band->num = (band->idx < num) ? \
+        _band_size(REGION_GET_RECTS(rgn), band->idx, num) : 0;
+    return band->num;
+}
+RTM_EXPORT(rtgui_region_next_band);
+
 void rtgui_rect_move(rtgui_rect_t *rect, int x, int y) {
     rect->x1 += x;
     rect->x2 += x;
@@ -2154,7 +2223,7 @@ RTM_EXPORT(rtgui_rect_is_equal);
 
 rt_bool_t rtgui_rect_is_empty(const rtgui_rect_t *rect)
 {
-    if (rtgui_rect_is_equal(rect, &_null_rect) == RT_EOK) return RT_TRUE;
+    if (rtgui_rect_is_equal(rect, &_null_rect)) return RT_TRUE;
     return RT_FALSE;
 }
 RTM_EXPORT(rtgui_rect_is_empty);
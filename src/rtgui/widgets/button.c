@@ -299,22 +299,22 @@ static void _theme_draw_button(rtgui_button_t *btn) {
                 /* draw disable text */
                 WIDGET_FOREGROUND(btn) = white;
                 rtgui_rect_move(&rect, 1, 1);
-                rtgui_dc_draw_text(dc,
+                rtgui_dc_draw_text_layout(dc,
                     MEMBER_GETTER(label, text)(TO_LABEL(btn)),
-                    &rect);
+                    &TO_LABEL(btn)->layout, &rect);
 
                 WIDGET_FOREGROUND(btn) = dark_grey;
                 rtgui_rect_move(&rect, -1, -1);
-                rtgui_dc_draw_text(dc,
+                rtgui_dc_draw_text_layout(dc,
                      MEMBER_GETTER(label, text)(TO_LABEL(btn)),
-                     &rect);
+                     &TO_LABEL(btn)->layout, &rect);
 
                 WIDGET_FOREGROUND(btn) = fc;
             } else {
                 /* draw text */
-                rtgui_dc_draw_text(dc,
+                rtgui_dc_draw_text_layout(dc,
                     MEMBER_GETTER(label, text)(TO_LABEL(btn)),
-                    &rect);
+                    &TO_LABEL(btn)->layout, &rect);
             }
         }
 
@@ -62,6 +62,7 @@ static void _label_constructor(void *obj) {
 
     WIDGET_TEXTALIGN(lab) = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_CENTER_VERTICAL;
     lab->text = RT_NULL;
+    rt_memset(&lab->layout, 0x00, sizeof(lab->layout));
 }
 
 static void _label_destructor(void *obj) {
@@ -69,6 +70,7 @@ static void _label_destructor(void *obj) {
 
     if (lab->text) rtgui_free(lab->text);
     lab->text = RT_NULL;
+    rtgui_text_layout_free(&lab->layout);
 }
 
 static rt_bool_t _label_event_handler(void *obj, rtgui_evt_generic_t *evt) {
@@ -109,7 +111,8 @@ static void _theme_draw_label(rtgui_label_t *lab) {
         LOG_D("draw label (%d,%d)-(%d,%d)", rect.x1, rect.y1, rect.x2,
             rect.y2);
         rtgui_dc_fill_rect(dc, &rect);
-        rtgui_dc_draw_text(dc, LABEL_GETTER(text)(lab), &rect);
+        rtgui_dc_draw_text_layout(dc, LABEL_GETTER(text)(lab), &lab->layout,
+            &rect);
 
         rtgui_dc_end_drawing(dc, RT_TRUE);
         LOG_D("draw label done");
@@ -121,7 +124,11 @@ rt_err_t *rtgui_label_init(rtgui_label_t *lab, const char *text) {
     rtgui_rect_t rect;
 
     /* set min size */
-    rtgui_font_get_metrics(rtgui_font_default(), text, &rect);
+    if (RT_EOK == rtgui_text_layout_build(&lab->layout, rtgui_font_default(),
+        text))
+        rtgui_text_layout_get_metrics(&lab->layout, &rect);
+    else
+        rtgui_font_get_metrics(rtgui_font_default(), text, &rect);
     TO_WIDGET(lab)->min_width  = RECT_W(rect);
     TO_WIDGET(lab)->min_height = RECT_H(rect);
     /* set text */
@@ -161,6 +168,8 @@ void rtgui_label_set_text(rtgui_label_t *lab, const char *text) {
 
     if (text)
         lab->text = rt_strdup(text);
+    /* decode again at next drawing */
+    rtgui_text_layout_free(&lab->layout);
 
     /* update widget */
     rtgui_widget_update(TO_WIDGET(lab));
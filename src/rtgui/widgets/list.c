@@ -24,6 +24,7 @@
  */
 /* Includes ------------------------------------------------------------------*/
 #include "include/rtgui.h"
+#include "include/font/font.h"
 #include "include/image.h"
 #include "include/widgets/container.h"
 #include "include/widgets/list.h"
@@ -44,6 +45,7 @@
 
 /* Private function prototype ------------------------------------------------*/
 static void _list_constructor(void *obj);
+static void _list_destructor(void *obj);
 static rt_bool_t _list_event_handler(void *obj, rtgui_evt_generic_t *evt);
 static rt_bool_t _list_on_unfocus(void *obj, rtgui_evt_generic_t *evt);
 
@@ -54,7 +56,7 @@ RTGUI_CLASS(
     list,
     CLASS_METADATA(widget),
     _list_constructor,
-    RT_NULL,
+    _list_destructor,
     _list_event_handler,
     sizeof(rtgui_list_t));
 
@@ -69,12 +71,28 @@ static void _list_constructor(void *obj) {
     WIDGET_SETTER(on_unfocus)(TO_WIDGET(obj), _list_on_unfocus);
 
     list->items = RT_NULL;
+    list->layouts = RT_NULL;
     list->page_sz = 1;
     list->count = 0;
+    list->top = 0;
     list->current = -1;
     list->on_item = RT_NULL;
 }
 
+static void _list_free_layouts(rtgui_list_t *list) {
+    rt_uint16_t idx;
+
+    if (!list->layouts) return;
+    for (idx = 0; idx < list->count; idx++)
+        rtgui_text_layout_free(&list->layouts[idx]);
+    rtgui_free(list->layouts);
+    list->layouts = RT_NULL;
+}
+
+static void _list_destructor(void *obj) {
+    _list_free_layouts(obj);
+}
+
 static rt_bool_t _list_on_unfocus(void *obj, rtgui_evt_generic_t *evt) {
     rtgui_widget_t *wgt = obj;
     (void)evt;
@@ -102,8 +120,9 @@ static rt_bool_t _list_on_unfocus(void *obj, rtgui_evt_generic_t *evt) {
     return RT_TRUE;
 }
 
-static void _list_draw_item(rtgui_dc_t *dc, const rtgui_list_item_t *item,
-    rtgui_rect_t *rect) {
+static void _list_draw_item(rtgui_dc_t *dc, rtgui_list_t *list,
+    rt_int32_t idx, rtgui_rect_t *rect) {
+    const rtgui_list_item_t *item = &list->items[idx];
     rtgui_rect_t img_rect;
 
     /* offset row margin */
@@ -115,7 +134,10 @@ static void _list_draw_item(rtgui_dc_t *dc, const rtgui_list_item_t *item,
         /* offset column margin */
         rect->x1 += item->image->w + COLUMN_MARGIN;
     }
-    rtgui_dc_draw_text(dc, item->name, rect);
+    if (list->layouts)
+        rtgui_dc_draw_text_layout(dc, item->name, &list->layouts[idx], rect);
+    else
+        rtgui_dc_draw_text(dc, item->name, rect);
 
     /* reset rect */
     if (item->image)
@@ -131,10 +153,7 @@ static void _list_draw(void *obj) {
     rtgui_dc_t *dc;
     rtgui_rect_t rect;
 
-    if (list->current < 0)
-        idx = 0;
-    else
-        idx = list->current - (list->current % list->page_sz);
+    idx = list->top;
     end = _MIN(idx + list->page_sz + 1, list->count - 1);
     LOG_D("idx %d end %d", idx, end);
 
@@ -158,7 +177,7 @@ static void _list_draw(void *obj) {
     for (; idx <= end; idx++) {
         if (idx == list->current)
             _theme_draw_selected(dc, &rect);
-        _list_draw_item(dc, &list->items[idx], &rect);
+        _list_draw_item(dc, list, idx, &rect);
         rect.y1 += item_h;
         rect.y2 += item_h;
     }
@@ -166,37 +185,99 @@ static void _list_draw(void *obj) {
     rtgui_dc_end_drawing(dc, RT_TRUE);
 }
 
+/* draw the row of item "idx" (or background if no such item) */
+static void _list_draw_row(rtgui_dc_t *dc, rtgui_list_t *list,
+    rtgui_rect_t *inner, rt_int32_t idx) {
+    rt_uint16_t item_h = _theme_selected_item_height() + ROW_MARGIN;
+    rtgui_rect_t item_rect, fill;
+
+    item_rect.x1 = inner->x1;
+    item_rect.x2 = inner->x2;
+    item_rect.y1 = inner->y1 + (idx - list->top) * item_h;
+    item_rect.y2 = item_rect.y1 + item_h;
+
+    if (idx == list->current) {
+        _theme_draw_selected(dc, &item_rect);
+    } else {
+        /* keep the border */
+        fill = item_rect;
+        rtgui_rect_intersect(inner, &fill);
+        if (fill.y1 < fill.y2)
+            rtgui_dc_fill_rect(dc, &fill);
+    }
+    if (idx < list->count)
+        _list_draw_item(dc, list, idx, &item_rect);
+}
+
+/* scroll by one row, then redraw the exposed rows and the selection */
+static rt_bool_t _list_scroll(rtgui_dc_t *dc, rtgui_list_t *list,
+    rtgui_rect_t *inner, rt_int32_t last_idx, rt_bool_t up) {
+    rt_uint16_t item_h = _theme_selected_item_height() + ROW_MARGIN;
+    rtgui_region_t exposed;
+    rtgui_rect_t *ext;
+    rt_int32_t idx, y;
+
+    rtgui_region_init_empty(&exposed);
+    if (!rtgui_dc_scroll_area(dc, inner, 0, up ? item_h : -item_h,
+        &exposed)) {
+        rtgui_region_uninit(&exposed);
+        return RT_FALSE;
+    }
+    if (up)
+        list->top--;
+    else
+        list->top++;
+
+    ext = rtgui_region_extents(&exposed);
+    for (idx = list->top; idx <= list->top + list->page_sz + 1; idx++) {
+        y = inner->y1 + (idx - list->top) * item_h;
+        if (y >= inner->y2) break;
+        if (((y < ext->y2) && ((y + item_h) > ext->y1)) || \
+            (idx == last_idx) || (idx == list->current))
+            _list_draw_row(dc, list, inner, idx);
+    }
+    rtgui_region_uninit(&exposed);
+
+    return RT_TRUE;
+}
+
 static void _list_draw_current_item(rtgui_dc_t *dc, void *obj,
     rt_int32_t last_idx) {
-    rt_uint16_t item_h = _theme_selected_item_height() + ROW_MARGIN;
     rtgui_list_t *list = obj;
     rtgui_widget_t *wgt = obj;
-    rtgui_rect_t rect, item_rect;
+    rtgui_rect_t rect;
 
     if (last_idx < 0)
         last_idx = 0;
 
-    /* if not in same page then update all */
-    if ((last_idx / list->page_sz) != (list->current / list->page_sz))
-        return rtgui_widget_update(wgt);
-
     rtgui_widget_get_rect(wgt, &rect);
-    /* last item rect */
-    item_rect.x1 = rect.x1 + 1;
-    item_rect.x2 = rect.x2 - 1;
-    item_rect.y1 = rect.y1 + ROW_MARGIN + (last_idx % list->page_sz) * item_h;
-    item_rect.y2 = item_rect.y1 + item_h;
-    /* unfocuse last item */
-    rtgui_dc_fill_rect(dc, &item_rect);
-    _list_draw_item(dc, &list->items[last_idx], &item_rect);
+    rect.x1 += 1;
+    rect.x2 -= 1;
+    rect.y1 += ROW_MARGIN;
+    rect.y2 -= 1;
+
+    if ((list->current >= list->top) && \
+        (list->current < list->top + list->page_sz)) {
+        /* unfocuse last item */
+        if ((last_idx >= list->top) && \
+            (last_idx < list->top + list->page_sz))
+            _list_draw_row(dc, list, &rect, last_idx);
+        /* focuse current item */
+        _list_draw_row(dc, list, &rect, list->current);
+        return;
+    }
 
-    /* current item rect */
-    item_rect.y1 = rect.y1 + ROW_MARGIN + \
-                   (list->current % list->page_sz) * item_h;
-    item_rect.y2 = item_rect.y1 + item_h;
-    /* focuse current item */
-    _theme_draw_selected(dc, &item_rect);
-    _list_draw_item(dc, &list->items[list->current], &item_rect);
+    /* one row off the page: move the drawn rows instead of repainting */
+    if ((list->current == list->top - 1) && \
+        _list_scroll(dc, list, &rect, last_idx, RT_TRUE))
+        return;
+    if ((list->current == list->top + list->page_sz) && \
+        _list_scroll(dc, list, &rect, last_idx, RT_FALSE))
+        return;
+
+    /* else update all */
+    list->top = list->current - (list->current % list->page_sz);
+    rtgui_widget_update(wgt);
 }
 
 static rt_bool_t _list_event_handler(void *obj, rtgui_evt_generic_t *evt) {
@@ -254,8 +335,7 @@ static rt_bool_t _list_event_handler(void *obj, rtgui_evt_generic_t *evt) {
         if ((idx < list->count) && (idx <= list->page_sz)) {
             if (IS_MOUSE_EVENT_BUTTON(evt, DOWN)) {
                 rt_int32_t last_idx = list->current;
-                rt_int32_t new_idx = list->current - \
-                                     (list->current % list->page_sz) + idx;
+                rt_int32_t new_idx = list->top + idx;
                 if (new_idx < list->count) {
                     list->current = new_idx;
                     LOG_D("current -> %d", list->current);
@@ -337,8 +417,17 @@ static void _list_set_items(rtgui_list_t *list, rtgui_list_item_t *items,
     list->page_sz = RECT_H(rect) / item_h;
     if (!list->page_sz)
         list->page_sz = 1;
+    /* the names are decoded at drawing, without memory just draw text */
+    _list_free_layouts(list);
+    if (items && count) {
+        list->layouts = rtgui_malloc(sizeof(rtgui_text_layout_t) * count);
+        if (list->layouts)
+            rt_memset(list->layouts, 0x00,
+                sizeof(rtgui_text_layout_t) * count);
+    }
     list->items = items;
     list->count = count;
+    list->top = 0;
 }
 
 /* Public functions ----------------------------------------------------------*/
@@ -391,6 +480,19 @@ void rtgui_list_set_current(rtgui_list_t *list, rt_int32_t idx) {
 }
 RTM_EXPORT(rtgui_list_set_current);
 
+/* the name or image of item "idx" has been changed in place */
+void rtgui_list_item_changed(rtgui_list_t *list, rt_int32_t idx) {
+    if ((idx < 0) || (idx >= list->count))
+        return;
+
+    /* decode the new name at next drawing */
+    if (list->layouts)
+        rtgui_text_layout_free(&list->layouts[idx]);
+    if ((idx >= list->top) && (idx < list->top + list->page_sz))
+        rtgui_widget_update(TO_WIDGET(list));
+}
+RTM_EXPORT(rtgui_list_item_changed);
+
 RTGUI_MEMBER_SETTER(rtgui_list_t, list, rtgui_evt_hdl_t, on_item);
 
 void _theme_draw_selected(rtgui_dc_t *dc, rtgui_rect_t *rect) {
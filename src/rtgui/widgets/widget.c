@@ -80,7 +80,9 @@ static void _widget_constructor(void *obj) {
     wgt->gc.background = default_background;
     wgt->gc.textstyle = RTGUI_TEXTSTYLE_NORMAL;
     wgt->gc.textalign = RTGUI_ALIGN_LEFT | RTGUI_ALIGN_TOP;
+    wgt->gc.drawstyle = RTGUI_DRAWSTYLE_NORMAL;
     wgt->gc.font = rtgui_font_default();
+    rtgui_gc_invalidate(&wgt->gc);
     rtgui_dc_client_init(wgt);
 
     wgt->user_data = 0;
@@ -567,12 +569,77 @@ void rtgui_widget_update(rtgui_widget_t *wgt) {
         RTGUI_CREATE_EVENT(evt, PAINT, RT_WAITING_FOREVER);
         if (!evt) break;
         evt->paint.wid = RT_NULL;
+
+        #ifdef RTGUI_USING_STRIP
+        {
+            rtgui_region_t clip;
+            rt_bool_t done;
+
+            rtgui_region_init_with_extent(&clip, &wgt->extent);
+            if (wgt->toplevel)
+                rtgui_region_intersect(&clip, &clip,
+                    &wgt->toplevel->outer_clip);
+            done = rtgui_widget_strip_paint(wgt, &clip, evt);
+            rtgui_region_uninit(&clip);
+            if (done) {
+                RTGUI_FREE_EVENT(evt);
+                break;
+            }
+        }
+        #endif
+
         (void)EVENT_HANDLER(wgt)(wgt, evt);
         RTGUI_FREE_EVENT(evt);
     } while (0);
 }
 RTM_EXPORT(rtgui_widget_update);
 
+#ifdef RTGUI_USING_STRIP
+/* send UPDATE_BEGIN or UPDATE_END of "rect" to server */
+static void _strip_send_update(rtgui_rect_t *rect, rt_bool_t end) {
+    rtgui_evt_generic_t *evt;
+
+    if (end) {
+        RTGUI_CREATE_EVENT(evt, UPDATE_END, RT_WAITING_FOREVER);
+        if (!evt) return;
+        evt->update_end.rect = *rect;
+    } else {
+        RTGUI_CREATE_EVENT(evt, UPDATE_BEGIN, RT_WAITING_FOREVER);
+        if (!evt) return;
+        evt->update_begin.rect = *rect;
+    }
+    (void)rtgui_send_request(evt, RT_WAITING_FOREVER);
+}
+
+/* replay "evt" to "wgt" band by band over the damaged "clip", with one
+   UPDATE_BEGIN and UPDATE_END for all the bands. Return RT_FALSE if not
+   banded, e.g. the panel has framebuffer or it is in a band already. */
+rt_bool_t rtgui_widget_strip_paint(rtgui_widget_t *wgt, rtgui_region_t *clip,
+    rtgui_evt_generic_t *evt) {
+    rtgui_win_t *win = wgt->toplevel;
+    rtgui_rect_t rect = *rtgui_region_extents(clip);
+    rt_bool_t notify;
+
+    /* transparent widget shows what is behind */
+    if (RT_EOK != rtgui_gfx_strip_begin(clip,
+        IS_WIDGET_FLAG(wgt, TRANSPARENT) ? RT_NULL : &WIDGET_BACKGROUND(wgt)))
+        return RT_FALSE;
+
+    /* "rtgui_dc_end_drawing()" in the bands sends no UPDATE_END */
+    notify = win && !IS_TITLE(win) && !win->update;
+    if (win) win->update++;
+    if (notify) _strip_send_update(&rect, RT_FALSE);
+    do {
+        (void)EVENT_HANDLER(wgt)(wgt, evt);
+    } while (rtgui_gfx_strip_next());
+    if (win) win->update--;
+    if (notify) _strip_send_update(&rect, RT_TRUE);
+
+    return RT_TRUE;
+}
+RTM_EXPORT(rtgui_widget_strip_paint);
+#endif /* RTGUI_USING_STRIP */
+
 rt_bool_t rtgui_widget_onshow(rtgui_obj_t *obj, void *param) {
     rtgui_widget_t *wgt = TO_WIDGET(obj);
     (void)param;
@@ -233,8 +233,9 @@ static rt_bool_t _win_handle_mouse_btn(rtgui_win_t *win,
      * widgets). If not, it will receive two mouse up events.
      */
     if (win->last_mouse && IS_MOUSE_EVENT_BUTTON(evt, UP)) {
-        if (TO_OBJECT(win->last_mouse)->evt_hdl(
-                TO_OBJECT(win->last_mouse), evt)) {
+        rtgui_obj_t *obj = TO_OBJECT(win->last_mouse);
+
+        if (EVENT_HANDLER(obj)(obj, evt)) {
             /* clean last mouse event handled widget */
             win->last_mouse = RT_NULL;
             return RT_TRUE;
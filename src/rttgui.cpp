@@ -23,6 +23,10 @@ void RT_GUI::begin(void) {
     rt_device_t dev;
     rt_err_t ret;
 
+    #if (CONFIG_USING_MEM_FB)
+    ret = rtgui_mem_fb_init();
+    RT_ASSERT(RT_EOK == ret);
+    #endif
     dev = rt_device_find(CONFIG_GUI_DEVICE_NAME);
     if (!dev) {
         LOG_E("No \"%s\"", CONFIG_GUI_DEVICE_NAME);
@@ -9,6 +9,7 @@
 extern "C" {
     #include "include/rtgui.h"
     #include "include/image.h"
+    #include "include/font/font.h"
     #include "include/widgets/box.h"
     #include "include/widgets/container.h"
     #include "include/widgets/label.h"
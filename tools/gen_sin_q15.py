@@ -0,0 +1,14 @@
+#!/usr/bin/env python3
+# Generate "_sin_q15[]" in "src/rtgui/dc/dc.c", sin() of 0 - 90 degree in Q15,
+# round(sin(d) * 32768). Usage:
+#   tools/gen_sin_q15.py > table.txt
+import math
+
+values = [int(math.floor(math.sin(math.radians(d)) * 32768 + 0.5))
+          for d in range(91)]
+
+print("static const rt_uint16_t _sin_q15[%d] = {" % len(values))
+for i in range(0, len(values), 8):
+    line = ", ".join("%5d" % v for v in values[i:i + 8])
+    print("    " + line + ("," if i + 8 < len(values) else ""))
+print("};")
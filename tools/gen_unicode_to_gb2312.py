@@ -0,0 +1,230 @@
+#!/usr/bin/env python3
+# Generate "src/rtgui/font/unicode_to_gb2312.c", the page bitmap tables of
+# UnicodeToGB2312(). Usage:
+#   tools/gen_unicode_to_gb2312.py > src/rtgui/font/unicode_to_gb2312.c
+#   tools/gen_unicode_to_gb2312.py --pairs old.c > ...
+#   tools/gen_unicode_to_gb2312.py --check old.c > /dev/null
+# The (unicode, gb2312) pairs are the table of the reference in the output
+# header. By default they come from the "gb2312" codec of Python, which
+# differs from the reference in 4 codes (see OVERRIDES). "--pairs" reads them
+# from a C file with the "{ 0xUUUU, 0xGGGG }," pair table instead, e.g. the
+# unicode_to_gb2312.c before the page tables. "--check" compares the lookup
+# of the generated tables with the binary search of the pair table in the
+# given file, for all 65536 inputs, and exits with 1 on any mismatch.
+import argparse
+import re
+import sys
+
+FIRST = 0xA4                # below are returned as is
+# reference pairs the codec maps to other codes, None for not mapped
+OVERRIDES = {
+    0x00B7: 0xA1A4,
+    0x2014: 0xA1AA,
+    0x2015: None,
+    0x30FB: None,
+}
+
+HEADER = """\
+/***************************************************************************//**
+ * @file    unicode_to_gb2312.c
+ * @brief   Arduino RT-Thread GUI library HZ font
+ * @ref     https://github.com/lindabell/gB2312toUnicode
+ * @author  lindabell
+ ******************************************************************************/
+#include "include/rtgui.h"
+#if (CONFIG_USING_FONT_HZ)
+
+/* generated by "tools/gen_unicode_to_gb2312.py" from the pair table
+   (unicode, gb2312) of the reference above: the codes are grouped by unicode
+   page (high byte), each page has a bitmap of the mapped codes, and the
+   GB2312 codes are stored in unicode order. A code is found by its page, one
+   bitmap word and a bit count, instead of a binary search.
+   256 + %d * (32 + 16) + %d * 2 = %d bytes of ROM, the pair table was
+   %d * 4 = %d bytes. */
+"""
+
+FOOTER = """\
+/*******************************************************************************
+ * Function Name  : UnicodeToGB2312
+ * Description    : This function convert unicode to gb2312 code
+ * Input          : unicode--the unicode value
+ * Output         : None
+ * Return         : gb2312 code value
+ ******************************************************************************/
+rt_uint16_t UnicodeToGB2312(rt_uint16_t unicode) {
+    rt_uint32_t page, word, bits;
+
+    if (unicode < 0xA4) return unicode;
+    page = _gb_page[unicode >> 8];
+    if (!page) return 0;
+    page--;
+    word = (unicode >> 5) & 0x07;
+    bits = _gb_bits[page][word];
+    if (!(bits & (1UL << (unicode & 0x1F)))) return 0;
+
+    /* count the mapped codes before "unicode" in the word */
+    bits &= (1UL << (unicode & 0x1F)) - 1;
+    bits = bits - ((bits >> 1) & 0x55555555);
+    bits = (bits & 0x33333333) + ((bits >> 2) & 0x33333333);
+    bits = (((bits + (bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+
+    return _gb_code[_gb_base[page][word] + bits];
+}
+
+#endif /* CONFIG_USING_FONT_HZ */"""
+
+
+def read_pairs(path):
+    with open(path) as f:
+        found = re.findall(r"\{\s*0x([0-9A-Fa-f]+),\s*0x([0-9A-Fa-f]+)\s*\}",
+                           f.read())
+    if not found:
+        sys.exit("no pair table in \"%s\"" % path)
+    return sorted((int(u, 16), int(g, 16)) for u, g in found)
+
+
+def codec_pairs():
+    pairs = {}
+    for u in range(FIRST, 0x10000):
+        try:
+            g = chr(u).encode("gb2312")
+        except (UnicodeEncodeError, ValueError):
+            continue
+        if len(g) == 2:
+            pairs[u] = (g[0] << 8) | g[1]
+    for u, g in OVERRIDES.items():
+        if g is None:
+            pairs.pop(u, None)
+        else:
+            pairs[u] = g
+    return sorted(pairs.items())
+
+
+def build(pairs):
+    mapped = dict(pairs)
+    pages = sorted(set(u >> 8 for u, _ in pairs))
+    page_idx = [0] * 256
+    bits, base, code = [], [], []
+    for i, p in enumerate(pages):
+        page_idx[p] = i + 1
+        words, starts = [], []
+        for w in range(8):
+            starts.append(len(code))
+            word = 0
+            for b in range(32):
+                u = (p << 8) | (w << 5) | b
+                if u in mapped:
+                    word |= 1 << b
+                    code.append(mapped[u])
+            words.append(word)
+        bits.append(words)
+        base.append(starts)
+    return pages, page_idx, bits, base, code
+
+
+def lookup(tables, unicode):
+    # same as UnicodeToGB2312() in FOOTER
+    _, page_idx, bits, base, code = tables
+    if unicode < FIRST:
+        return unicode
+    page = page_idx[unicode >> 8]
+    if not page:
+        return 0
+    word = bits[page - 1][(unicode >> 5) & 0x07]
+    if not word & (1 << (unicode & 0x1F)):
+        return 0
+    count = bin(word & ((1 << (unicode & 0x1F)) - 1)).count("1")
+    return code[base[page - 1][(unicode >> 5) & 0x07] + count]
+
+
+def search(pairs, unicode):
+    # same as the binary search of the pair table
+    if unicode < FIRST:
+        return unicode
+    low, high = 0, len(pairs) - 1
+    while low <= high:
+        mid = (low + high) // 2
+        if pairs[mid][0] > unicode:
+            high = mid - 1
+        elif pairs[mid][0] < unicode:
+            low = mid + 1
+        else:
+            return pairs[mid][1]
+    return 0
+
+
+def emit(pairs, tables):
+    pages, page_idx, bits, base, code = tables
+    rom = 256 + len(pages) * (32 + 16) + len(code) * 2
+    out = [HEADER % (len(pages), len(code), rom, len(pairs), len(pairs) * 4)]
+
+    out.append("/* page to page index + 1, 0 if nothing mapped */")
+    out.append("static const rt_uint8_t _gb_page[256] = {")
+    for i in range(0, 256, 16):
+        out.append("    " + " ".join("%2d," % v for v in page_idx[i:i + 16]))
+    out.append("};")
+    out.append("")
+
+    out.append("/* mapped codes of each page, 32 codes per word */")
+    out.append("static const rt_uint32_t _gb_bits[%d][8] = {" % len(pages))
+    for p, words in zip(pages, bits):
+        out.append("    { " + ", ".join("0x%08X" % w for w in words[:4]) +
+                   ", /* 0x%02Xxx */" % p)
+        out.append("      " + ", ".join("0x%08X" % w for w in words[4:]) +
+                   " },")
+    out.append("};")
+    out.append("")
+
+    out.append("/* index in \"_gb_code\" of the first mapped code of each "
+               "word */")
+    out.append("static const rt_uint16_t _gb_base[%d][8] = {" % len(pages))
+    for p, starts in zip(pages, base):
+        out.append("    { " + ", ".join("%4d" % s for s in starts) +
+                   " }, /* 0x%02Xxx */" % p)
+    out.append("};")
+    out.append("")
+
+    out.append("static const rt_uint16_t _gb_code[%d] = {" % len(code))
+    for i in range(0, len(code), 8):
+        out.append("    " + " ".join("0x%04X," % c for c in code[i:i + 8]))
+    out.append("};")
+    out.append("")
+    out.append(FOOTER)
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the tables of "
+                                     "UnicodeToGB2312()")
+    parser.add_argument("--pairs", metavar="FILE",
+                        help="read the pairs from a C pair table")
+    parser.add_argument("--check", metavar="FILE",
+                        help="compare all inputs with the pair table in FILE")
+    args = parser.parse_args()
+
+    pairs = read_pairs(args.pairs) if args.pairs else codec_pairs()
+    tables = build(pairs)
+
+    # the lookup must return every pair and nothing else
+    mapped = dict(pairs)
+    for u in range(0x10000):
+        expect = u if u < FIRST else mapped.get(u, 0)
+        if lookup(tables, u) != expect:
+            sys.exit("bad table at 0x%04X" % u)
+
+    if args.check:
+        old = read_pairs(args.check)
+        bad = [u for u in range(0x10000)
+               if lookup(tables, u) != search(old, u)]
+        for u in bad[:16]:
+            sys.stderr.write("0x%04X: 0x%04X, was 0x%04X\n" %
+                             (u, lookup(tables, u), search(old, u)))
+        sys.stderr.write("%d of 65536 inputs differ\n" % len(bad))
+        if bad:
+            sys.exit(1)
+
+    print(emit(pairs, tables))
+
+
+if __name__ == "__main__":
+    main()